@@ -1,12 +1,16 @@
-#version 330 core
+#version 460 core
 
 layout (location = 0) in vec3 vertexPos;
 layout (location = 1) in vec3 vertexNormal;
 layout (location = 2) in vec2 vertexTexCoord;
 
+layout(std140, binding = 0) uniform PerFrameData {
+  mat4 view;
+  mat4 projection;
+  vec4 cameraPos;
+};
+
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
 
 out vec3 fragmentPos;
 out vec3 fragmentVertexNormal;
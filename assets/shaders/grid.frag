@@ -76,4 +76,4 @@ vec4 gridColor(vec2 uv, vec2 camPos) {
   return c;
 }
 
-void main() { out_FragColor = gridColor(uv, camPos); };
+void main() { out_FragColor = gridColor(uv, camPos); }
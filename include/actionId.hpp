@@ -0,0 +1,90 @@
+/**
+ *
+ * @file actionId.hpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief Declares ActionId and ActionName, which identify input actions
+ * without hashing strings at runtime in SquirrelEngine.
+ * @date 2025-06-06
+ *
+ */
+
+#ifndef ACTIONID_HPP
+#define ACTIONID_HPP
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace SquirrelEngine {
+
+/**
+ * @brief Dense index of an interned action, see InputSystem::internAction.
+ */
+typedef uint32_t ActionId;
+
+/**
+ * @brief ActionId returned for unknown actions.
+ */
+inline constexpr ActionId InvalidAction = UINT32_MAX;
+
+/**
+ * @brief Hashes an action name with 64 bit FNV-1a.
+ * @param name Name of the action.
+ * @return Hash of the name.
+ */
+constexpr uint64_t hashActionName( const std::string_view name ) {
+    uint64_t hash = 14695981039346656037ull;
+    for ( const char c : name ) {
+        hash ^= static_cast< uint8_t >( c );
+        hash *= 1099511628211ull;
+    }
+
+    return hash;
+}
+
+/**
+ * @brief Action name with its hash. Constants and "name"_action literals are
+ * hashed at compile time, so looking them up only compares integers.
+ */
+struct ActionName {
+    /**
+     * @brief Constructs an ActionName from a null terminated string.
+     * @param t_name Name of the action, must outlive this object.
+     */
+    constexpr ActionName( const char* t_name )
+        : ActionName( std::string_view( t_name ) ) {}
+
+    /**
+     * @brief Constructs an ActionName from a string view.
+     * @param t_name Name of the action, must outlive this object.
+     */
+    constexpr ActionName( const std::string_view t_name )
+        : name( t_name ), hash( hashActionName( t_name ) ) {}
+
+    /**
+     * @brief Constructs an ActionName from a string.
+     * @param t_name Name of the action, must outlive this object.
+     */
+    ActionName( const std::string& t_name )
+        : ActionName( std::string_view( t_name ) ) {}
+
+    std::string_view name; //!< Name of the action.
+    uint64_t hash;         //!< FNV-1a hash of the name.
+};
+
+/**
+ * @brief Hashes an action name literal at compile time.
+ * @param name Name of the action.
+ * @param length Length of the name.
+ * @return ActionName of the literal.
+ */
+consteval ActionName operator""_action( const char* name,
+                                        const size_t length ) {
+    return ActionName( std::string_view( name, length ) );
+}
+
+} // namespace SquirrelEngine
+
+#endif
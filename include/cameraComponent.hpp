@@ -51,6 +51,7 @@ public:
 
     /**
      * @brief Deserializes the camera component's data from the given record.
+     * Fields missing from the record keep their current values.
      * @param record Pointer to the DataRecord to deserialize from.
      */
     void deserializeComponent( DataRecord* record );
@@ -16,24 +16,36 @@
 
 // From source
 #include "cameraComponent.hpp"
+#include "dataRecord.hpp"
 //// Engine
 #include "engine.hpp"
+#include "sceneSerializer.hpp"
 #include "system.hpp"
 #include "world.hpp"
+#include "worldManager.hpp"
+#include "worldPartition.hpp"
 
 #include "entity.hpp"
 #include "eventSystem.hpp"
 
 //// Input
+#include "gamepad.hpp"
+#include "inputRecorder.hpp"
 #include "inputSystem.hpp"
 #include "keyboard.hpp"
 #include "mouse.hpp"
 
 //// Graphics
+#include "frameProfiler.hpp"
+#include "headlessRunner.hpp"
 #include "mesh.hpp"
+#include "meshCache.hpp"
 #include "model.hpp"
 #include "objectRenderer.hpp"
+#include "prefab.hpp"
+#include "prefabLibrary.hpp"
 #include "shader.hpp"
+#include "shaderCompiler.hpp"
 #include "window.hpp"
 
 //// Utilities
@@ -41,8 +53,10 @@
 #include "error_codes.hpp"
 #include "utils/trace.hpp"
 #include "utils/time_manager.hpp"
+#include "utils/resource_tracker.hpp"
 
 //// Editor windows
+#include "editor_windows/profiler_editor.hpp"
 #include "editor_windows/world_editor.hpp"
 
 #endif
@@ -0,0 +1,137 @@
+/**
+ *
+ * @file dataRecord.hpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief Declares the DataRecord class, a named set of text fields that
+ * entities and components serialize into in SquirrelEngine.
+ * @date 2025-06-06
+ *
+ */
+
+#ifndef DATARECORD_HPP
+#define DATARECORD_HPP
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "math_types.hpp"
+#include "quaternion.hpp"
+
+namespace SquirrelEngine {
+
+/**
+ * @brief One entity or component in the text scene format, written as
+ *
+ *     [Type]
+ *     key = value
+ *
+ * and ended by a blank line. Fields keep the order they were set in so saved
+ * files diff cleanly. Floats are written in their shortest exact form, so a
+ * save and load gives back the same bits. Getting a missing or malformed field
+ * returns false and leaves the value alone.
+ */
+class DataRecord {
+public:
+    /**
+     * @brief Constructs an empty record.
+     * @param t_type Type of the record, the name in brackets.
+     */
+    DataRecord( const std::string& t_type = "" );
+
+    /**
+     * @brief Gets the type of the record.
+     * @return Name in brackets.
+     */
+    const std::string& getType() const;
+
+    /**
+     * @brief Sets the type of the record.
+     * @param type Name in brackets.
+     */
+    void setType( const std::string& type );
+
+    /**
+     * @brief Sets a field, replacing it if it exists.
+     * @param key Name of the field.
+     * @param value Value to store.
+     */
+    void set( const std::string& key, const std::string& value );
+    void set( const std::string& key, const char* value );
+    void set( const std::string& key, const float value );
+    void set( const std::string& key, const int32_t value );
+    void set( const std::string& key, const uint32_t value );
+    void set( const std::string& key, const bool value );
+    void set( const std::string& key, const vector3& value );
+    void set( const std::string& key, const Quaternion& value );
+
+    /**
+     * @brief Gets a field.
+     * @param key Name of the field.
+     * @param value Set to the stored value if there is one.
+     * @return true if the field exists and parsed.
+     */
+    bool get( const std::string& key, std::string& value ) const;
+    bool get( const std::string& key, float& value ) const;
+    bool get( const std::string& key, int32_t& value ) const;
+    bool get( const std::string& key, uint32_t& value ) const;
+    bool get( const std::string& key, bool& value ) const;
+    bool get( const std::string& key, vector3& value ) const;
+    bool get( const std::string& key, Quaternion& value ) const;
+
+    /**
+     * @brief Checks if a field exists.
+     * @param key Name of the field.
+     * @return true if the field was set or read.
+     */
+    bool has( const std::string& key ) const;
+
+    /**
+     * @brief Removes the type and every field.
+     */
+    void clear();
+
+    /**
+     * @brief Writes the record followed by a blank line.
+     * @param stream Stream to write to.
+     */
+    void write( std::ostream& stream ) const;
+
+    /**
+     * @brief Reads the next record, skipping blank lines and # comments.
+     * @param stream Stream to read from.
+     * @param record Cleared, then filled with the record.
+     * @return false once there are no records left.
+     */
+    static bool read( std::istream& stream, DataRecord& record );
+
+private:
+    /**
+     * @brief Finds the text of a field.
+     * @param key Name of the field.
+     * @return Pointer to the text, or nullptr if there is no such field.
+     */
+    const std::string* find( const std::string& key ) const;
+
+    /**
+     * @brief Parses whitespace separated floats.
+     * @param key Name of the field.
+     * @param values Filled with the floats.
+     * @param count Number of floats expected.
+     * @return true if the field has exactly that many floats.
+     */
+    bool getFloats( const std::string& key, float* values,
+                    const int count ) const;
+
+    std::string m_type; //!< Name in brackets.
+    std::vector< std::pair< std::string, std::string > >
+        m_fields; //!< Keys and values in the order they were set.
+};
+
+} // namespace SquirrelEngine
+
+#endif
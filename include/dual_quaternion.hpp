@@ -15,7 +15,8 @@ namespace SquirrelEngine {
 
 class DualQuaternion {
 public:
-    constexpr DualQuaternion() : real(), dual() {}
+    // Identity, the dual part must be zero or it reads back as a translation
+    constexpr DualQuaternion() : real(), dual( 0.f ) {}
 
     constexpr DualQuaternion( const DualQuaternion& other )
         : real( other.real ), dual( other.dual ) {}
@@ -160,6 +161,34 @@ public:
         return vector3( t.i, t.j, t.k );
     }
 
+    /**
+     * @brief Blends two rigid transforms with dual quaternion linear blending.
+     * Takes the shortest path and stays rigid, unlike blending matrices.
+     *
+     * @param from Transform at t = 0
+     * @param to Transform at t = 1
+     * @param t Blend factor, 0 to 1
+     * @return const DualQuaternion Unit dual quaternion between the two
+     */
+    static const DualQuaternion blend( const DualQuaternion& from,
+                                       const DualQuaternion& to,
+                                       const float t ) {
+        // q and -q are the same rotation, flip to blend the short way round
+        const float toWeight = ( from.real.dot( to.real ) < 0.f ) ? -t : t;
+        const float fromWeight = 1.f - t;
+
+        const Quaternion real = from.real * fromWeight + to.real * toWeight;
+        const Quaternion dual = from.dual * fromWeight + to.dual * toWeight;
+
+        const float length = real.norm();
+        if ( length <= 0.f ) {
+            return to;
+        }
+
+        return DualQuaternion( real * ( 1.f / length ),
+                               dual * ( 1.f / length ) );
+    }
+
     constexpr const matrix4 getRotationMatrix() {
         normalize();
 
@@ -16,6 +16,8 @@ public:
 
     virtual StartupErrors initialize( Engine* t_owner );
 
+    virtual void shutdown();
+
     virtual void update( const float );
 
     virtual void render();
@@ -0,0 +1,25 @@
+
+#ifndef PROFILER_EDITOR_HPP
+#define PROFILER_EDITOR_HPP
+#pragma once
+
+#include "system.hpp"
+
+namespace SquirrelEngine {
+class FrameProfiler;
+
+class ProfilerEditor : public System {
+public:
+    ProfilerEditor();
+
+    virtual StartupErrors initialize( Engine* t_owner );
+
+    virtual void update();
+
+private:
+    FrameProfiler* m_profiler = nullptr;
+};
+
+} // namespace SquirrelEngine
+
+#endif
@@ -15,6 +15,7 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "error_codes.hpp"
@@ -29,8 +30,38 @@ namespace SquirrelEngine {
 enum StartupErrors : unsigned;
 
 // Forward declarations of classes
+class HeadlessRunner;
+class InputRecorder;
+class RenderPipeline;
 class Window;
 
+/**
+ * @brief Settings used when starting the engine.
+ */
+struct EngineSettings {
+    std::string title = "SquirrelEngine"; //!< Window title.
+    int width = 1280;                     //!< Window/framebuffer width.
+    int height = 720;                     //!< Window/framebuffer height.
+    bool fullscreen = false;              //!< Open fullscreen window.
+
+    bool headless = false;         //!< Render offscreen, no visible window.
+    int frameCount = 0;            //!< Frames to run, 0 runs until closed.
+    float targetFrameRate = 144.f; //!< Frame limit, 0 uncapped (windowed).
+    float fixedDeltaTime = 0.02f;  //!< Interval of fixed updates.
+    int maxFixedSteps = 5;         //!< Fixed updates allowed per frame.
+
+    std::string timingsFile; //!< CSV for per-frame timings (headless only).
+    std::string captureFile; //!< PNG of the last frame (headless only).
+
+    std::string recordFile;           //!< Input log to record into.
+    std::string replayFile;           //!< Input log to replay.
+    float replayDeltaTime = 1 / 60.f; //!< Frame time recordings step by.
+
+    bool renderThread = false;   //!< Draw on a separate render thread.
+    int maxFramesAhead = 1;      //!< Frames the simulation may run ahead.
+    bool dropLateFrames = false; //!< Replace frames the renderer fell behind.
+};
+
 class Engine : public Object {
 public:
     /**
@@ -41,10 +72,12 @@ public:
     /**
      * @brief Starts all essential systems for the engine
      *
+     * @param settings Window and run mode settings
      * @return true Successfully started engine
      * @return false Failed to start engine
      */
-    enum StartupErrors initialize();
+    enum StartupErrors
+    initialize( const EngineSettings& settings = EngineSettings() );
 
     /**
      * @brief Handles updates for all systems in engine
@@ -52,16 +85,34 @@ public:
     void update();
 
     /**
-     * @brief Properly shuts all systems down on engine close
+     * @brief Properly shuts all systems down on engine close, then destroys
+     * the window. Safe to call more than once
      */
     void shutdown();
 
+    /**
+     * @brief Shuts the engine down and starts it again. The window and its
+     * OpenGL context are kept when the window settings match, which skips
+     * the slowest part of startup. Entities and update callbacks are cleared,
+     * so the scene has to be set up again
+     *
+     * @param settings Window and run mode settings
+     * @return StartupErrors indicating success or failure
+     */
+    enum StartupErrors restart( const EngineSettings& settings );
+
     /**
      * @brief Get the Window Handle object
      * @return Window* Pointer to the window handle.
      */
     Window* getWindowHandle();
 
+    /**
+     * @brief Get the settings the engine was started with
+     * @return Reference to the settings.
+     */
+    const EngineSettings& getSettings() const;
+
     /**
      * @brief Create a System object owned by the engine
      *
@@ -130,11 +181,41 @@ private:
      */
     Engine();
 
+    /**
+     * @brief Shuts systems down newest first and releases everything holding
+     * OpenGL objects, leaving the window and its context alive.
+     */
+    void shutdownSystems();
+
+    /**
+     * @brief Hands the OpenGL context to a new render thread and starts
+     * pipelining frames.
+     */
+    void startRenderThread();
+
+    /**
+     * @brief Waits for the published frames to be drawn, stops the render
+     * thread and takes the OpenGL context back.
+     */
+    void stopRenderThread();
+
+    /**
+     * @brief Draws published snapshots until the pipeline stops. Runs on the
+     * render thread, which owns the OpenGL context meanwhile.
+     */
+    void renderLoop();
+
     std::vector< std::function< void( const float ) > > updateCallbacks;
     std::vector< std::function< void() > > fixedUpdateCallbacks;
 
     std::vector< std::unique_ptr< System > > m_systems;
     std::unique_ptr< Window > m_window;
+    std::unique_ptr< HeadlessRunner > m_headless;
+    std::unique_ptr< InputRecorder > m_recorder;
+    std::unique_ptr< RenderPipeline > m_pipeline;
+    std::thread m_renderThread;
+
+    EngineSettings m_settings;
 };
 
 /**
@@ -21,6 +21,8 @@
 #include "component.hpp"
 
 namespace SquirrelEngine {
+class World;
+
 class Entity : public Object {
 public:
     /**
@@ -123,6 +125,16 @@ public:
      */
     Transform transform;
 
+    /**
+     * @brief The world that owns this entity, set by World::createEntity.
+     */
+    World* world = nullptr;
+
+    /**
+     * @brief Index of this entity's slot in its world, used by handles.
+     */
+    uint32_t slot = UINT32_MAX;
+
 protected:
     /**
      * @brief The list of components attached to this entity.
@@ -0,0 +1,273 @@
+/**
+ *
+ * @file eventChannel.hpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief Declares the EventChannel class, a lock-free multi-producer single
+ * consumer queue for publishing events from any thread in SquirrelEngine.
+ * @date 2025-06-06
+ *
+ */
+
+#ifndef EVENTCHANNEL_HPP
+#define EVENTCHANNEL_HPP
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace SquirrelEngine {
+
+/**
+ * @brief What a channel does when a producer finds it full.
+ */
+enum ChannelOverflow : unsigned {
+    CO_Spill = 0, //!< Store the event in a locked overflow list.
+    CO_Drop = 1,  //!< Drop the event, memory stays bounded.
+};
+
+/**
+ * @brief Counters for a channel, read on the consumer thread.
+ */
+struct ChannelStats {
+    uint64_t pushed = 0;     //!< Events accepted, including spilled ones.
+    uint64_t spilled = 0;    //!< Events that went to the overflow list.
+    uint64_t dropped = 0;    //!< Events rejected because the channel was full.
+    uint64_t drained = 0;    //!< Events taken by the consumer.
+    size_t capacity = 0;     //!< Slots in the ring.
+    size_t highWater = 0;    //!< Most events seen waiting at one drain.
+};
+
+/**
+ * @brief Type-erased base of EventChannel, so channels of every event type can
+ * be stored together.
+ */
+class EventChannelBase {
+public:
+    /**
+     * @brief Virtual destructor for EventChannelBase.
+     */
+    virtual ~EventChannelBase() = default;
+
+    /**
+     * @brief Gets the channel's counters. Call from the consumer thread.
+     * @return Copy of the counters.
+     */
+    virtual ChannelStats getStats() const = 0;
+};
+
+/**
+ * @brief Lock-free multi-producer single-consumer channel of events of one
+ * type.
+ *
+ * Producers claim slots of a fixed ring with a compare-and-swap on the write
+ * position, each slot carrying a sequence number that tells the consumer when
+ * it has been written (Vyukov's bounded queue). When the ring is full the
+ * channel either spills into a mutex-guarded list, so nothing is lost, or
+ * drops the event and counts it, so memory stays bounded.
+ *
+ * @tparam T Event type, must be default constructible and move assignable.
+ */
+template < class T > class EventChannel : public EventChannelBase {
+public:
+    /**
+     * @brief Constructs a channel.
+     * @param capacity Number of ring slots, rounded up to a power of two.
+     * @param overflow What to do when the ring is full.
+     */
+    EventChannel( const size_t capacity, const ChannelOverflow overflow )
+        : m_overflow( overflow ) {
+        size_t size = 2;
+        while ( size < capacity ) {
+            size *= 2;
+        }
+
+        m_cells = std::make_unique< Cell[] >( size );
+        m_mask = size - 1;
+
+        for ( size_t i = 0; i < size; ++i ) {
+            m_cells[i].sequence.store( i, std::memory_order_relaxed );
+        }
+    }
+
+    EventChannel( const EventChannel& ) = delete;
+    EventChannel& operator=( const EventChannel& ) = delete;
+
+    /**
+     * @brief Pushes an event, constructed from the arguments. Safe to call
+     * from any number of threads.
+     * @tparam Args Constructor argument types.
+     * @param args Arguments forwarded to the event's constructor.
+     * @return false if the channel was full and drops events.
+     */
+    template < class... Args > bool push( Args&&... args ) {
+        // Keep spilling until the consumer has caught up, so one producer's
+        // events never come out of order
+        if ( m_hasSpilled.load( std::memory_order_acquire ) ) {
+            return overflow( std::forward< Args >( args )... );
+        }
+
+        size_t pos = m_writePos.load( std::memory_order_relaxed );
+        Cell* cell;
+
+        for ( ;; ) {
+            cell = &m_cells[pos & m_mask];
+            const size_t sequence =
+                cell->sequence.load( std::memory_order_acquire );
+            const intptr_t diff =
+                static_cast< intptr_t >( sequence ) -
+                static_cast< intptr_t >( pos );
+
+            if ( diff == 0 ) {
+                // Slot is free, claim it
+                if ( m_writePos.compare_exchange_weak(
+                         pos, pos + 1, std::memory_order_relaxed ) ) {
+                    break;
+                }
+            } else if ( diff < 0 ) {
+                // Consumer hasn't freed the slot yet, the ring is full
+                return overflow( std::forward< Args >( args )... );
+            } else {
+                pos = m_writePos.load( std::memory_order_relaxed );
+            }
+        }
+
+        cell->event = T( std::forward< Args >( args )... );
+        cell->sequence.store( pos + 1, std::memory_order_release );
+
+        return true;
+    }
+
+    /**
+     * @brief Takes the events written before the call, oldest first, then the
+     * spilled ones once the ring is empty. Events pushed meanwhile wait for
+     * the next drain. Call from the consumer thread only.
+     * @tparam TCallback Callable taking T&&.
+     * @param callback Called for each event.
+     * @return Number of events taken.
+     */
+    template < typename TCallback > size_t drain( TCallback&& callback ) {
+        size_t count = 0;
+
+        // Producers refilling the ring would otherwise keep the consumer here
+        const size_t end = m_writePos.load( std::memory_order_acquire );
+
+        while ( m_readPos != end ) {
+            Cell& cell = m_cells[m_readPos & m_mask];
+            const size_t sequence =
+                cell.sequence.load( std::memory_order_acquire );
+
+            // Not written yet, or written by a producer still finishing up
+            if ( sequence != m_readPos + 1 ) {
+                break;
+            }
+
+            callback( std::move( cell.event ) );
+            cell.sequence.store( m_readPos + m_mask + 1,
+                                 std::memory_order_release );
+            ++m_readPos;
+            ++count;
+        }
+
+        // Spilled events are newer than everything claimed in the ring, only
+        // take them once the ring is empty
+        const bool ringEmpty =
+            m_readPos == end &&
+            m_writePos.load( std::memory_order_acquire ) == end;
+
+        if ( ringEmpty && m_hasSpilled.load( std::memory_order_acquire ) ) {
+            {
+                std::lock_guard< std::mutex > lock( m_spillMutex );
+                m_draining.swap( m_spilled );
+                m_hasSpilled.store( false, std::memory_order_relaxed );
+            }
+
+            for ( T& event : m_draining ) {
+                callback( std::move( event ) );
+            }
+            count += m_draining.size();
+            m_draining.clear();
+        }
+
+        m_drained += count;
+        if ( count > m_highWater ) {
+            m_highWater = count;
+        }
+
+        return count;
+    }
+
+    /**
+     * @brief Gets the channel's counters. Call from the consumer thread.
+     * @return Copy of the counters.
+     */
+    ChannelStats getStats() const override {
+        ChannelStats stats;
+        stats.spilled = m_spilledCount.load( std::memory_order_relaxed );
+        stats.pushed = m_writePos.load( std::memory_order_relaxed ) +
+                       stats.spilled;
+        stats.dropped = m_dropped.load( std::memory_order_relaxed );
+        stats.drained = m_drained;
+        stats.capacity = m_mask + 1;
+        stats.highWater = m_highWater;
+
+        return stats;
+    }
+
+private:
+    /**
+     * @brief Ring slot. The sequence equals the slot's write position when
+     * free and write position + 1 once written.
+     */
+    struct Cell {
+        std::atomic< size_t > sequence; //!< Slot state, see above.
+        T event;                        //!< Stored event.
+    };
+
+    /**
+     * @brief Handles a push to a full ring.
+     * @tparam Args Constructor argument types.
+     * @param args Arguments forwarded to the event's constructor.
+     * @return false if the event was dropped.
+     */
+    template < class... Args > bool overflow( Args&&... args ) {
+        if ( m_overflow == CO_Drop ) {
+            m_dropped.fetch_add( 1, std::memory_order_relaxed );
+            return false;
+        }
+
+        {
+            std::lock_guard< std::mutex > lock( m_spillMutex );
+            m_spilled.emplace_back( std::forward< Args >( args )... );
+            m_hasSpilled.store( true, std::memory_order_release );
+        }
+
+        m_spilledCount.fetch_add( 1, std::memory_order_relaxed );
+        return true;
+    }
+
+    std::unique_ptr< Cell[] > m_cells; //!< Ring of slots.
+    size_t m_mask = 0;                 //!< Slot count - 1.
+    ChannelOverflow m_overflow;        //!< Full ring behaviour.
+
+    // Producers and the consumer write these, keep them on separate lines
+    alignas( 64 ) std::atomic< size_t > m_writePos = 0; //!< Next slot to claim.
+    alignas( 64 ) size_t m_readPos = 0; //!< Next slot to read.
+
+    alignas( 64 ) std::atomic< uint64_t > m_spilledCount = 0; //!< Spilled.
+    std::atomic< uint64_t > m_dropped = 0;              //!< Dropped events.
+    uint64_t m_drained = 0;                             //!< Taken events.
+    size_t m_highWater = 0;                             //!< Biggest drain.
+
+    std::mutex m_spillMutex;               //!< Guards m_spilled.
+    std::atomic< bool > m_hasSpilled = false; //!< Whether m_spilled has events.
+    std::vector< T > m_spilled;            //!< Events that didn't fit.
+    std::vector< T > m_draining;           //!< Spilled events being drained.
+};
+
+} // namespace SquirrelEngine
+
+#endif
@@ -0,0 +1,205 @@
+/**
+ *
+ * @file eventDelegate.hpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief Declares the EventDelegate class, a small type-erased callable used to
+ * deliver events to free functions and member functions in SquirrelEngine.
+ * @date 2025-06-06
+ *
+ */
+
+#ifndef EVENTDELEGATE_HPP
+#define EVENTDELEGATE_HPP
+#pragma once
+
+#include <cstring>
+#include <type_traits>
+
+#include "event.hpp"
+
+namespace SquirrelEngine {
+
+/**
+ * @brief Callback function type for event handling.
+ */
+typedef void ( *EventHandlingCallback )( Object* obj, Event* event );
+
+/**
+ * @brief Splits an event handling member function type into its class and
+ * event type.
+ * @tparam M Member function pointer type.
+ */
+template < class M > struct EventMethodTraits;
+
+/**
+ * @brief Splits void (C::*)(EventT&) into its class and event type. A handler
+ * taking const EventT& is registered under EventT.
+ * @tparam C Class the member function belongs to.
+ * @tparam EventT Event type taken by reference.
+ */
+template < class C, class EventT >
+struct EventMethodTraits< void ( C::* )( EventT& ) > {
+    typedef C Class; //!< Class the member function belongs to.
+    typedef std::remove_cv_t< EventT >
+        Event; //!< Event type taken by the member function.
+};
+
+/**
+ * @brief Object pointer plus a trampoline that casts the event back to its
+ * real type and calls the target.
+ *
+ * Unlike std::function it never allocates and is trivially copyable, so
+ * subscribers can be stored by value and moved around with memcpy. The target
+ * (a function or member function pointer) is copied into inline storage.
+ */
+class EventDelegate {
+public:
+    /**
+     * @brief Function that calls the target with the event.
+     */
+    typedef void ( *Trampoline )( const EventDelegate& delegate, Event* event );
+
+    /**
+     * @brief Constructs an unbound delegate.
+     */
+    EventDelegate() = default;
+
+    /**
+     * @brief Binds a raw callback that downcasts the event itself.
+     * @param listener Object passed as the callback's first argument.
+     * @param callback Callback function pointer.
+     * @return Bound delegate.
+     */
+    static EventDelegate fromCallback( Object* listener,
+                                       EventHandlingCallback callback ) {
+        EventDelegate delegate;
+        delegate.m_instance = listener;
+        delegate.m_trampoline = &callCallback;
+        delegate.store( callback );
+
+        return delegate;
+    }
+
+    /**
+     * @brief Binds a member function given at runtime.
+     * @tparam EventT Event type taken by the member function.
+     * @tparam C Class of the instance.
+     * @param instance Object to call the member function on.
+     * @param method Member function taking EventT&.
+     * @return Bound delegate.
+     */
+    template < class EventT, class C >
+    static EventDelegate fromMethod( C* instance,
+                                     void ( C::*method )( EventT& ) ) {
+        EventDelegate delegate;
+        delegate.m_instance = instance;
+        delegate.m_trampoline = &callMethod< EventT, C >;
+        delegate.store( method );
+
+        return delegate;
+    }
+
+    /**
+     * @brief Binds a member function known at compile time, which the
+     * trampoline calls directly.
+     * @tparam Method Member function taking an event by reference.
+     * @tparam C Class of the instance.
+     * @param instance Object to call the member function on.
+     * @return Bound delegate.
+     */
+    template < auto Method, class C >
+    static EventDelegate fromMethod( C* instance ) {
+        EventDelegate delegate;
+        delegate.m_instance = instance;
+        delegate.m_trampoline = &callBound< Method, C >;
+
+        return delegate;
+    }
+
+    /**
+     * @brief Calls the target.
+     * @param event Event to deliver, must be of the type the target takes.
+     */
+    void operator()( Event* event ) const { m_trampoline( *this, event ); }
+
+    /**
+     * @brief Checks if the delegate has a target.
+     * @return true if bound.
+     */
+    bool isBound() const { return m_trampoline != nullptr; }
+
+    /**
+     * @brief Removes the target.
+     */
+    void reset() { m_trampoline = nullptr; }
+
+private:
+    /**
+     * @brief Copies a function or member function pointer into the storage.
+     * @tparam T Pointer type.
+     * @param target Pointer to store.
+     */
+    template < class T > void store( const T target ) {
+        static_assert( sizeof( T ) <= sizeof( m_target ),
+                       "Member function pointer too large for EventDelegate" );
+        std::memcpy( m_target, &target, sizeof( T ) );
+    }
+
+    /**
+     * @brief Reads back a pointer copied in by store.
+     * @tparam T Pointer type.
+     * @return Stored pointer.
+     */
+    template < class T > T load() const {
+        T target;
+        std::memcpy( &target, m_target, sizeof( T ) );
+        return target;
+    }
+
+    /**
+     * @brief Trampoline for raw callbacks.
+     * @param delegate Delegate being called.
+     * @param event Event to deliver.
+     */
+    static void callCallback( const EventDelegate& delegate, Event* event ) {
+        delegate.load< EventHandlingCallback >()(
+            static_cast< Object* >( delegate.m_instance ), event );
+    }
+
+    /**
+     * @brief Trampoline for member functions given at runtime.
+     * @tparam EventT Event type taken by the member function.
+     * @tparam C Class of the instance.
+     * @param delegate Delegate being called.
+     * @param event Event to deliver.
+     */
+    template < class EventT, class C >
+    static void callMethod( const EventDelegate& delegate, Event* event ) {
+        typedef void ( C::*Method )( EventT& );
+        ( static_cast< C* >( delegate.m_instance )
+              ->*delegate.load< Method >() )( *static_cast< EventT* >( event ) );
+    }
+
+    /**
+     * @brief Trampoline for member functions known at compile time.
+     * @tparam Method Member function taking an event by reference.
+     * @tparam C Class of the instance.
+     * @param delegate Delegate being called.
+     * @param event Event to deliver.
+     */
+    template < auto Method, class C >
+    static void callBound( const EventDelegate& delegate, Event* event ) {
+        typedef typename EventMethodTraits< decltype( Method ) >::Event EventT;
+        ( static_cast< C* >( delegate.m_instance )->*Method )(
+            *static_cast< EventT* >( event ) );
+    }
+
+    void* m_instance = nullptr;         //!< Object the target is called on.
+    Trampoline m_trampoline = nullptr;  //!< Calls the target, nullptr if unbound.
+    alignas( void* ) unsigned char
+        m_target[3 * sizeof( void* )] = {}; //!< Stored target pointer.
+};
+
+} // namespace SquirrelEngine
+
+#endif
@@ -0,0 +1,251 @@
+/**
+ *
+ * @file eventQueue.hpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief Declares the EventQueue class, a growable ring buffer that stores
+ * queued events of one type by value in SquirrelEngine.
+ * @date 2025-06-06
+ *
+ */
+
+#ifndef EVENTQUEUE_HPP
+#define EVENTQUEUE_HPP
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "object.hpp"
+
+namespace SquirrelEngine {
+
+/**
+ * @brief Type-erased base of EventQueue, so queues of every event type can be
+ * stored together.
+ */
+class EventQueueBase {
+public:
+    /**
+     * @brief Virtual destructor for EventQueueBase.
+     */
+    virtual ~EventQueueBase() = default;
+
+    /**
+     * @brief Gets the number of events waiting to be delivered.
+     * @return Queued event count.
+     */
+    virtual size_t size() const = 0;
+
+    /**
+     * @brief Removes a batch listener. Safe to call while delivering.
+     * @param id ID of the subscription.
+     * @return true if the listener existed.
+     */
+    virtual bool removeBatchSubscriber( const uint32_t id ) = 0;
+};
+
+/**
+ * @brief Ring buffer of queued events of one type, plus the listeners that
+ * take them in batches.
+ *
+ * Events are stored by value in contiguous slots. The buffer doubles when
+ * full and never shrinks, so once it has grown to a frame's worth of events
+ * queueing no longer allocates.
+ *
+ * @tparam T Event type, must be default constructible and move assignable.
+ */
+template < class T > class EventQueue : public EventQueueBase {
+public:
+    /**
+     * @brief Callback taking a contiguous run of events.
+     */
+    typedef void ( *BatchCallback )( Object* obj, const T* events,
+                                     size_t count );
+
+    /**
+     * @brief Listener that receives events in batches.
+     */
+    struct BatchSubscriber {
+        uint32_t id;            //!< ID of the subscription.
+        Object* listener;       //!< Pointer to the listener object.
+        BatchCallback callback; //!< Callback, nullptr once removed.
+    };
+
+    /**
+     * @brief Constructs an empty queue with the initial capacity.
+     */
+    EventQueue() : m_items( InitialCapacity ) {}
+
+    /**
+     * @brief Constructs an event at the back of the queue.
+     * @tparam Args Constructor argument types.
+     * @param args Arguments forwarded to the event's constructor.
+     */
+    template < class... Args > void emplace( Args&&... args ) {
+        // Growing would move the events being delivered, park new ones
+        // until the delivery is done
+        if ( m_count == m_items.size() ) {
+            if ( m_dispatching ) {
+                m_overflow.emplace_back( std::forward< Args >( args )... );
+                return;
+            }
+
+            grow();
+        }
+
+        m_items[wrap( m_head + m_count )] = T( std::forward< Args >( args )... );
+        ++m_count;
+    }
+
+    /**
+     * @brief Gets the number of events waiting to be delivered.
+     * @return Queued event count.
+     */
+    size_t size() const override { return m_count + m_overflow.size(); }
+
+    /**
+     * @brief Gets the number of events the ring can hold before growing.
+     * @return Capacity of the ring.
+     */
+    size_t capacity() const { return m_items.size(); }
+
+    /**
+     * @brief Starts delivering the events queued so far. Events queued from
+     * here on wait for the next delivery.
+     * @return Number of events to deliver.
+     */
+    size_t beginDispatch() {
+        m_dispatching = true;
+        return m_count;
+    }
+
+    /**
+     * @brief Checks if a delivery is running.
+     * @return true between beginDispatch and endDispatch.
+     */
+    bool isDispatching() const { return m_dispatching; }
+
+    /**
+     * @brief Gets the contiguous runs holding the first count events. The
+     * second run is only used when the events wrap around the ring.
+     * @param count Number of events, at most size().
+     * @param first Set to the first run.
+     * @param firstCount Set to the length of the first run.
+     * @param second Set to the second run.
+     * @param secondCount Set to the length of the second run.
+     */
+    void spans( const size_t count, T*& first, size_t& firstCount, T*& second,
+                size_t& secondCount ) {
+        firstCount = std::min( count, m_items.size() - m_head );
+        secondCount = count - firstCount;
+        first = m_items.data() + m_head;
+        second = m_items.data();
+    }
+
+    /**
+     * @brief Drops delivered events and moves in the ones parked while
+     * delivering.
+     * @param count Number of events that were delivered.
+     */
+    void endDispatch( const size_t count ) {
+        m_head = wrap( m_head + count );
+        m_count -= count;
+        m_dispatching = false;
+
+        for ( T& event : m_overflow ) {
+            emplace( std::move( event ) );
+        }
+        m_overflow.clear();
+
+        for ( size_t i = 0; i < m_batchSubscribers.size(); ) {
+            if ( m_batchSubscribers[i].callback ) {
+                ++i;
+                continue;
+            }
+
+            m_batchSubscribers[i] = m_batchSubscribers.back();
+            m_batchSubscribers.pop_back();
+        }
+    }
+
+    /**
+     * @brief Adds a batch listener.
+     * @param id ID of the subscription.
+     * @param t_listener Pointer to the listener object.
+     * @param t_callback Callback function pointer.
+     */
+    void addBatchSubscriber( const uint32_t id, Object* t_listener,
+                             BatchCallback t_callback ) {
+        m_batchSubscribers.push_back( { id, t_listener, t_callback } );
+    }
+
+    /**
+     * @brief Removes a batch listener. Safe to call while delivering.
+     * @param id ID of the subscription.
+     * @return true if the listener existed.
+     */
+    bool removeBatchSubscriber( const uint32_t id ) override {
+        for ( size_t i = 0; i < m_batchSubscribers.size(); ++i ) {
+            if ( m_batchSubscribers[i].id != id ||
+                 !m_batchSubscribers[i].callback ) {
+                continue;
+            }
+
+            if ( m_dispatching ) {
+                m_batchSubscribers[i].callback = nullptr;
+            } else {
+                m_batchSubscribers[i] = m_batchSubscribers.back();
+                m_batchSubscribers.pop_back();
+            }
+            return true;
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief Gets the batch listeners.
+     * @return Reference to the list of batch listeners.
+     */
+    const std::vector< BatchSubscriber >& getBatchSubscribers() const {
+        return m_batchSubscribers;
+    }
+
+    static constexpr size_t InitialCapacity = 64; //!< Must be a power of two.
+
+private:
+    /**
+     * @brief Wraps an index into the ring.
+     * @param index Index that may be past the end.
+     * @return Index inside the ring.
+     */
+    size_t wrap( const size_t index ) const {
+        return index & ( m_items.size() - 1 );
+    }
+
+    /**
+     * @brief Doubles the ring, unwrapping the queued events to the front.
+     */
+    void grow() {
+        std::vector< T > items( m_items.size() * 2 );
+        for ( size_t i = 0; i < m_count; ++i ) {
+            items[i] = std::move( m_items[wrap( m_head + i )] );
+        }
+
+        m_items.swap( items );
+        m_head = 0;
+    }
+
+    std::vector< T > m_items;    //!< Ring storage, size is a power of two.
+    std::vector< T > m_overflow; //!< Events queued during a full delivery.
+    std::vector< BatchSubscriber > m_batchSubscribers; //!< Batch listeners.
+    size_t m_head = 0;          //!< Index of the oldest event.
+    size_t m_count = 0;         //!< Number of events in the ring.
+    bool m_dispatching = false; //!< Whether a delivery is running.
+};
+
+} // namespace SquirrelEngine
+
+#endif
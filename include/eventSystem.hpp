@@ -12,22 +12,43 @@
 #define EVENTSYSTEM_HPP
 #pragma once
 
+#include <cstdint>
 #include <memory>
-#include <typeindex>
+#include <type_traits>
 #include <vector>
 
+#include "eventChannel.hpp"
+#include "eventDelegate.hpp"
+#include "eventQueue.hpp"
 #include "system.hpp"
 
 namespace SquirrelEngine {
-class Event;
 
 /**
- * @brief Callback function type for event handling.
+ * @brief Handle returned by EventSystem::subscribe, used to unsubscribe.
  */
-typedef void ( *EventHandlingCallback )( Object* obj, Event* event );
+struct SubscriptionHandle {
+    uint32_t type = UINT32_MAX; //!< Dense ID of the event type.
+    uint32_t id = 0;            //!< ID of the subscription.
+    uint32_t generation = 0;    //!< Generation of the ID when handed out.
+
+    /**
+     * @brief Checks if the handle refers to a subscription.
+     * @return true if the handle was returned by subscribe.
+     */
+    bool isValid() const { return type != UINT32_MAX; }
+};
 
 /**
  * @brief The EventSystem class manages event subscription and publishing.
+ *
+ * Subscribers are bucketed by a dense ID per event type, so publishing only
+ * visits the listeners of that type. Events can also be queued by value and
+ * delivered in batches when the engine calls flush.
+ *
+ * Only the thread that owns the EventSystem may use it directly. Other threads
+ * push into an EventChannel opened for them, which is drained into the queues
+ * at the start of every flush.
  */
 class EventSystem : public System {
 public:
@@ -52,57 +73,384 @@ public:
         Subscriber();
 
         /**
-         * @brief Constructs a Subscriber with type, listener, and callback.
-         * @param t_type The type_index of the event.
-         * @param t_listener Pointer to the listener object.
-         * @param t_callback Callback function pointer.
+         * @brief Constructs a Subscriber with id and delegate.
+         * @param t_id ID of the subscription.
+         * @param t_delegate Delegate to call with each event.
          */
-        Subscriber( std::type_index t_type, Object* t_listener,
-                    EventHandlingCallback t_callback );
+        Subscriber( const uint32_t t_id, const EventDelegate& t_delegate );
 
         /**
          * @brief Default destructor for Subscriber.
          */
         ~Subscriber() = default;
 
-        std::type_index type;           //!< Type of event to listen for.
-        Object* listener;               //!< Pointer to the listener object.
-        EventHandlingCallback callback; //!< Callback function pointer.
+        uint32_t id;            //!< ID of the subscription.
+        EventDelegate delegate; //!< Target, unbound once removed.
     };
 
+    /**
+     * @brief Gets the dense ID of an event type. IDs are handed out on first
+     * use and stay the same for the rest of the run.
+     * @tparam T Event type.
+     * @return Dense ID of the type.
+     */
+    template < class T > static uint32_t typeId() {
+        static const uint32_t id = nextTypeId();
+        return id;
+    }
+
     /**
      * @brief Subscribe an object to a specific event type.
      * @tparam T Event type to subscribe to.
      * @param t_listener Pointer to the listener object.
      * @param t_callback Callback function pointer.
+     * @return Handle to pass to unsubscribe.
      */
     template < class T >
-    void subscribe( Object* t_listener, EventHandlingCallback t_callback ) {
-        m_subscribers.emplace_back( std::make_unique< Subscriber >(
-            typeid( T ), t_listener, t_callback ) );
+    SubscriptionHandle subscribe( Object* t_listener,
+                                  EventHandlingCallback t_callback ) {
+        return addSubscriber(
+            typeId< T >(),
+            EventDelegate::fromCallback( t_listener, t_callback ) );
+    }
+
+    /**
+     * @brief Subscribe a member function to a specific event type, e.g.
+     * subscribe< InputAction >( this, &Player::onAction ).
+     * @tparam EventT Event type to subscribe to.
+     * @tparam C Class of the instance.
+     * @param instance Object to call the member function on.
+     * @param method Member function taking EventT&.
+     * @return Handle to pass to unsubscribe.
+     */
+    template < class EventT, class C >
+    SubscriptionHandle subscribe( C* instance,
+                                  void ( C::*method )( EventT& ) ) {
+        // A const EventT& handler must land on the id publish< EventT > uses
+        return addSubscriber( typeId< std::remove_cv_t< EventT > >(),
+                              EventDelegate::fromMethod( instance, method ) );
     }
 
+    /**
+     * @brief Subscribe a member function known at compile time, e.g.
+     * subscribe< &Player::onAction >( this ). The event type comes from the
+     * member function and the call is inlined into the trampoline.
+     * @tparam Method Member function taking an event by reference.
+     * @tparam C Class of the instance.
+     * @param instance Object to call the member function on.
+     * @return Handle to pass to unsubscribe.
+     */
+    template < auto Method, class C >
+    SubscriptionHandle subscribe( C* instance ) {
+        typedef typename EventMethodTraits< decltype( Method ) >::Event EventT;
+        return addSubscriber(
+            typeId< EventT >(),
+            EventDelegate::fromMethod< Method >( instance ) );
+    }
+
+    /**
+     * @brief Removes a subscription by swapping the last subscriber of the
+     * type into its place, so delivery order is not kept. Safe to call from
+     * inside a callback.
+     * @param handle Handle returned by subscribe.
+     * @return true if the subscription existed.
+     */
+    bool unsubscribe( const SubscriptionHandle handle );
+
     /**
      * @brief Publish an event to all subscribers of the event type.
      * @tparam EventType Type of the event to publish.
      * @param event Pointer to the event object.
      */
     template < typename EventType > void publish( EventType* event ) {
-        std::type_index searchType = typeid( EventType );
+        const uint32_t type = typeId< EventType >();
+        if ( type >= m_buckets.size() ) return;
+
+        ++m_publishDepth;
+
+        // Index instead of iterators, callbacks may subscribe and grow the
+        // lists while we go
+        for ( size_t i = 0; i < m_buckets[type].subscribers.size(); ++i ) {
+            const Subscriber current = m_buckets[type].subscribers[i];
+            if ( !current.delegate.isBound() ) continue;
+
+            current.delegate( event );
+        }
+
+        if ( --m_publishDepth == 0 && m_hasRemovals ) {
+            compact();
+        }
+    }
+
+    /**
+     * @brief Subscribe an object to receive queued events of a type as
+     * contiguous arrays when the queue is flushed.
+     * @tparam T Event type to subscribe to.
+     * @param t_listener Pointer to the listener object.
+     * @param t_callback Callback taking a run of events.
+     * @return Handle to pass to unsubscribe.
+     */
+    template < class T >
+    SubscriptionHandle
+    subscribeBatch( Object* t_listener,
+                    typename EventQueue< T >::BatchCallback t_callback ) {
+        const SubscriptionHandle handle = claimSlot( typeId< T >(), BatchSlot );
+        getQueue< T >().addBatchSubscriber( handle.id, t_listener,
+                                            t_callback );
+
+        return handle;
+    }
+
+    /**
+     * @brief Queues an event, constructed in place, to be delivered on the
+     * next flush. Doesn't allocate once the type's queue has grown to fit a
+     * frame's worth of events.
+     * @tparam T Type of the event to queue.
+     * @tparam Args Constructor argument types.
+     * @param args Arguments forwarded to the event's constructor.
+     */
+    template < class T, class... Args > void enqueue( Args&&... args ) {
+        getQueue< T >().emplace( std::forward< Args >( args )... );
+    }
 
-        for ( auto it = m_subscribers.begin(); it != m_subscribers.end();
-              ++it ) {
-            auto* current = ( *it ).get();
+    /**
+     * @brief Drains the channels, then delivers every queued event. Each
+     * type's events go to its batch listeners as arrays, then one by one to
+     * its regular subscribers. Types are flushed in type ID order, events
+     * queued while flushing wait for the next flush unless their type hasn't
+     * been reached yet.
+     */
+    void flush();
 
-            if ( searchType != current->type ) continue;
+    /**
+     * @brief Opens the cross-thread channel of an event type, or returns the
+     * one already open. Call from the owning thread before handing the
+     * channel to producers; pushing to it is then safe from any thread.
+     * @tparam T Event type.
+     * @param capacity Ring slots, rounded up to a power of two.
+     * @param overflow What to do when the ring is full.
+     * @return Reference to the channel.
+     */
+    template < class T >
+    EventChannel< T >& openChannel( const size_t capacity = 1024,
+                                    const ChannelOverflow overflow = CO_Spill ) {
+        const uint32_t type = typeId< T >();
+        if ( type >= m_channels.size() ) {
+            m_channels.resize( type + 1 );
+            m_drainers.resize( type + 1, nullptr );
+        }
 
-            current->callback( current->listener, event );
+        if ( !m_channels[type] ) {
+            m_channels[type] =
+                std::make_unique< EventChannel< T > >( capacity, overflow );
+            m_drainers[type] = &EventSystem::drainChannel< T >;
         }
+
+        return static_cast< EventChannel< T >& >( *m_channels[type] );
+    }
+
+    /**
+     * @brief Moves the events pushed to every channel into the queues. Called
+     * by flush, which makes it the sync point with producer threads.
+     */
+    void drainChannels();
+
+    /**
+     * @brief Gets the counters of an event type's channel.
+     * @tparam T Event type.
+     * @return Copy of the counters, all zero if no channel is open.
+     */
+    template < class T > ChannelStats getChannelStats() const {
+        const uint32_t type = typeId< T >();
+        if ( type >= m_channels.size() || !m_channels[type] ) return {};
+
+        return m_channels[type]->getStats();
+    }
+
+    /**
+     * @brief Gets the number of queued events of a type.
+     * @tparam T Event type.
+     * @return Number of events waiting for a flush.
+     */
+    template < class T > size_t getQueuedCount() const {
+        const uint32_t type = typeId< T >();
+        if ( type >= m_queues.size() || !m_queues[type] ) return 0;
+
+        return m_queues[type]->size();
+    }
+
+    /**
+     * @brief Gets the number of subscribers of an event type.
+     * @tparam T Event type.
+     * @return Number of subscribers.
+     */
+    template < class T > size_t getSubscriberCount() const {
+        const uint32_t type = typeId< T >();
+        if ( type >= m_buckets.size() ) return 0;
+
+        return m_buckets[type].subscribers.size() -
+               m_buckets[type].removedCount;
     }
 
 protected:
-    std::vector< std::unique_ptr< Subscriber > >
-        m_subscribers; //!< List of event subscribers.
+    /**
+     * @brief Subscribers of a single event type.
+     */
+    struct Bucket {
+        std::vector< Subscriber > subscribers; //!< Contiguous subscribers.
+        size_t removedCount = 0; //!< Removed during a publish, not yet erased.
+    };
+
+    /**
+     * @brief Where a subscription ID's subscriber lives. IDs are reused once
+     * unsubscribed, the generation tells old handles apart.
+     */
+    struct SubscriptionSlot {
+        uint32_t index = UINT32_MAX; //!< Bucket index, or a *Slot marker.
+        uint32_t generation = 0;     //!< Bumped each time the ID is freed.
+    };
+
+    /**
+     * @brief Flushes one type's queue.
+     */
+    typedef void ( EventSystem::*QueueFlusher )();
+
+    /**
+     * @brief Gets the queue of an event type, creating it on first use.
+     * @tparam T Event type.
+     * @return Reference to the queue.
+     */
+    template < class T > EventQueue< T >& getQueue() {
+        const uint32_t type = typeId< T >();
+        if ( type >= m_queues.size() ) {
+            m_queues.resize( type + 1 );
+            m_flushers.resize( type + 1, nullptr );
+        }
+
+        if ( !m_queues[type] ) {
+            m_queues[type] = std::make_unique< EventQueue< T > >();
+            m_flushers[type] = &EventSystem::flushQueue< T >;
+        }
+
+        return static_cast< EventQueue< T >& >( *m_queues[type] );
+    }
+
+    /**
+     * @brief Delivers the events queued for one type.
+     * @tparam T Event type.
+     */
+    template < class T > void flushQueue() {
+        EventQueue< T >& queue =
+            static_cast< EventQueue< T >& >( *m_queues[typeId< T >()] );
+
+        // A listener flushing again would deliver the same events twice
+        if ( queue.isDispatching() ) return;
+
+        const size_t count = queue.beginDispatch();
+        if ( count == 0 ) {
+            queue.endDispatch( 0 );
+            return;
+        }
+
+        T* first;
+        T* second;
+        size_t firstCount;
+        size_t secondCount;
+        queue.spans( count, first, firstCount, second, secondCount );
+
+        // Index instead of iterators, callbacks may subscribe more listeners
+        const auto& batchSubscribers = queue.getBatchSubscribers();
+        for ( size_t i = 0; i < batchSubscribers.size(); ++i ) {
+            const auto current = batchSubscribers[i];
+            if ( !current.callback ) continue;
+
+            current.callback( current.listener, first, firstCount );
+            if ( secondCount > 0 ) {
+                current.callback( current.listener, second, secondCount );
+            }
+        }
+
+        for ( size_t i = 0; i < firstCount; ++i ) {
+            publish( first + i );
+        }
+        for ( size_t i = 0; i < secondCount; ++i ) {
+            publish( second + i );
+        }
+
+        queue.endDispatch( count );
+    }
+
+    /**
+     * @brief Moves one type's channel into its queue.
+     */
+    typedef void ( EventSystem::*ChannelDrainer )();
+
+    /**
+     * @brief Moves the events pushed to one type's channel into its queue.
+     * @tparam T Event type.
+     */
+    template < class T > void drainChannel() {
+        EventChannel< T >& channel =
+            static_cast< EventChannel< T >& >( *m_channels[typeId< T >()] );
+        EventQueue< T >& queue = getQueue< T >();
+
+        channel.drain(
+            [&queue]( T&& event ) { queue.emplace( std::move( event ) ); } );
+    }
+
+    /**
+     * @brief Hands out the next dense event type ID.
+     * @return New type ID.
+     */
+    static uint32_t nextTypeId();
+
+    /**
+     * @brief Hands out a subscription ID, reusing a freed one if possible.
+     * @param type Dense ID of the event type.
+     * @param index Bucket index of the subscriber, or BatchSlot.
+     * @return Handle to the new subscription.
+     */
+    SubscriptionHandle claimSlot( const uint32_t type, const uint32_t index );
+
+    /**
+     * @brief Adds a subscriber to the bucket of an event type.
+     * @param type Dense ID of the event type.
+     * @param t_delegate Delegate to call with each event.
+     * @return Handle to the new subscription.
+     */
+    SubscriptionHandle addSubscriber( const uint32_t type,
+                                      const EventDelegate& t_delegate );
+
+    /**
+     * @brief Swap-removes subscribers that were unsubscribed during a
+     * publish.
+     */
+    void compact();
+
+    /**
+     * @brief Moves the last subscriber into a removed one's place.
+     * @param subscribers Subscribers of one event type.
+     * @param index Index of the subscriber to remove.
+     */
+    void swapRemove( std::vector< Subscriber >& subscribers,
+                     const size_t index );
+
+    static constexpr uint32_t RemovedSlot = UINT32_MAX; //!< Slot of a gone ID.
+    static constexpr uint32_t BatchSlot =
+        UINT32_MAX - 1; //!< Slot of a batch listener, kept by its queue.
+
+    std::vector< Bucket > m_buckets; //!< Subscribers indexed by type ID.
+    std::vector< SubscriptionSlot >
+        m_slots; //!< Bucket index of each subscription ID.
+    std::vector< uint32_t > m_freeSlots; //!< Unsubscribed IDs to reuse.
+    std::vector< std::unique_ptr< EventQueueBase > >
+        m_queues; //!< Queued events indexed by type ID.
+    std::vector< QueueFlusher > m_flushers; //!< Flush of each queue's type.
+    std::vector< std::unique_ptr< EventChannelBase > >
+        m_channels; //!< Cross-thread channels indexed by type ID.
+    std::vector< ChannelDrainer > m_drainers; //!< Drain of each channel.
+    int m_publishDepth = 0;          //!< Nested publish calls in progress.
+    bool m_hasRemovals = false;      //!< Whether compact has work to do.
 };
 
 } // namespace SquirrelEngine
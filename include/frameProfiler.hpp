@@ -0,0 +1,185 @@
+/**
+ *
+ * @file frameProfiler.hpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief Declares the FrameProfiler class, which times named passes of a frame
+ * on the CPU and GPU in SquirrelEngine.
+ * @date 2025-06-06
+ *
+ */
+
+#ifndef FRAMEPROFILER_HPP
+#define FRAMEPROFILER_HPP
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include "system.hpp"
+
+namespace SquirrelEngine {
+
+/**
+ * @brief Times named scopes of a frame on the CPU and GPU.
+ *
+ * GPU time is measured with glQueryCounter timestamps from a ring of query
+ * objects, one set per frame in flight. Results are read FrameLatency frames
+ * later and only when available, so reading never stalls the pipeline.
+ */
+class FrameProfiler : public System {
+public:
+    /**
+     * @brief Timing of a named pass, reported for the most recent frame whose
+     * GPU results are available.
+     */
+    struct PassTiming {
+        const char* name; //!< Name given to the scope.
+        int depth;        //!< Nesting depth of the scope.
+        double cpuMs;     //!< CPU time of the pass.
+        double gpuMs;     //!< GPU time of the pass.
+        double cpuAvgMs;  //!< Smoothed CPU time.
+        double gpuAvgMs;  //!< Smoothed GPU time.
+    };
+
+    /**
+     * @brief Times the enclosing block as a named pass.
+     */
+    class Scope {
+    public:
+        /**
+         * @brief Starts timing a pass.
+         * @param t_profiler Profiler to record into, may be nullptr.
+         * @param name Name of the pass, must outlive the profiler.
+         */
+        Scope( FrameProfiler* t_profiler, const char* name );
+
+        /**
+         * @brief Stops timing the pass.
+         */
+        ~Scope();
+
+    private:
+        FrameProfiler* m_profiler; //!< Profiler being recorded into.
+    };
+
+    /**
+     * @brief Default constructor for FrameProfiler.
+     */
+    FrameProfiler();
+
+    /**
+     * @brief Default destructor for FrameProfiler.
+     */
+    ~FrameProfiler() = default;
+
+    /**
+     * @brief Creates the query objects.
+     * @param t_owner Pointer to the Engine that owns this system.
+     * @return StartupErrors indicating success or failure.
+     */
+    StartupErrors initialize( Engine* t_owner ) override;
+
+    /**
+     * @brief Deletes the query objects.
+     */
+    void shutdown() override;
+
+    /**
+     * @brief Resolves an old frame if its results are ready and starts timing
+     * a new one.
+     */
+    void beginFrame();
+
+    /**
+     * @brief Stops timing the current frame.
+     */
+    void endFrame();
+
+    /**
+     * @brief Starts timing a named pass. Passes may be nested.
+     * @param name Name of the pass, must outlive the profiler.
+     */
+    void beginScope( const char* name );
+
+    /**
+     * @brief Stops timing the innermost open pass.
+     */
+    void endScope();
+
+    /**
+     * @brief Gets the timings of every pass seen so far, in the order they
+     * were first recorded.
+     * @return Reference to the list of pass timings.
+     */
+    const std::vector< PassTiming >& getPassTimings() const;
+
+    /**
+     * @brief Finds the timing of a pass by name.
+     * @param name Name of the pass.
+     * @return Pointer to the pass timing, or nullptr if never recorded.
+     */
+    const PassTiming* findPass( const char* name ) const;
+
+    /**
+     * @brief Gets how many frames were discarded because their GPU results
+     * weren't ready in time.
+     * @return Number of dropped frames.
+     */
+    uint64_t getDroppedFrames() const;
+
+    static constexpr int FrameLatency = 4; //!< Frames before a read.
+    static constexpr int MaxScopes = 32;   //!< Scopes per frame.
+
+private:
+    /**
+     * @brief Recorded scope within a frame.
+     */
+    struct ScopeRecord {
+        const char* name = nullptr; //!< Name of the pass.
+        int depth = 0;              //!< Nesting depth.
+        std::chrono::steady_clock::time_point start; //!< CPU start time.
+        double cpuMs = 0.0;                          //!< CPU time.
+    };
+
+    /**
+     * @brief Scopes recorded during one frame in flight.
+     */
+    struct FrameRecord {
+        std::array< ScopeRecord, MaxScopes > scopes; //!< Recorded scopes.
+        int scopeCount = 0;                          //!< Used scopes.
+    };
+
+    /**
+     * @brief Reads the results of a frame in flight if they are available.
+     * @param slot Ring slot of the frame.
+     */
+    void resolveFrame( const int slot );
+
+    /**
+     * @brief Gets the timestamp query for a scope.
+     * @param slot Ring slot of the frame.
+     * @param scope Index of the scope.
+     * @param isEnd Whether to get the end (true) or start (false) query.
+     * @return Query object name.
+     */
+    GLuint queryFor( const int slot, const int scope, const bool isEnd ) const;
+
+    std::array< FrameRecord, FrameLatency > m_frames; //!< Frames in flight.
+    std::array< GLuint, FrameLatency * MaxScopes * 2 >
+        m_queries = { 0 }; //!< Start/end timestamp per scope.
+    std::array< int, MaxScopes > m_stack = { 0 }; //!< Open scopes.
+    std::vector< PassTiming > m_passes;           //!< Aggregated passes.
+
+    int m_stackDepth = 0;         //!< Number of open scopes.
+    int m_frame = 0;              //!< Frames started so far.
+    uint64_t m_droppedFrames = 0; //!< Frames without results.
+    bool m_hasQueries = false;    //!< Whether queries were created.
+};
+
+} // namespace SquirrelEngine
+
+#endif
@@ -0,0 +1,172 @@
+/**
+ *
+ * @file gamepad.hpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief Declares the Gamepad class, which represents a gamepad input device
+ * for SquirrelEngine.
+ * @date 2025-06-06
+ *
+ */
+
+#ifndef GAMEPAD_HPP
+#define GAMEPAD_HPP
+#pragma once
+
+#include <array>
+
+#include "inputDevice.hpp"
+
+namespace SquirrelEngine {
+
+/**
+ * @brief Enum representing gamepad buttons. Digital buttons follow the GLFW
+ * gamepad layout, followed by the processed axes and the half axes of each
+ * stick so a direction can be mapped to an action on its own.
+ */
+enum GamepadButtons {
+    GAMEPAD_A = 0,             //!< A / cross
+    GAMEPAD_B,                 //!< B / circle
+    GAMEPAD_X,                 //!< X / square
+    GAMEPAD_Y,                 //!< Y / triangle
+    GAMEPAD_LEFT_BUMPER,       //!< Left bumper
+    GAMEPAD_RIGHT_BUMPER,      //!< Right bumper
+    GAMEPAD_BACK,              //!< Back / select
+    GAMEPAD_START,             //!< Start
+    GAMEPAD_GUIDE,             //!< Guide / home
+    GAMEPAD_LEFT_THUMB,        //!< Left stick click
+    GAMEPAD_RIGHT_THUMB,       //!< Right stick click
+    GAMEPAD_DPAD_UP,           //!< D-pad up
+    GAMEPAD_DPAD_RIGHT,        //!< D-pad right
+    GAMEPAD_DPAD_DOWN,         //!< D-pad down
+    GAMEPAD_DPAD_LEFT,         //!< D-pad left
+    GAMEPAD_LEFT_X,            //!< Left stick X, -1 to 1
+    GAMEPAD_LEFT_Y,            //!< Left stick Y, -1 (up) to 1
+    GAMEPAD_RIGHT_X,           //!< Right stick X, -1 to 1
+    GAMEPAD_RIGHT_Y,           //!< Right stick Y, -1 (up) to 1
+    GAMEPAD_LEFT_TRIGGER,      //!< Left trigger, 0 to 1
+    GAMEPAD_RIGHT_TRIGGER,     //!< Right trigger, 0 to 1
+    GAMEPAD_LEFT_STICK_LEFT,   //!< Left stick pushed left, 0 to 1
+    GAMEPAD_LEFT_STICK_RIGHT,  //!< Left stick pushed right, 0 to 1
+    GAMEPAD_LEFT_STICK_UP,     //!< Left stick pushed up, 0 to 1
+    GAMEPAD_LEFT_STICK_DOWN,   //!< Left stick pushed down, 0 to 1
+    GAMEPAD_RIGHT_STICK_LEFT,  //!< Right stick pushed left, 0 to 1
+    GAMEPAD_RIGHT_STICK_RIGHT, //!< Right stick pushed right, 0 to 1
+    GAMEPAD_RIGHT_STICK_UP,    //!< Right stick pushed up, 0 to 1
+    GAMEPAD_RIGHT_STICK_DOWN,  //!< Right stick pushed down, 0 to 1
+    GAMEPAD_BUTTON_LAST        //!< Last gamepad button (sentinel)
+};
+
+/**
+ * @brief Represents a gamepad read through GLFW's gamepad mappings. Any
+ * joystick GLFW recognizes as a gamepad works, including a virtual uinput
+ * device on Linux.
+ */
+class Gamepad : public InputDevice {
+public:
+    /**
+     * @brief Dead zone and response curve of an analog input.
+     */
+    struct AxisSettings {
+        float innerDeadZone = 0.15f; //!< Input below this reads as 0.
+        float outerDeadZone = 0.95f; //!< Input above this reads as 1.
+        float exponent = 1.f; //!< Response curve, 1 linear, 2 quadratic.
+    };
+
+    /**
+     * @brief Constructs a Gamepad.
+     * @param t_joystick GLFW joystick id to read.
+     */
+    Gamepad( const int t_joystick = 0 );
+
+    /**
+     * @brief Virtual destructor for Gamepad.
+     */
+    ~Gamepad() = default;
+
+    /**
+     * @brief Reads the gamepad state and reports buttons that changed.
+     */
+    void poll() override;
+
+    /**
+     * @brief Gets the state of a gamepad button or axis.
+     * @param button The button index.
+     * @return The state of the button as a float.
+     */
+    const float getButtonState( const int button );
+
+    /**
+     * @brief Sets the state of a gamepad button or axis.
+     * @param button The button index.
+     * @param state The new state of the button.
+     */
+    void setButtonState( const int button, const float state );
+
+    /**
+     * @brief Gets the number of buttons the device reports.
+     * @return Number of valid button indices.
+     */
+    const int getButtonCount() override { return GAMEPAD_BUTTON_LAST; }
+
+    /**
+     * @brief Gets the type of the input device.
+     * @return The device type as an int.
+     */
+    const int getType() override { return InputDeviceType::UD_Gamepad; }
+
+    /**
+     * @brief Checks if the joystick is connected and has a gamepad mapping.
+     * @return true if the gamepad was read on the last poll.
+     */
+    bool isConnected() const;
+
+    /**
+     * @brief Sets the radial dead zone and response curve of both sticks.
+     * @param settings Stick settings.
+     */
+    void setStickSettings( const AxisSettings& settings );
+
+    /**
+     * @brief Sets the dead zone and response curve of both triggers.
+     * @param settings Trigger settings.
+     */
+    void setTriggerSettings( const AxisSettings& settings );
+
+protected:
+    /**
+     * @brief Applies the radial dead zone and response curve to a stick.
+     * @param x Raw X axis.
+     * @param y Raw Y axis.
+     * @param outX Processed X axis.
+     * @param outY Processed Y axis.
+     */
+    void processStick( const float x, const float y, float& outX,
+                       float& outY ) const;
+
+    /**
+     * @brief Applies the dead zone and response curve to a trigger.
+     * @param raw Raw trigger axis, -1 to 1.
+     * @return Processed trigger, 0 to 1.
+     */
+    float processTrigger( const float raw ) const;
+
+    /**
+     * @brief Reports a new button state to the InputSystem if it changed.
+     * @param button The button index.
+     * @param state The new state of the button.
+     */
+    void report( const int button, const float state );
+
+    std::array< float, GAMEPAD_BUTTON_LAST > m_buttonStates = {
+        0.f }; //!< Array of button and axis states.
+
+    AxisSettings m_stickSettings; //!< Sticks.
+    AxisSettings m_triggerSettings = { 0.05f, 0.95f, 1.f }; //!< Triggers.
+
+    int m_joystick;             //!< GLFW joystick id.
+    bool m_isConnected = false; //!< Whether the last poll read state.
+};
+
+} // namespace SquirrelEngine
+
+#endif
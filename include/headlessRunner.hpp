@@ -0,0 +1,113 @@
+/**
+ *
+ * @file headlessRunner.hpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief Declares the HeadlessRunner class, which renders frames offscreen and
+ * records their timings for automated runs of SquirrelEngine.
+ * @date 2025-06-06
+ *
+ */
+
+#ifndef HEADLESSRUNNER_HPP
+#define HEADLESSRUNNER_HPP
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include "object.hpp"
+
+namespace SquirrelEngine {
+struct EngineSettings;
+
+/**
+ * @brief Renders into a framebuffer object instead of the window and records
+ * CPU and GPU time of every frame.
+ */
+class HeadlessRunner : public Object {
+public:
+    /**
+     * @brief Default constructor for HeadlessRunner.
+     */
+    HeadlessRunner();
+
+    /**
+     * @brief Destructor for HeadlessRunner. Releases GL objects.
+     */
+    ~HeadlessRunner();
+
+    /**
+     * @brief Creates the framebuffer and timer queries.
+     * @param settings Engine settings with size and output files.
+     * @return true if the framebuffer is complete.
+     */
+    bool initialize( const EngineSettings& settings );
+
+    /**
+     * @brief Binds the framebuffer and starts timing a frame.
+     */
+    void beginFrame();
+
+    /**
+     * @brief Stops timing the current frame.
+     */
+    void endFrame();
+
+    /**
+     * @brief Collects outstanding timings and writes the timing CSV and the
+     * capture PNG, if requested.
+     */
+    void finish();
+
+    /**
+     * @brief Gets the number of frames rendered so far.
+     * @return Frame count.
+     */
+    int getFrameCount() const;
+
+private:
+    /**
+     * @brief Timing of a single frame.
+     */
+    struct FrameTiming {
+        double cpuMs = 0.0; //!< CPU time from beginFrame to endFrame.
+        double gpuMs = 0.0; //!< GPU time between the frame's timestamps.
+    };
+
+    /**
+     * @brief Reads the GPU time of a frame whose queries were issued earlier.
+     * @param frame Index of the frame.
+     */
+    void resolveGpuTime( const int frame );
+
+    /**
+     * @brief Writes the color attachment to a PNG file.
+     * @param filename Output file.
+     */
+    void capture( const std::string& filename );
+
+    static constexpr int QueryLatency = 4; //!< Frames before a read.
+
+    std::array< GLuint, QueryLatency * 2 >
+        m_queries = { 0 }; //!< Start/end timestamp pairs.
+    std::vector< FrameTiming > m_timings; //!< Timing of every frame.
+    std::chrono::steady_clock::time_point m_frameStart; //!< CPU frame start.
+
+    std::string m_timingsFile; //!< CSV output, empty to skip.
+    std::string m_captureFile; //!< PNG output, empty to skip.
+
+    GLuint m_fbo = 0;   //!< Offscreen framebuffer.
+    GLuint m_color = 0; //!< Color renderbuffer.
+    GLuint m_depth = 0; //!< Depth renderbuffer.
+    int m_width = 0;    //!< Framebuffer width.
+    int m_height = 0;   //!< Framebuffer height.
+    int m_frame = 0;    //!< Frames rendered so far.
+};
+
+} // namespace SquirrelEngine
+
+#endif
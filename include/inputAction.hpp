@@ -12,6 +12,7 @@
 #define INPUTACTION_HPP
 #pragma once
 
+#include "actionId.hpp"
 #include "event.hpp"
 #include "inputDevice.hpp"
 
@@ -25,12 +26,12 @@ public:
     InputAction();
 
     /**
-     * @brief Constructs an InputAction with type, device, and amount.
-     * @param t_type The type of input action.
+     * @brief Constructs an InputAction with action, device, and amount.
+     * @param t_action Id of the triggered action.
      * @param t_device Pointer to the input device.
      * @param t_amount The amount or value of the input.
      */
-    InputAction( const std::string t_type, InputDevice* t_device,
+    InputAction( const ActionId t_action, InputDevice* t_device,
                  const float t_amount );
 
     /**
@@ -38,7 +39,7 @@ public:
      */
     ~InputAction() = default;
 
-    std::string type;    //!< The type of input action.
+    ActionId action;     //!< Id of the triggered action.
     InputDevice* device; //!< Pointer to the input device.
     float amount;        //!< The amount or value of the input.
 };
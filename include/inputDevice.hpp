@@ -37,6 +37,12 @@ public:
      */
     virtual void initialize() {}
 
+    /**
+     * @brief Reads state that isn't delivered through window callbacks. Called
+     * before the frame's input snapshot is captured.
+     */
+    virtual void poll() {}
+
     /**
      * @brief Updates the input device state.
      */
@@ -56,6 +62,12 @@ public:
      */
     virtual void setButtonState( const int button, const float state ) = 0;
 
+    /**
+     * @brief Gets the number of buttons the device reports.
+     * @return Number of valid button indices.
+     */
+    virtual const int getButtonCount() = 0;
+
     /**
      * @brief Gets the type of the input device.
      * @return The device type as an int.
@@ -0,0 +1,177 @@
+/**
+ *
+ * @file inputRecorder.hpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief Declares the InputRecorder class, which records input to a binary log
+ * and replays it for repeatable runs of SquirrelEngine.
+ * @date 2025-06-06
+ *
+ */
+
+#ifndef INPUTRECORDER_HPP
+#define INPUTRECORDER_HPP
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "math_types.hpp"
+#include "object.hpp"
+
+namespace SquirrelEngine {
+class InputDevice;
+class InputSystem;
+
+/**
+ * @brief Records every device state change, input action and cursor move with
+ * the frame it happened on, or plays a recording back through the
+ * InputSystem.
+ *
+ * The log is a 16 byte header followed by 12 byte records, all little endian.
+ * During a replay live input is ignored and the TimeManager steps by the
+ * recorded delta time, so every replay of a log runs the same frames.
+ */
+class InputRecorder : public Object {
+public:
+    /**
+     * @brief Default constructor for InputRecorder.
+     */
+    InputRecorder();
+
+    /**
+     * @brief Destructor for InputRecorder. Finishes an open recording.
+     */
+    ~InputRecorder();
+
+    /**
+     * @brief Starts writing a log.
+     * @param filename Log file to create.
+     * @param deltaTime Frame time replays of this log will step by.
+     * @return true if the file was opened.
+     */
+    bool startRecording( const std::string& filename, const float deltaTime );
+
+    /**
+     * @brief Loads a log and disables live input.
+     * @param filename Log file to read.
+     * @return true if the log was read.
+     */
+    bool startReplay( const std::string& filename );
+
+    /**
+     * @brief Sets the frame being recorded, or applies the recorded input of
+     * the frame when replaying. Call before polling window events.
+     * @param frame Index of the frame.
+     */
+    void beginInput( const int frame );
+
+    /**
+     * @brief Records the cursor position once the frame's events are in.
+     * Call after polling window events.
+     */
+    void endInput();
+
+    /**
+     * @brief Records a device state change.
+     * @param device Device that changed.
+     * @param button Button index.
+     * @param state New state of the button.
+     */
+    void recordState( const InputDevice* device, const int button,
+                      const float state );
+
+    /**
+     * @brief Records an input action.
+     * @param device Device that triggered the action.
+     * @param button Button index.
+     * @param amount Amount passed to the action.
+     */
+    void recordAction( const InputDevice* device, const int button,
+                       const float amount );
+
+    /**
+     * @brief Writes the frame count into the log and closes it.
+     */
+    void finish();
+
+    /**
+     * @brief Checks if a log is being played back.
+     * @return true while replaying.
+     */
+    bool isReplaying() const;
+
+    /**
+     * @brief Gets the frame time stored in the log.
+     * @return Delta time in seconds.
+     */
+    float getDeltaTime() const;
+
+    /**
+     * @brief Gets the number of frames in the log.
+     * @return Recorded frame count.
+     */
+    int getFrameCount() const;
+
+private:
+    /**
+     * @brief Kinds of records in the log.
+     */
+    enum RecordType : uint8_t {
+        RT_State = 1,  //!< InputDevice::setButtonState.
+        RT_Action = 2, //!< InputSystem::triggerAction.
+        RT_Cursor = 3, //!< Cursor position, button 0 is x and 1 is y.
+    };
+
+    /**
+     * @brief Start of the log.
+     */
+    struct Header {
+        char magic[4];         //!< "SQIR".
+        uint32_t version;      //!< Format version.
+        float deltaTime;       //!< Frame time to replay with.
+        uint32_t frameCount;   //!< Frames recorded.
+        float motionOrigin[2]; //!< Position cursor motion starts from.
+    };
+
+    /**
+     * @brief One recorded input.
+     */
+    struct Record {
+        uint32_t frame;  //!< Frame the input happened on.
+        uint8_t type;    //!< RecordType.
+        uint8_t device;  //!< Index of the device in the InputSystem.
+        uint16_t button; //!< Button index.
+        float value;     //!< State, amount or cursor coordinate.
+    };
+
+    static_assert( sizeof( Header ) == 24, "Header must be 24 bytes" );
+    static_assert( sizeof( Record ) == 12, "Record must be 12 bytes" );
+
+    /**
+     * @brief Appends a record for the current frame.
+     * @param type Kind of record.
+     * @param device Device index.
+     * @param button Button index.
+     * @param value Recorded value.
+     */
+    void write( const RecordType type, const int device, const int button,
+                const float value );
+
+    std::ofstream m_file;            //!< Log being written.
+    std::vector< Record > m_records; //!< Log being replayed.
+    size_t m_nextRecord = 0;         //!< Next record to replay.
+
+    InputSystem* m_inputSystem = nullptr; //!< System input goes through.
+    vector2 m_lastCursor = vector2( 0.f ); //!< Last recorded cursor.
+    float m_deltaTime = 0.f;              //!< Frame time of the log.
+    int m_frame = 0;                      //!< Current frame.
+    int m_frameCount = 0;                 //!< Frames in the log.
+    bool m_isRecording = false;           //!< Whether a log is open.
+    bool m_isReplaying = false;           //!< Whether a log is playing.
+};
+
+} // namespace SquirrelEngine
+
+#endif
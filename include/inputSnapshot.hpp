@@ -0,0 +1,167 @@
+/**
+ *
+ * @file inputSnapshot.hpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief Declares the InputSnapshot class, which holds the input state of a
+ * single frame in SquirrelEngine.
+ * @date 2025-06-06
+ *
+ */
+
+#ifndef INPUTSNAPSHOT_HPP
+#define INPUTSNAPSHOT_HPP
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "actionId.hpp"
+#include "math_types.hpp"
+
+namespace SquirrelEngine {
+class InputDevice;
+
+/**
+ * @brief Input state of one frame, captured by InputSystem::update.
+ *
+ * Snapshots are never modified after they are published, so any thread may
+ * read the one returned by InputSystem::getSnapshot until the end of the
+ * following frame. Action edges count every transition seen while polling, so
+ * a press and release within one frame still reports wasPressed.
+ */
+class InputSnapshot {
+public:
+    /**
+     * @brief Default constructor for InputSnapshot.
+     */
+    InputSnapshot() = default;
+
+    /**
+     * @brief Gets the frame the snapshot was captured on.
+     * @return Frame number, 0 before the first capture.
+     */
+    uint64_t getFrame() const;
+
+    /**
+     * @brief Gets the state of an action.
+     * @param action Id of the action.
+     * @return State of the action, 0 for unknown ids.
+     */
+    float getActionState( const ActionId action ) const;
+
+    /**
+     * @brief Gets how much an action changed since the previous snapshot.
+     * @param action Id of the action.
+     * @return Change in state, useful for analog axes.
+     */
+    float getActionDelta( const ActionId action ) const;
+
+    /**
+     * @brief Checks if an action is active.
+     * @param action Id of the action.
+     * @return true if the state is non-zero.
+     */
+    bool isHeld( const ActionId action ) const;
+
+    /**
+     * @brief Checks if an action became active during the frame.
+     * @param action Id of the action.
+     * @return true if the action was pressed at least once.
+     */
+    bool wasPressed( const ActionId action ) const;
+
+    /**
+     * @brief Checks if an action stopped being active during the frame.
+     * @param action Id of the action.
+     * @return true if the action was released at least once.
+     */
+    bool wasReleased( const ActionId action ) const;
+
+    /**
+     * @brief Gets the state of a device button.
+     * @param device Pointer to the input device.
+     * @param button Button index.
+     * @return State of the button, 0 if out of range.
+     */
+    float getButtonState( const InputDevice* device, const int button ) const;
+
+    /**
+     * @brief Gets how much a device button changed since the previous
+     * snapshot.
+     * @param device Pointer to the input device.
+     * @param button Button index.
+     * @return Change in state.
+     */
+    float getButtonDelta( const InputDevice* device, const int button ) const;
+
+    /**
+     * @brief Checks if a device button is down.
+     * @param device Pointer to the input device.
+     * @param button Button index.
+     * @return true if the state is non-zero.
+     */
+    bool isButtonHeld( const InputDevice* device, const int button ) const;
+
+    /**
+     * @brief Checks if a device button went down since the previous snapshot.
+     * @param device Pointer to the input device.
+     * @param button Button index.
+     * @return true if the button is down now and wasn't before.
+     */
+    bool wasButtonPressed( const InputDevice* device, const int button ) const;
+
+    /**
+     * @brief Checks if a device button went up since the previous snapshot.
+     * @param device Pointer to the input device.
+     * @param button Button index.
+     * @return true if the button is up now and wasn't before.
+     */
+    bool wasButtonReleased( const InputDevice* device, const int button ) const;
+
+    /**
+     * @brief Gets the cursor position.
+     * @return Cursor position in window coordinates.
+     */
+    const vector2& getCursorPosition() const;
+
+    /**
+     * @brief Gets the summed motion of every cursor event in the frame.
+     * @return Cursor delta in window coordinates.
+     */
+    const vector2& getCursorDelta() const;
+
+private:
+    friend class InputSystem;
+
+    /**
+     * @brief State of an action during the frame.
+     */
+    struct ActionSample {
+        float value = 0.f;     //!< State at capture.
+        float previous = 0.f;  //!< State at the previous capture.
+        uint32_t presses = 0;  //!< Times the action became active.
+        uint32_t releases = 0; //!< Times the action became inactive.
+    };
+
+    /**
+     * @brief Finds a device button in the button arrays.
+     * @param device Pointer to the input device.
+     * @param button Button index.
+     * @return Index into the button arrays, or -1 if out of range.
+     */
+    int findButton( const InputDevice* device, const int button ) const;
+
+    std::vector< ActionSample > m_actions;  //!< Sample of every action.
+    std::vector< float > m_buttons;         //!< Every button of every device.
+    std::vector< float > m_previousButtons; //!< Buttons at the last capture.
+    std::vector< const InputDevice* > m_devices; //!< Captured devices.
+    std::vector< uint32_t > m_deviceOffsets;     //!< First button per device.
+
+    vector2 m_cursor = vector2( 0.f );      //!< Cursor position.
+    vector2 m_cursorDelta = vector2( 0.f ); //!< Cursor movement.
+    uint64_t m_frame = 0;                   //!< Frame of the capture.
+};
+
+} // namespace SquirrelEngine
+
+#endif
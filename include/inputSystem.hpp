@@ -12,14 +12,20 @@
 #define INPUTSYSTEM_HPP
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <memory>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "actionId.hpp"
 #include "inputDevice.hpp"
+#include "inputSnapshot.hpp"
 #include "system.hpp"
 
 namespace SquirrelEngine {
+class InputRecorder;
 
 /**
  * @brief The InputSystem class manages input devices, action mappings, and
@@ -38,10 +44,26 @@ public:
     ~InputSystem() = default;
 
     /**
-     * @brief Updates the input system and all input devices.
+     * @brief Sets the owning engine. The engine updates input itself right
+     * after window events are polled, so no update callback is registered.
+     * @param t_owner Pointer to the Engine that owns this system.
+     * @return StartupErrors indicating success or failure.
+     */
+    StartupErrors initialize( Engine* t_owner ) override;
+
+    /**
+     * @brief Polls devices, captures this frame's snapshot, then updates all
+     * input devices.
      * @param delta Time elapsed since last update.
      */
-    void update( const float delta );
+    void update( const float delta ) override;
+
+    /**
+     * @brief Gets the most recently published snapshot. Safe to call from any
+     * thread, the snapshot stays valid until the end of the next frame.
+     * @return Reference to the snapshot.
+     */
+    const InputSnapshot& getSnapshot() const;
 
     /**
      * @brief Creates and initializes a new input device of type T.
@@ -87,17 +109,90 @@ public:
      */
     InputDevice* findInputDevice( const int type, const int offset = 0 );
 
+    /**
+     * @brief Gets the index of a device, used to refer to it in input logs.
+     * @param device Pointer to the input device.
+     * @return Index of the device, or -1 if it isn't owned by this system.
+     */
+    int getDeviceIndex( const InputDevice* device ) const;
+
+    /**
+     * @brief Gets a device by index.
+     * @param index Index returned by getDeviceIndex.
+     * @return Pointer to the device, or nullptr if out of range.
+     */
+    InputDevice* getDevice( const int index );
+
+    /**
+     * @brief Sets the state of a device's button from live input, recording
+     * it if a recording is running.
+     * @param device Pointer to the input device.
+     * @param button Button index.
+     * @param state New state of the button.
+     */
+    void setButtonState( InputDevice* device, const int button,
+                         const float state );
+
+    /**
+     * @brief Sets the recorder that live input and actions are written to.
+     * @param recorder Recorder to write to, nullptr to stop recording.
+     */
+    void setRecorder( InputRecorder* recorder );
+
+    /**
+     * @brief Enables or disables input from the window, e.g. while a
+     * recording is replayed.
+     * @param enabled Whether device callbacks should change input state.
+     */
+    void setLiveInput( const bool enabled );
+
+    /**
+     * @brief Checks if input from the window is used.
+     * @return true if device callbacks should change input state.
+     */
+    bool isLiveInputEnabled() const;
+
+    /**
+     * @brief Interns an action name, creating the action if it doesn't exist.
+     * @param name Name of the action.
+     * @return Id of the action, or InvalidAction if the name collides with
+     * another action's hash.
+     */
+    ActionId internAction( const ActionName& name );
+
+    /**
+     * @brief Finds an interned action.
+     * @param name Name of the action.
+     * @return Id of the action, or InvalidAction if it was never interned.
+     */
+    ActionId findAction( const ActionName& name ) const;
+
+    /**
+     * @brief Gets the name an action was interned with.
+     * @param action Id of the action.
+     * @return Name of the action, empty for unknown ids.
+     */
+    const std::string& getActionName( const ActionId action ) const;
+
+    /**
+     * @brief Gets the number of interned actions.
+     * @return Action count.
+     */
+    size_t getActionCount() const;
+
     /**
      * @brief Registers an action mapping for a device and button.
      * @param device Pointer to the input device.
      * @param button Button index.
      * @param name Name of the action.
+     * @return Id of the action, or InvalidAction on failure.
      */
-    void registerActionMapping( InputDevice* device, const int button,
-                                const std::string name );
+    ActionId registerActionMapping( InputDevice* device, const int button,
+                                    const ActionName& name );
 
     /**
      * @brief Triggers an action for a device and button with a given amount.
+     * The InputAction events are queued on the EventSystem.
      * @param device Pointer to the input device.
      * @param button Button index.
      * @param amount Value or amount of the action.
@@ -106,41 +201,90 @@ public:
                         const float amount );
 
     /**
-     * @brief Gets the current state of an action.
-     * @param action Name of the action.
+     * @brief Gets the current state of an action. Defined here so the
+     * per-frame queries inline to a single load.
+     * @param action Id of the action.
      * @return The state of the action as a float.
      */
-    const float getActionState( const std::string action );
+    float getActionState( const ActionId action ) const {
+        return ( action < m_actionStates.size() ) ? m_actionStates[action]
+                                                  : 0.f;
+    }
+
+    /**
+     * @brief Gets the current state of an action by name. Prefer caching the
+     * ActionId for queries made every frame.
+     * @param name Name of the action.
+     * @return The state of the action as a float.
+     */
+    float getActionState( const ActionName& name ) const;
 
 protected:
     /**
-     * @brief Structure representing an action mapping.
+     * @brief Device button feeding an action.
      */
     struct ActionMapping {
-        /**
-         * @brief Constructs an ActionMapping.
-         * @param t_name Name of the action.
-         * @param t_device Pointer to the input device.
-         * @param t_button Button index.
-         */
-        ActionMapping( const std::string t_name, InputDevice* t_device,
-                       const int t_button )
-            : action( t_name ), device( t_device ), button( t_button ) {}
-
-        std::string action;  //!< Name of the action.
         InputDevice* device; //!< Pointer to the input device.
         int button;          //!< Button index.
     };
 
+    /**
+     * @brief Action fed by a device button.
+     */
+    struct DeviceBinding {
+        int button;      //!< Button index.
+        ActionId action; //!< Action fed by the button.
+    };
+
+    /**
+     * @brief Hasher for keys that are already hashes.
+     */
+    struct PrehashedKey {
+        size_t operator()( const uint64_t hash ) const {
+            return static_cast< size_t >( hash );
+        }
+    };
+
+    /**
+     * @brief Recomputes the state of every action fed by a device button.
+     * @param device Pointer to the input device.
+     * @param button Button index.
+     */
+    void refreshActions( InputDevice* device, const int button );
+
+    /**
+     * @brief Recomputes the state of an action from its mappings.
+     * @param action Id of the action.
+     */
+    void refreshAction( const ActionId action );
+
+    /**
+     * @brief Fills the snapshot that isn't published and publishes it.
+     */
+    void captureSnapshot();
+
     std::vector< std::unique_ptr< InputDevice > >
         m_devices; //!< List of input devices.
 
-    std::unordered_map< std::string,
-                        std::vector< std::unique_ptr< ActionMapping > > >
-        m_actions; //!< Map of action names to their mappings.
+    std::vector< float > m_actionStates;      //!< State of every action.
+    std::vector< std::string > m_actionNames; //!< Name of every action.
+    std::vector< std::vector< ActionMapping > >
+        m_actionMappings; //!< Buttons feeding every action.
+    std::unordered_map< uint64_t, ActionId, PrehashedKey >
+        m_actionIds; //!< Name hashes to action ids.
+    std::vector< uint32_t > m_actionPresses;  //!< Presses since capture.
+    std::vector< uint32_t > m_actionReleases; //!< Releases since capture.
+
+    std::array< InputSnapshot, 2 > m_snapshots; //!< Published and next.
+    std::atomic< const InputSnapshot* > m_published =
+        &m_snapshots[0];  //!< Snapshot readers see.
+    uint64_t m_frame = 0; //!< Snapshots captured so far.
+
+    std::unordered_map< InputDevice*, std::vector< DeviceBinding > >
+        m_deviceActions; //!< Map of devices to the actions they feed.
 
-    std::unordered_map< InputDevice*, std::vector< ActionMapping* > >
-        m_deviceActions; //!< Map of devices to their action mappings.
+    InputRecorder* m_recorder = nullptr; //!< Recorder for live input.
+    bool m_liveInput = true;             //!< Whether window input is used.
 };
 
 } // namespace SquirrelEngine
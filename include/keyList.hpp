@@ -14,100 +14,111 @@
 
 namespace SquirrelEngine {
 
+/**
+ * @brief Every supported key as ENTRY( engine key, GLFW key name without the
+ * GLFW_KEY_ prefix ). Expanded into the Keys enum below and into the GLFW
+ * lookup table in keyboard.cpp, so the two can't disagree.
+ */
+#define SQUIRREL_KEY_LIST( ENTRY )                   \
+    ENTRY( KEY_0, 0 )                                \
+    ENTRY( KEY_1, 1 )                                \
+    ENTRY( KEY_2, 2 )                                \
+    ENTRY( KEY_3, 3 )                                \
+    ENTRY( KEY_4, 4 )                                \
+    ENTRY( KEY_5, 5 )                                \
+    ENTRY( KEY_6, 6 )                                \
+    ENTRY( KEY_7, 7 )                                \
+    ENTRY( KEY_8, 8 )                                \
+    ENTRY( KEY_9, 9 )                                \
+    ENTRY( KEY_A, A )                                \
+    ENTRY( KEY_B, B )                                \
+    ENTRY( KEY_C, C )                                \
+    ENTRY( KEY_D, D )                                \
+    ENTRY( KEY_E, E )                                \
+    ENTRY( KEY_F, F )                                \
+    ENTRY( KEY_G, G )                                \
+    ENTRY( KEY_H, H )                                \
+    ENTRY( KEY_I, I )                                \
+    ENTRY( KEY_J, J )                                \
+    ENTRY( KEY_K, K )                                \
+    ENTRY( KEY_L, L )                                \
+    ENTRY( KEY_M, M )                                \
+    ENTRY( KEY_N, N )                                \
+    ENTRY( KEY_O, O )                                \
+    ENTRY( KEY_P, P )                                \
+    ENTRY( KEY_Q, Q )                                \
+    ENTRY( KEY_R, R )                                \
+    ENTRY( KEY_S, S )                                \
+    ENTRY( KEY_T, T )                                \
+    ENTRY( KEY_U, U )                                \
+    ENTRY( KEY_V, V )                                \
+    ENTRY( KEY_W, W )                                \
+    ENTRY( KEY_X, X )                                \
+    ENTRY( KEY_Y, Y )                                \
+    ENTRY( KEY_Z, Z )                                \
+    ENTRY( KEY_TAB, TAB )                            \
+    ENTRY( KEY_LEFT_SHIFT, LEFT_SHIFT )              \
+    ENTRY( KEY_RIGHT_SHIFT, RIGHT_SHIFT )            \
+    ENTRY( KEY_LEFT_CTRL, LEFT_CONTROL )             \
+    ENTRY( KEY_RIGHT_CTRL, RIGHT_CONTROL )           \
+    ENTRY( KEY_LEFT_ALT, LEFT_ALT )                  \
+    ENTRY( KEY_RIGHT_ALT, RIGHT_ALT )                \
+    ENTRY( KEY_SPACE, SPACE )                        \
+    ENTRY( KEY_ESCAPE, ESCAPE )                      \
+    ENTRY( KEY_BACKSPACE, BACKSPACE )                \
+    ENTRY( KEY_ENTER, ENTER )                        \
+    ENTRY( KEY_EQUALS, EQUAL )                       \
+    ENTRY( KEY_MINUS, MINUS )                        \
+    ENTRY( KEY_LEFT_SQUARE_BRACKET, LEFT_BRACKET )   \
+    ENTRY( KEY_RIGHT_SQUARE_BRACKET, RIGHT_BRACKET ) \
+    ENTRY( KEY_BACK_SLASH, BACKSLASH )               \
+    ENTRY( KEY_FORWARD_SLASH, SLASH )                \
+    ENTRY( KEY_COMMA, COMMA )                        \
+    ENTRY( KEY_PERIOD, PERIOD )                      \
+    ENTRY( KEY_INSERT, INSERT )                      \
+    ENTRY( KEY_DELETE, DELETE )                      \
+    ENTRY( KEY_HOME, HOME )                          \
+    ENTRY( KEY_END, END )                            \
+    ENTRY( KEY_PAGE_UP, PAGE_UP )                    \
+    ENTRY( KEY_PAGE_DOWN, PAGE_DOWN )                \
+    ENTRY( KEY_PRINT_SCREEN, PRINT_SCREEN )          \
+    ENTRY( KEY_UP, UP )                              \
+    ENTRY( KEY_DOWN, DOWN )                          \
+    ENTRY( KEY_LEFT, LEFT )                          \
+    ENTRY( KEY_RIGHT, RIGHT )                        \
+    ENTRY( KEY_NUMPAD_PLUS, KP_ADD )                 \
+    ENTRY( KEY_NUMPAD_0, KP_0 )                      \
+    ENTRY( KEY_NUMPAD_1, KP_1 )                      \
+    ENTRY( KEY_NUMPAD_2, KP_2 )                      \
+    ENTRY( KEY_NUMPAD_3, KP_3 )                      \
+    ENTRY( KEY_NUMPAD_4, KP_4 )                      \
+    ENTRY( KEY_NUMPAD_5, KP_5 )                      \
+    ENTRY( KEY_NUMPAD_6, KP_6 )                      \
+    ENTRY( KEY_NUMPAD_7, KP_7 )                      \
+    ENTRY( KEY_NUMPAD_8, KP_8 )                      \
+    ENTRY( KEY_NUMPAD_9, KP_9 )                      \
+    ENTRY( KEY_FUNC_F1, F1 )                         \
+    ENTRY( KEY_FUNC_F2, F2 )                         \
+    ENTRY( KEY_FUNC_F3, F3 )                         \
+    ENTRY( KEY_FUNC_F4, F4 )                         \
+    ENTRY( KEY_FUNC_F5, F5 )                         \
+    ENTRY( KEY_FUNC_F6, F6 )                         \
+    ENTRY( KEY_FUNC_F7, F7 )                         \
+    ENTRY( KEY_FUNC_F8, F8 )                         \
+    ENTRY( KEY_FUNC_F9, F9 )                         \
+    ENTRY( KEY_FUNC_F10, F10 )                       \
+    ENTRY( KEY_FUNC_F11, F11 )                       \
+    ENTRY( KEY_FUNC_F12, F12 )
+
 /**
  * @brief Enum representing all supported keyboard keys.
  */
 enum Keys {
-    KEY_0 = 1,                //!< Key 0
-    KEY_1,                    //!< Key 1
-    KEY_2,                    //!< Key 2
-    KEY_3,                    //!< Key 3
-    KEY_4,                    //!< Key 4
-    KEY_5,                    //!< Key 5
-    KEY_6,                    //!< Key 6
-    KEY_7,                    //!< Key 7
-    KEY_8,                    //!< Key 8
-    KEY_9,                    //!< Key 9
-    KEY_A,                    //!< Key A
-    KEY_B,                    //!< Key B
-    KEY_C,                    //!< Key C
-    KEY_D,                    //!< Key D
-    KEY_E,                    //!< Key E
-    KEY_F,                    //!< Key F
-    KEY_G,                    //!< Key G
-    KEY_H,                    //!< Key H
-    KEY_I,                    //!< Key I
-    KEY_J,                    //!< Key J
-    KEY_K,                    //!< Key K
-    KEY_L,                    //!< Key L
-    KEY_M,                    //!< Key M
-    KEY_N,                    //!< Key N
-    KEY_O,                    //!< Key O
-    KEY_P,                    //!< Key P
-    KEY_Q,                    //!< Key Q
-    KEY_R,                    //!< Key R
-    KEY_S,                    //!< Key S
-    KEY_T,                    //!< Key T
-    KEY_U,                    //!< Key U
-    KEY_V,                    //!< Key V
-    KEY_W,                    //!< Key W
-    KEY_X,                    //!< Key X
-    KEY_Y,                    //!< Key Y
-    KEY_Z,                    //!< Key Z
-    KEY_TAB,                  //!< Tab key
-    KEY_LEFT_SHIFT,           //!< Left Shift key
-    KEY_RIGHT_SHIFT,          //!< Right Shift key
-    KEY_LEFT_CTRL,            //!< Left Control key
-    KEY_RIGHT_CTRL,           //!< Right Control key
-    KEY_LEFT_ALT,             //!< Left Alt key
-    KEY_RIGHT_ALT,            //!< Right Alt key
-    KEY_SPACE,                //!< Spacebar
-    KEY_ESCAPE,               //!< Escape key
-    KEY_BACKSPACE,            //!< Backspace key
-    KEY_ENTER,                //!< Enter/Return key
-    KEY_EQUALS,               //!< Equals key
-    KEY_MINUS,                //!< Minus key
-    KEY_LEFT_SQUARE_BRACKET,  //!< Left square bracket
-    KEY_RIGHT_SQUARE_BRACKET, //!< Right square bracket
-    KEY_BACK_SLASH,           //!< Backslash
-    KEY_FORWARD_SLASH,        //!< Forward slash
-    KEY_COMMA,                //!< Comma
-    KEY_PERIOD,               //!< Period
-    KEY_INSERT,               //!< Insert key
-    KEY_DELETE,               //!< Delete key
-    KEY_HOME,                 //!< Home key
-    KEY_END,                  //!< End key
-    KEY_PAGE_UP,              //!< Page Up key
-    KEY_PAGE_DOWN,            //!< Page Down key
-    KEY_PRINT_SCREEN,         //!< Print Screen key
-    KEY_UP,                   //!< Up arrow key
-    KEY_DOWN,                 //!< Down arrow key
-    KEY_LEFT,                 //!< Left arrow key
-    KEY_RIGHT,                //!< Right arrow key
-    KEY_NUMPAD_PLUS,          //!< Numpad plus key
-    KEY_NUMPAD_0,             //!< Numpad 0
-    KEY_NUMPAD_1,             //!< Numpad 1
-    KEY_NUMPAD_2,             //!< Numpad 2
-    KEY_NUMPAD_3,             //!< Numpad 3
-    KEY_NUMPAD_4,             //!< Numpad 4
-    KEY_NUMPAD_5,             //!< Numpad 5
-    KEY_NUMPAD_6,             //!< Numpad 6
-    KEY_NUMPAD_7,             //!< Numpad 7
-    KEY_NUMPAD_8,             //!< Numpad 8
-    KEY_NUMPAD_9,             //!< Numpad 9
-    KEY_FUNC_F1,              //!< Function key F1
-    KEY_FUNC_F2,              //!< Function key F2
-    KEY_FUNC_F3,              //!< Function key F3
-    KEY_FUNC_F4,              //!< Function key F4
-    KEY_FUNC_F5,              //!< Function key F5
-    KEY_FUNC_F6,              //!< Function key F6
-    KEY_FUNC_F7,              //!< Function key F7
-    KEY_FUNC_F8,              //!< Function key F8
-    KEY_FUNC_F9,              //!< Function key F9
-    KEY_FUNC_F10,             //!< Function key F10
-    KEY_FUNC_F11,             //!< Function key F11
-    KEY_FUNC_F12,             //!< Function key F12
-    KEY_LAST                  //!< Last key (sentinel value)
+    KEY_UNKNOWN = 0, //!< Key without an engine mapping
+#define SQUIRREL_KEY_ENUM( key, glfwKey ) key,
+    SQUIRREL_KEY_LIST( SQUIRREL_KEY_ENUM )
+#undef SQUIRREL_KEY_ENUM
+    KEY_LAST //!< Last key (sentinel value)
 };
 
 } // namespace SquirrelEngine
@@ -54,6 +54,12 @@ public:
      */
     void setButtonState( const int button, const float state );
 
+    /**
+     * @brief Gets the number of buttons the device reports.
+     * @return Number of valid button indices.
+     */
+    const int getButtonCount() override { return KEY_LAST; }
+
     /**
      * @brief Gets the type of the input device.
      * @return The device type as an int.
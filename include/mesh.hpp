@@ -42,6 +42,9 @@ struct Vertex {
     vector2 uv;       //!< Vertex texture coordinates.
 };
 
+//! Triangle vertices of a model file, shared through the MeshCache
+using MeshData = std::vector< Vertex >;
+
 /**
  * @brief Represents a renderable mesh and its associated data.
  */
@@ -83,13 +86,16 @@ public:
     bool load( std::string t_modelName );
 
     /**
-     * @brief Draws the mesh.
+     * @brief Draws the mesh. Models sharing the mesh each pass their own
+     * render method.
+     * @param matrix Model matrix to draw with.
+     * @param renderMethod OpenGL primitive type to draw with.
      */
-    void draw();
+    void draw( const matrix4& matrix, const GLuint renderMethod );
 
     /**
      * @brief Sets the shader program for this mesh.
-     * @param t_shader Pointer to the shader Program.
+     * @param t_shader Pointer to the shader Program (not owned by the mesh).
      */
     void setShader( Program* t_shader );
 
@@ -100,7 +106,8 @@ public:
     const Program* getShader() const;
 
     /**
-     * @brief Loads and sets the shader from vertex and fragment shader files.
+     * @brief Requests the shader from the ShaderCompiler. The mesh draws with
+     * the fallback program until the build is ready.
      * @param vertName Vertex shader filename.
      * @param fragName Fragment shader filename.
      */
@@ -114,25 +121,22 @@ public:
 
 private:
     /**
-     * @brief Reads mesh data from a model file.
+     * @brief Gets the model file's vertices from the MeshCache and uploads
+     * them.
      * @param t_modelName Name of the model file.
      * @return true if read successfully, false otherwise.
      */
     bool read( std::string t_modelName );
 
     /**
-     * @brief Inserts vertex data from parsed model data.
-     * @param data Array of strings containing vertex data.
-     * @param v Vector of positions.
-     * @param vt Vector of texture coordinates.
-     * @param vn Vector of normals.
+     * @brief Creates the vertex array and buffer holding the vertices.
      */
-    void insertData( char* data[3], std::vector< vector3 >& v,
-                     std::vector< vector2 >& vt, std::vector< vector3 >& vn );
+    void upload();
 
     Model* m_model = nullptr;            //!< Pointer to the associated Model.
-    std::unique_ptr< Program > m_shader; //!< Shader program for this mesh.
-    std::vector< Vertex > m_vertices;    //!< List of vertices for the mesh.
+    Program* m_shader = nullptr;         //!< Shader program (not owned).
+    std::shared_ptr< const MeshData >
+        m_vertices; //!< Vertices, shared by the cache.
     std::string m_modelName;             //!< Name of the file for the model.
     GLsizei vertCount = 0;               //!< Number of vertices.
     GLuint vao = 0;                      //!< Vertex Array Object.
@@ -0,0 +1,102 @@
+/**
+ *
+ * @file meshCache.hpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief Declares the MeshCache class, which parses each model file once and
+ * shares its vertices between meshes in SquirrelEngine.
+ * @date 2025-06-06
+ *
+ */
+
+#ifndef MESHCACHE_HPP
+#define MESHCACHE_HPP
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "mesh.hpp"
+#include "system.hpp"
+
+namespace SquirrelEngine {
+
+/**
+ * @brief Parses model files into vertices once and hands every mesh using the
+ * same file the same data. Safe to call from loader threads, so files can be
+ * parsed before the meshes that use them are made.
+ */
+class MeshCache : public System {
+public:
+    /**
+     * @brief Default constructor for MeshCache.
+     */
+    MeshCache();
+
+    /**
+     * @brief Destructor for MeshCache.
+     */
+    ~MeshCache();
+
+    /**
+     * @brief Drops every cached file. Meshes keep the data they already have.
+     */
+    void shutdown() override;
+
+    /**
+     * @brief Gets the vertices of a model file, parsing it on the first call.
+     * Thread safe.
+     * @param filename Name of the model file.
+     * @return Shared vertices, or nullptr if the file can't be opened.
+     */
+    std::shared_ptr< const MeshData > load( const std::string& filename );
+
+    /**
+     * @brief Drops the files no mesh or loader is using anymore.
+     * @return Bytes of vertices freed.
+     */
+    size_t trim();
+
+    /**
+     * @brief Gets the bytes of vertices currently cached.
+     * @return Memory used by the cache.
+     */
+    size_t getMemoryUsage() const;
+
+    /**
+     * @brief Gets the number of files currently cached.
+     * @return Number of cached files.
+     */
+    size_t getMeshCount() const;
+
+private:
+    /**
+     * @brief Parses a Wavefront OBJ file into triangle vertices.
+     * @param filename Name of the model file.
+     * @return Parsed vertices, or nullptr if the file can't be opened.
+     */
+    static std::shared_ptr< MeshData > read( const std::string& filename );
+
+    /**
+     * @brief Adds the vertex a face corner refers to.
+     * @param data Position, uv and normal indices of the corner.
+     * @param v List of positions.
+     * @param vt List of texture coordinates.
+     * @param vn List of normals.
+     * @param vertices Vertices to add to.
+     */
+    static void insertData( char* data[3], std::vector< vector3 >& v,
+                            std::vector< vector2 >& vt,
+                            std::vector< vector3 >& vn, MeshData& vertices );
+
+    mutable std::mutex m_mutex; //!< Guards the map and memory count.
+    std::unordered_map< std::string, std::shared_ptr< const MeshData > >
+        m_meshes;             //!< Vertices by file name.
+    size_t m_memoryUsage = 0; //!< Bytes of vertices in the map.
+};
+
+} // namespace SquirrelEngine
+
+#endif
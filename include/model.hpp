@@ -15,6 +15,7 @@
 #include <memory>
 
 #include "component.hpp"
+#include "math_types.hpp"
 
 namespace SquirrelEngine {
 class Mesh;
@@ -42,7 +43,8 @@ public:
     void initMesh( const std::string& filename );
 
     /**
-     * @brief Initializes the shader for this model.
+     * @brief Initializes the shader for this model. A mesh shared with other
+     * models is copied first, so they keep their shader.
      * @param vertName Vertex shader file name.
      * @param fragName Fragment shader file name.
      */
@@ -50,8 +52,9 @@ public:
 
     /**
      * @brief Draws the model.
+     * @param matrix Model matrix to draw with.
      */
-    void draw();
+    void draw( const matrix4& matrix );
 
     /**
      * @brief Sets the mesh for this model.
@@ -59,12 +62,31 @@ public:
      */
     void setMesh( Mesh* t_mesh );
 
+    /**
+     * @brief Draws a mesh shared with other models, such as a Prefab's,
+     * without copying or uploading it again.
+     * @param t_mesh Shared mesh.
+     */
+    void setMesh( std::shared_ptr< Mesh > t_mesh );
+
     /**
      * @brief Gets the mesh associated with this model.
      * @return Pointer to the Mesh.
      */
     Mesh* getMesh() const;
 
+    /**
+     * @brief Gets the mesh for other models to share with setMesh.
+     * @return Shared pointer to the Mesh.
+     */
+    std::shared_ptr< Mesh > getSharedMesh() const;
+
+    /**
+     * @brief Checks if other models draw the same mesh.
+     * @return true if the mesh is shared.
+     */
+    bool isMeshShared() const;
+
     /**
      * @brief Sets the render method (OpenGL primitive type).
      * @param t_renderMethod The render method (e.g., GL_TRIANGLES).
@@ -78,7 +100,7 @@ public:
     GLuint getRenderMethod() const;
 
 private:
-    std::unique_ptr< Mesh > m_mesh; //!< Pointer to the mesh.
+    std::shared_ptr< Mesh > m_mesh; //!< Mesh, possibly shared.
     GLuint m_renderMethod; //!< OpenGL render method (e.g., GL_TRIANGLES).
 };
 
@@ -35,6 +35,16 @@ enum MouseButtons {
  */
 class Mouse : public InputDevice {
 public:
+    /**
+     * @brief Cursor motion reported by a single window event.
+     */
+    struct MotionSample {
+        double time;   //!< Time of the event in seconds.
+        vector2 delta; //!< Movement since the previous event.
+    };
+
+    static constexpr int MaxMotionSamples = 512; //!< Samples kept per frame.
+
     /**
      * @brief Default constructor for Mouse.
      */
@@ -50,6 +60,16 @@ public:
      */
     void initialize();
 
+    /**
+     * @brief Hands the motion accumulated since the last poll to this frame.
+     */
+    void poll() override;
+
+    /**
+     * @brief Clears the scroll accumulated during the last frame.
+     */
+    void update() override;
+
     /**
      * @brief Gets the state of a mouse button.
      * @param button The button index.
@@ -64,6 +84,12 @@ public:
      */
     void setButtonState( const int button, const float state );
 
+    /**
+     * @brief Gets the number of buttons the device reports.
+     * @return Number of valid button indices.
+     */
+    const int getButtonCount() override { return BUTTON_MOUSE_LAST; }
+
     /**
      * @brief Gets the type of the input device.
      * @return The device type as an int.
@@ -82,17 +108,95 @@ public:
      */
     const vector2 getCursorDelta();
 
+    /**
+     * @brief Overrides the cursor position reported by the mouse, e.g. with a
+     * recorded one. The window's cursor is no longer read afterwards. Each
+     * call adds one motion sample, so a replay driving the cursor once per
+     * frame reports one sample per frame.
+     * @param position Cursor position to report.
+     * @param time Time of the motion sample in seconds.
+     */
+    void driveCursor( const vector2& position, const double time );
+
     /**
      * @brief Sets the cursor mode (e.g., normal, hidden, disabled).
      * @param t_cursorMode The cursor mode to set.
      */
     void setCursorMode( const int t_cursorMode );
 
+    /**
+     * @brief Enables or disables unscaled, unaccelerated motion while the
+     * cursor is disabled.
+     * @param enabled Whether to use raw motion.
+     * @return true if the platform supports raw motion.
+     */
+    bool setRawMotion( const bool enabled );
+
+    /**
+     * @brief Checks if raw motion is enabled.
+     * @return true if raw motion was enabled and is supported.
+     */
+    bool isRawMotionEnabled() const;
+
+    /**
+     * @brief Adds a cursor motion event. Called for every cursor position
+     * event between polls.
+     * @param position New cursor position.
+     * @param time Time of the event in seconds.
+     */
+    void addMotion( const vector2& position, const double time );
+
+    /**
+     * @brief Gets the position the next motion event is measured from, or
+     * the cursor position if no event was seen yet.
+     * @return Motion origin in cursor units.
+     */
+    const vector2 getMotionOrigin();
+
+    /**
+     * @brief Sets the position the next motion event is measured from, so
+     * the first event reports a delta instead of being swallowed.
+     * @param position Motion origin in cursor units.
+     */
+    void setMotionOrigin( const vector2& position );
+
+    /**
+     * @brief Gets the summed motion of every event delivered this frame.
+     * Unlike the cursor delta it doesn't depend on when it is read.
+     * @return Motion in cursor units.
+     */
+    const vector2& getMotionDelta() const;
+
+    /**
+     * @brief Gets the motion events delivered this frame, oldest first.
+     * @return Pointer to the first sample.
+     */
+    const MotionSample* getMotionSamples() const;
+
+    /**
+     * @brief Gets the number of motion events delivered this frame.
+     * @return Sample count, at most MaxMotionSamples.
+     */
+    int getMotionSampleCount() const;
+
 protected:
     std::array< int, BUTTON_MOUSE_LAST > m_buttonStates = {
         0 };                      //!< Array of mouse button states.
     vector2 m_lastCursorPosition; //!< Last recorded cursor position.
     int m_cursorMode;             //!< Current cursor mode.
+
+    vector2 m_drivenCursorPosition = vector2( 0.f ); //!< Overridden cursor.
+    bool m_isCursorDriven = false; //!< Whether the cursor is overridden.
+
+    std::array< std::array< MotionSample, MaxMotionSamples >, 2 >
+        m_motionSamples;                       //!< Pending and frame samples.
+    std::array< int, 2 > m_motionCount = { 0 }; //!< Samples in each buffer.
+    std::array< vector2, 2 > m_motionDelta = {
+        vector2( 0.f ), vector2( 0.f ) }; //!< Summed motion of each buffer.
+    int m_pendingMotion = 0;               //!< Buffer events are added to.
+    vector2 m_lastMotionPosition = vector2( 0.f ); //!< Last event position.
+    bool m_hasMotionPosition = false; //!< Whether an event was seen.
+    bool m_isRawMotion = false;       //!< Whether raw motion is enabled.
 };
 
 } // namespace SquirrelEngine
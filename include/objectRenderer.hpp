@@ -12,12 +12,49 @@
 #define OBJECTRENDERER_HPP
 #pragma once
 
+#include <cstdint>
 #include <vector>
 
+#include <glad/glad.h>
+
+#include "math_types.hpp"
 #include "system.hpp"
 
 namespace SquirrelEngine {
 class Entity;
+class FrameProfiler;
+class Model;
+class Program;
+class TimeManager;
+
+/**
+ * @brief Camera data shared by every pass, matches the std140 PerFrameData
+ * block at binding 0 in the shaders.
+ */
+struct PerFrameData {
+    matrix4 view;      //!< View matrix of the main camera.
+    matrix4 proj;      //!< Projection matrix of the main camera.
+    vector4 cameraPos; //!< World position of the main camera, w unused.
+};
+
+/**
+ * @brief One model to draw and where.
+ */
+struct DrawItem {
+    Model* model;   //!< Model to draw.
+    matrix4 matrix; //!< Interpolated model matrix.
+};
+
+/**
+ * @brief Everything the renderer needs to draw a frame, captured by the
+ * simulation so the render thread never reads the world.
+ */
+struct RenderSnapshot {
+    PerFrameData frameData;        //!< Camera of the frame.
+    std::vector< DrawItem > draws; //!< Models in draw order.
+    uint64_t frame = 0;            //!< Simulation frame it was captured on.
+    bool hasCamera = false;        //!< Whether frameData was filled in.
+};
 
 /**
  * @brief Handles rendering of entities in SquirrelEngine.
@@ -30,9 +67,73 @@ public:
     ObjectRenderer();
 
     /**
-     * @brief Renders all entities.
+     * @brief Creates the per-frame uniform buffer and requests the grid
+     * program.
+     * @param t_owner Pointer to the Engine that owns this system.
+     * @return StartupErrors indicating success or failure.
+     */
+    StartupErrors initialize( Engine* t_owner ) override;
+
+    /**
+     * @brief Deletes the GL objects owned by the renderer.
+     */
+    void shutdown() override;
+
+    /**
+     * @brief Renders all entities, interpolated between their last two fixed
+     * steps.
      */
     void render();
+
+    /**
+     * @brief Captures the camera and every model's interpolated matrix.
+     * Doesn't touch OpenGL, so it runs on the simulation thread.
+     * @param snapshot Snapshot to fill, draws are appended.
+     */
+    void buildSnapshot( RenderSnapshot& snapshot );
+
+    /**
+     * @brief Draws a captured frame. Only reads the snapshot and the models
+     * it points to.
+     * @param snapshot Frame to draw.
+     */
+    void render( const RenderSnapshot& snapshot );
+
+    /**
+     * @brief Enables or disables the ground grid pass.
+     * @param enabled Whether to draw the grid.
+     */
+    void setGridEnabled( const bool enabled );
+
+    /**
+     * @brief Checks if the ground grid pass is drawn.
+     * @return true if the grid is enabled.
+     */
+    bool isGridEnabled() const;
+
+    static constexpr GLuint PerFrameBinding = 0; //!< UBO binding point.
+
+private:
+    /**
+     * @brief Uploads the camera matrices of a frame to the per-frame buffer.
+     * @param data Camera data of the frame.
+     */
+    void updatePerFrameData( const PerFrameData& data );
+
+    /**
+     * @brief Draws the procedural ground grid with a single attribute-less
+     * draw call.
+     */
+    void renderGrid();
+
+    FrameProfiler* m_profiler = nullptr;  //!< Profiler for the passes.
+    TimeManager* m_timeManager = nullptr; //!< Source of the blend factor.
+    Program* m_gridShader = nullptr;      //!< Grid program (not owned).
+    GLuint m_perFrameBuffer = 0;          //!< PerFrameData uniform buffer.
+    GLuint m_emptyVao = 0;                //!< VAO without attributes.
+    bool m_gridEnabled = true;            //!< Whether to draw the grid.
+
+    RenderSnapshot m_snapshot; //!< Reused by render() on a single thread.
 };
 
 } // namespace SquirrelEngine
@@ -0,0 +1,107 @@
+/**
+ *
+ * @file prefab.hpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief Declares the Prefab class, an immutable entity template whose assets
+ * are loaded once and shared by every instance in SquirrelEngine.
+ * @date 2025-06-06
+ *
+ */
+
+#ifndef PREFAB_HPP
+#define PREFAB_HPP
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "math_types.hpp"
+#include "quaternion.hpp"
+#include "transform.hpp"
+#include "world.hpp"
+
+namespace SquirrelEngine {
+class Entity;
+class Mesh;
+
+/**
+ * @brief What a prefab is built from.
+ */
+struct PrefabDesc {
+    std::string name;               //!< Name of the prefab and instances.
+    Quaternion rotation;            //!< Rotation of new instances.
+    vector3 scale = vector3( 1.f ); //!< Scale of new instances.
+    std::string mesh;               //!< Model file, empty for no Model.
+    std::string vertShader;         //!< Vertex shader file.
+    std::string fragShader;         //!< Fragment shader file.
+    EntityTags tags;                //!< Tags of new instances.
+};
+
+/**
+ * @brief Template entities are stamped from. The mesh is loaded, uploaded and
+ * given its shader once, then every instance's Model draws that same mesh, so
+ * an instance costs its entity, transform and a pointer. Overrides are copy on
+ * write and only stored by the instances that make them: initShader or
+ * initMesh on an instance's Model gives it a mesh of its own and leaves the
+ * prefab and the other instances alone.
+ */
+class Prefab {
+public:
+    /**
+     * @brief Loads the prefab's assets.
+     * @param t_desc What to build the prefab from.
+     */
+    Prefab( const PrefabDesc& t_desc );
+
+    /**
+     * @brief Destructor for Prefab. Instances keep the mesh alive.
+     */
+    ~Prefab();
+
+    /**
+     * @brief Creates an instance of the prefab.
+     * @param world World to create it in.
+     * @param position Position of the instance.
+     * @return Pointer to the created Entity.
+     */
+    Entity* instantiate( World& world, const vector3& position ) const;
+
+    /**
+     * @brief Creates an instance of the prefab at each position, reserving
+     * room for them all first.
+     * @param world World to create them in.
+     * @param positions Position of each instance.
+     * @return Pointers to the created entities, in the order of positions.
+     */
+    std::vector< Entity* >
+    instantiate( World& world, const std::vector< vector3 >& positions ) const;
+
+    /**
+     * @brief Gets the name of the prefab.
+     * @return Name given to instances.
+     */
+    const std::string& getName() const;
+
+    /**
+     * @brief Gets what the prefab was built from.
+     * @return Description of the prefab.
+     */
+    const PrefabDesc& getDesc() const;
+
+    /**
+     * @brief Gets the number of models still drawing the prefab's mesh.
+     * Instances that overrode it aren't counted.
+     * @return Number of sharing instances.
+     */
+    size_t getInstanceCount() const;
+
+private:
+    PrefabDesc m_desc;              //!< What the prefab was built from.
+    Transform m_transform;          //!< Copied into every instance.
+    std::shared_ptr< Mesh > m_mesh; //!< Shared by every instance's Model.
+};
+
+} // namespace SquirrelEngine
+
+#endif
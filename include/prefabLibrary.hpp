@@ -0,0 +1,73 @@
+/**
+ *
+ * @file prefabLibrary.hpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief Declares the PrefabLibrary class, which owns every Prefab by name in
+ * SquirrelEngine.
+ * @date 2025-06-06
+ *
+ */
+
+#ifndef PREFABLIBRARY_HPP
+#define PREFABLIBRARY_HPP
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "prefab.hpp"
+#include "system.hpp"
+
+namespace SquirrelEngine {
+
+/**
+ * @brief Owns every Prefab by name. Prefabs are never changed once created,
+ * so pointers to them stay valid until shutdown.
+ */
+class PrefabLibrary : public System {
+public:
+    /**
+     * @brief Default constructor for PrefabLibrary.
+     */
+    PrefabLibrary();
+
+    /**
+     * @brief Destructor for PrefabLibrary.
+     */
+    ~PrefabLibrary();
+
+    /**
+     * @brief Drops every prefab. Instances keep the meshes they draw.
+     */
+    void shutdown() override;
+
+    /**
+     * @brief Creates a prefab, loading its assets.
+     * @param desc What to build the prefab from.
+     * @return Pointer to the prefab. If the name is taken the existing prefab
+     * is returned unchanged.
+     */
+    const Prefab* create( const PrefabDesc& desc );
+
+    /**
+     * @brief Finds a prefab by name.
+     * @param name Name the prefab was created with.
+     * @return Pointer to the prefab, or nullptr if there is none.
+     */
+    const Prefab* find( const std::string& name ) const;
+
+    /**
+     * @brief Gets the number of prefabs.
+     * @return Number of prefabs created.
+     */
+    size_t getPrefabCount() const;
+
+private:
+    std::unordered_map< std::string, std::unique_ptr< Prefab > >
+        m_prefabs; //!< Prefabs by name.
+};
+
+} // namespace SquirrelEngine
+
+#endif
@@ -0,0 +1,147 @@
+/**
+ *
+ * @file renderPipeline.hpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief Declares the RenderPipeline class, which hands render snapshots from
+ * the simulation thread to the render thread in SquirrelEngine.
+ * @date 2025-06-06
+ *
+ */
+
+#ifndef RENDERPIPELINE_HPP
+#define RENDERPIPELINE_HPP
+#pragma once
+
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+#include "objectRenderer.hpp"
+
+namespace SquirrelEngine {
+
+/**
+ * @brief Triple buffered hand-off of RenderSnapshots between the simulation
+ * thread, which writes frame N+1, and the render thread, which submits frame
+ * N.
+ *
+ * A snapshot is never touched by the simulation once published and never
+ * reused until the render thread is done with it, so neither side copies or
+ * locks while working on one. Latency is bounded by how many published frames
+ * may wait for the render thread; with frame dropping on, a newer frame
+ * replaces one that hasn't started rendering instead of waiting behind it.
+ */
+class RenderPipeline {
+public:
+    static constexpr int SnapshotCount = 3; //!< Snapshots in the ring.
+
+    /**
+     * @brief Default constructor for RenderPipeline.
+     */
+    RenderPipeline();
+
+    /**
+     * @brief Sets how many published frames may wait for the render thread.
+     * @param frames 1 for the lowest latency, 2 for the most overlap.
+     */
+    void setMaxFramesAhead( const int frames );
+
+    /**
+     * @brief Gets how many published frames may wait for the render thread.
+     * @return Frames the simulation may run ahead.
+     */
+    int getMaxFramesAhead() const;
+
+    /**
+     * @brief Sets whether a newly published frame replaces frames that are
+     * still waiting instead of queueing behind them. The simulation never
+     * waits on the render thread then, at the cost of dropped frames, and the
+     * max frames ahead is ignored.
+     * @param enabled Whether to drop late frames.
+     */
+    void setDropLateFrames( const bool enabled );
+
+    /**
+     * @brief Waits for a free snapshot for the simulation to write into.
+     * @return Snapshot to fill, cleared of the previous frame's draws.
+     */
+    RenderSnapshot& beginWrite();
+
+    /**
+     * @brief Publishes the snapshot returned by beginWrite.
+     */
+    void endWrite();
+
+    /**
+     * @brief Waits for the oldest published snapshot.
+     * @return Snapshot to render, or nullptr once the pipeline is stopped.
+     */
+    const RenderSnapshot* beginRead();
+
+    /**
+     * @brief Returns the snapshot from beginRead to the simulation.
+     */
+    void endRead();
+
+    /**
+     * @brief Waits until every published snapshot has been rendered. Call
+     * before changing anything the render thread reads through a snapshot,
+     * like removing entities.
+     */
+    void waitIdle();
+
+    /**
+     * @brief Wakes the render thread and makes beginRead return nullptr. Call
+     * from the simulation thread.
+     */
+    void stop();
+
+    /**
+     * @brief Gets the number of frames replaced before they were rendered.
+     * @return Dropped frame count.
+     */
+    uint64_t getDroppedFrames() const;
+
+private:
+    /**
+     * @brief Use of a snapshot.
+     */
+    enum SnapshotState : unsigned {
+        SS_Free = 0, //!< Can be written.
+        SS_Writing,  //!< Being filled by the simulation.
+        SS_Ready,    //!< Published, waiting for the render thread.
+        SS_Reading   //!< Being rendered.
+    };
+
+    /**
+     * @brief Finds a snapshot in a given state.
+     * @param state State to look for.
+     * @return Index of the snapshot, or -1 if none.
+     */
+    int find( const SnapshotState state ) const;
+
+    std::array< RenderSnapshot, SnapshotCount >
+        m_snapshots; //!< Snapshot ring.
+    std::array< SnapshotState, SnapshotCount > m_states = {
+        SS_Free, SS_Free, SS_Free }; //!< State of each snapshot.
+    std::array< int, SnapshotCount > m_readyOrder = {
+        0 }; //!< Published snapshots, oldest first.
+
+    mutable std::mutex m_mutex;      //!< Guards states and the ready order.
+    std::condition_variable m_freed; //!< Signalled when the reader is done.
+    std::condition_variable m_ready; //!< Signalled when a frame is published.
+
+    int m_readyCount = 0;          //!< Published snapshots waiting.
+    int m_writing = -1;            //!< Snapshot being written, or -1.
+    int m_reading = -1;            //!< Snapshot being rendered, or -1.
+    int m_maxFramesAhead = 1;      //!< Published frames allowed to wait.
+    bool m_dropLateFrames = false; //!< Replace waiting frames when publishing.
+    bool m_isStopped = false;      //!< Set by stop.
+    uint64_t m_nextFrame = 0;      //!< Frame number of the next write.
+    uint64_t m_droppedFrames = 0;  //!< Frames replaced before rendering.
+};
+
+} // namespace SquirrelEngine
+
+#endif
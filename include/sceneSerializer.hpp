@@ -0,0 +1,195 @@
+/**
+ *
+ * @file sceneSerializer.hpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief Declares the SceneSerializer class, which saves and loads the
+ * entities of a World as diffable text or packed binary in SquirrelEngine.
+ * @date 2025-06-06
+ *
+ */
+
+#ifndef SCENESERIALIZER_HPP
+#define SCENESERIALIZER_HPP
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "math_types.hpp"
+#include "world.hpp"
+
+namespace SquirrelEngine {
+
+//! String table offset of a field that isn't set
+constexpr uint32_t NoString = UINT32_MAX;
+
+/**
+ * @brief An entity and its transform as stored in a binary scene.
+ */
+struct EntityRecord {
+    uint32_t name;     //!< Offset of the name in the string table.
+    uint32_t id;       //!< Id given to createEntity.
+    vector3 position;  //!< Position of the transform.
+    float rotation[4]; //!< Rotation of the transform, w i j k.
+    vector3 scale;     //!< Scale of the transform.
+    uint32_t tags;     //!< EntityTags bits.
+};
+
+/**
+ * @brief A Model component as stored in a binary scene.
+ */
+struct ModelRecord {
+    uint32_t entity;     //!< Index of the owning EntityRecord.
+    uint32_t mesh;       //!< Offset of the model file name.
+    uint32_t vertShader; //!< Offset of the vertex shader file name.
+    uint32_t fragShader; //!< Offset of the fragment shader file name.
+};
+
+/**
+ * @brief A CameraComponent as stored in a binary scene.
+ */
+struct CameraRecord {
+    uint32_t entity;   //!< Index of the owning EntityRecord.
+    float fov;         //!< Field of view in degrees.
+    float fnear;       //!< Near clipping plane.
+    float ffar;        //!< Far clipping plane.
+    float aspect;      //!< Aspect ratio.
+    float sensitivity; //!< Look sensitivity.
+    vector3 offset;    //!< Position relative to the entity.
+    vector3 rotation;  //!< Pitch, yaw and roll.
+    uint32_t primary;  //!< Whether it is the primary camera.
+};
+
+static_assert( std::is_trivially_copyable_v< EntityRecord > &&
+                   std::is_trivially_copyable_v< ModelRecord > &&
+                   std::is_trivially_copyable_v< CameraRecord >,
+               "Records are read straight from disk" );
+
+/**
+ * @brief Every entity and component of a scene as flat arrays, one per record
+ * type, the same layout the binary form has on disk.
+ */
+struct SceneData {
+    std::vector< char > strings;          //!< Null terminated names.
+    std::vector< EntityRecord > entities; //!< Entities in creation order.
+    std::vector< ModelRecord > models;    //!< Models of the entities.
+    std::vector< CameraRecord > cameras;  //!< Cameras of the entities.
+
+    /**
+     * @brief Appends a string to the string table.
+     * @param text String to add.
+     * @return Offset of the string.
+     */
+    uint32_t addString( const std::string& text );
+
+    /**
+     * @brief Gets a string from the string table.
+     * @param offset Offset from addString.
+     * @return The string, empty for NoString or a bad offset.
+     */
+    const char* getString( const uint32_t offset ) const;
+
+    /**
+     * @brief Empties every array.
+     */
+    void clear();
+};
+
+/**
+ * @brief Saves and loads the entities of a World.
+ *
+ * The text form is a DataRecord per entity and component, for diffing and
+ * hand editing. The binary form is a 16 byte header, then one section per
+ * record type: a 16 byte section header and the records exactly as they sit
+ * in a SceneData, so loading is one read per array with no parsing. Binary
+ * scenes are native endian and only load on builds with the same record
+ * layout, which the section headers check.
+ */
+class SceneSerializer {
+public:
+    /**
+     * @brief Copies the entities of a world into flat arrays.
+     * @param world World to capture.
+     * @param scene Cleared, then filled with the world.
+     */
+    static void capture( World& world, SceneData& scene );
+
+    /**
+     * @brief Creates the entities and components of a scene in a world.
+     * @param scene Scene to create.
+     * @param world World to create them in.
+     */
+    static void instantiate( const SceneData& scene, World& world );
+
+    /**
+     * @brief Writes a scene in the binary form.
+     * @param scene Scene to write.
+     * @param filename File to create.
+     * @return true if the file was written.
+     */
+    static bool writeBinary( const SceneData& scene,
+                             const std::string& filename );
+
+    /**
+     * @brief Reads a scene in the binary form. Touches nothing but the
+     * scene, so it is safe on loader threads.
+     * @param filename File to read.
+     * @param scene Filled with the file's records.
+     * @return true if the file is a binary scene with this build's layout.
+     */
+    static bool readBinary( const std::string& filename, SceneData& scene );
+
+    /**
+     * @brief Writes the entities of a world in the text form.
+     * @param world World to save.
+     * @param filename File to create.
+     * @return true if the file was written.
+     */
+    static bool saveText( World& world, const std::string& filename );
+
+    /**
+     * @brief Creates the entities of a text scene in a world.
+     * @param filename File to read.
+     * @param world World to create them in.
+     * @return true if the file was read.
+     */
+    static bool loadText( const std::string& filename, World& world );
+
+    /**
+     * @brief Writes the entities of a world in the binary form.
+     * @param world World to save.
+     * @param filename File to create.
+     * @return true if the file was written.
+     */
+    static bool saveBinary( World& world, const std::string& filename );
+
+    /**
+     * @brief Creates the entities of a binary scene in a world.
+     * @param filename File to read.
+     * @param world World to create them in.
+     * @return true if the file was read.
+     */
+    static bool loadBinary( const std::string& filename, World& world );
+
+    /**
+     * @brief Creates the entities of a scene in either form, told apart by
+     * the binary header.
+     * @param filename File to read.
+     * @param world World to create them in.
+     * @return true if the file was read.
+     */
+    static bool load( const std::string& filename, World& world );
+
+    /**
+     * @brief Checks if a file starts with the binary header.
+     * @param filename File to check.
+     * @return true if the file is a binary scene.
+     */
+    static bool isBinary( const std::string& filename );
+};
+
+} // namespace SquirrelEngine
+
+#endif
@@ -12,10 +12,20 @@
 #define SHADER_HPP
 #pragma once
 
+#include <string>
+
 #include <glad/glad.h>
 
 #include "object.hpp"
 
+// Tokens from GL_KHR_parallel_shader_compile, in case the loader lacks them
+#ifndef GL_MAX_SHADER_COMPILER_THREADS_KHR
+#define GL_MAX_SHADER_COMPILER_THREADS_KHR 0x91B0
+#endif
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
 namespace SquirrelEngine {
 
 /**
@@ -69,6 +79,22 @@ public:
      */
     Shader( const std::string& filename );
 
+    /**
+     * @brief Constructs a Shader from a file, optionally without waiting for
+     * the driver to finish compiling it.
+     * @param filename Path to the shader file.
+     * @param waitForCompile Whether to query the compile status immediately.
+     */
+    Shader( const std::string& filename, const bool waitForCompile );
+
+    /**
+     * @brief Constructs a Shader from source held in memory.
+     * @param t_type Shader type (e.g., GL_VERTEX_SHADER).
+     * @param source GLSL source code.
+     * @param name Name used when reporting compile errors.
+     */
+    Shader( const GLenum t_type, const char* source, const std::string& name );
+
     /**
      * @brief Destructor for Shader.
      */
@@ -86,6 +112,13 @@ public:
      */
     GLuint getHandle() const;
 
+    /**
+     * @brief Gives up ownership of the OpenGL handle, so the destructor no
+     * longer deletes it.
+     * @return Shader handle as GLuint.
+     */
+    GLuint release();
+
 private:
     /**
      * @brief Determines the shader type from the filename extension.
@@ -103,6 +136,15 @@ protected:
  */
 class Program : public ShaderBase {
 public:
+    /**
+     * @brief Link state of a program.
+     */
+    enum ProgramStatus : unsigned {
+        PS_Pending = 0, //!< Compile/link submitted, result not known yet.
+        PS_Ready = 1,   //!< Linked successfully and usable for drawing.
+        PS_Failed = 2   //!< Compile or link failed.
+    };
+
     /**
      * @brief Copy constructor for Program.
      * @param other Program to copy from.
@@ -129,6 +171,16 @@ public:
      */
     Program( const std::string& firstFile, const std::string& secondFile );
 
+    /**
+     * @brief Constructs a Program from two shader files, optionally leaving
+     * the compile and link running in the driver.
+     * @param firstFile Vertex shader file.
+     * @param secondFile Fragment shader file.
+     * @param waitForLink Whether to query the link status immediately.
+     */
+    Program( const std::string& firstFile, const std::string& secondFile,
+             const bool waitForLink );
+
     /**
      * @brief Destructor for Program.
      */
@@ -139,6 +191,63 @@ public:
      * @return Program handle as GLuint.
      */
     GLuint getHandle() const;
+
+    /**
+     * @brief Resolves a pending link once the driver has finished it.
+     * @param canQueryCompletion Whether GL_COMPLETION_STATUS_KHR is available.
+     * Without it the link status is queried directly, which may block.
+     * @return true if the program is no longer pending.
+     */
+    bool pollStatus( const bool canQueryCompletion );
+
+    /**
+     * @brief Gets the link state of the program.
+     * @return Current ProgramStatus.
+     */
+    ProgramStatus getStatus() const;
+
+    /**
+     * @brief Checks if the program linked and can be used for drawing.
+     * @return true if the program is ready.
+     */
+    bool isReady() const;
+
+    /**
+     * @brief Exchanges the OpenGL program and link state with another
+     * program, so users holding a pointer pick up a rebuilt program.
+     * @param other Program to swap with.
+     */
+    void swap( Program& other );
+
+    /**
+     * @brief Gets the vertex shader file the program was built from.
+     * @return File name, empty if not built from files.
+     */
+    const std::string& getFirstFile() const;
+
+    /**
+     * @brief Gets the fragment shader file the program was built from.
+     * @return File name, empty if not built from files.
+     */
+    const std::string& getSecondFile() const;
+
+private:
+    /**
+     * @brief Queries the link status and reports errors to Trace.
+     */
+    void checkLinkStatus();
+
+    /**
+     * @brief Detaches and deletes the shaders kept for a pending link.
+     * @param reportErrors Whether to report shaders that failed to compile.
+     */
+    void releaseShaders( const bool reportErrors );
+
+protected:
+    ProgramStatus m_status = PS_Pending; //!< Link state of the program.
+    std::string m_firstFile;  //!< Vertex shader file.
+    std::string m_secondFile; //!< Fragment shader file.
+    GLuint m_shaders[2] = { 0, 0 }; //!< Shaders kept until the link resolves.
 };
 
 } // namespace SquirrelEngine
@@ -0,0 +1,160 @@
+/**
+ *
+ * @file shaderCompiler.hpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief Declares the ShaderCompiler class, which batches shader program
+ * builds so the driver can compile them in parallel in SquirrelEngine.
+ * @date 2025-06-06
+ *
+ */
+
+#ifndef SHADERCOMPILER_HPP
+#define SHADERCOMPILER_HPP
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "system.hpp"
+
+namespace SquirrelEngine {
+class FileWatcher;
+class Program;
+
+/**
+ * @brief Owns every shader Program and builds them without blocking.
+ *
+ * Builds are submitted to the driver up front and resolved in update() once
+ * GL_COMPLETION_STATUS_KHR reports them as done. Until then meshes draw with
+ * a fallback program that is compiled synchronously on startup. With hot
+ * reload enabled, changed shader files are rebuilt the same way and swapped
+ * in once they link; failed rebuilds keep the old program.
+ */
+class ShaderCompiler : public System {
+public:
+    /**
+     * @brief Default constructor for ShaderCompiler.
+     */
+    ShaderCompiler();
+
+    /**
+     * @brief Destructor for ShaderCompiler.
+     */
+    ~ShaderCompiler();
+
+    /**
+     * @brief Enables parallel compilation and builds the fallback program.
+     * @param t_owner Pointer to the Engine that owns this system.
+     * @return StartupErrors indicating success or failure.
+     */
+    StartupErrors initialize( Engine* t_owner ) override;
+
+    /**
+     * @brief Resolves any builds the driver has finished, unless the render
+     * thread does it.
+     * @param delta Time elapsed since last update.
+     */
+    void update( const float ) override;
+
+    /**
+     * @brief Stops watching files and deletes every program. Meshes must not
+     * draw with programs from the compiler afterwards.
+     */
+    void shutdown() override;
+
+    /**
+     * @brief Resolves any builds the driver has finished and submits hot
+     * reloads. Must run on the thread that owns the OpenGL context.
+     */
+    void resolve();
+
+    /**
+     * @brief Hands resolving over to the render thread, which calls resolve()
+     * itself, so update() stops touching OpenGL.
+     * @param enabled Whether the render thread resolves builds.
+     */
+    void setResolveOnRenderThread( const bool enabled );
+
+    /**
+     * @brief Submits a program build, or returns the existing program if the
+     * same pair of files was already requested.
+     * @param vertName Vertex shader file name.
+     * @param fragName Fragment shader file name.
+     * @return Pointer to the program, which may still be pending.
+     */
+    Program* requestProgram( const std::string& vertName,
+                             const std::string& fragName );
+
+    /**
+     * @brief Blocks until every submitted build has finished.
+     */
+    void waitForAll();
+
+    /**
+     * @brief Gets the program to draw with while another one is not ready.
+     * @return Pointer to the fallback program.
+     */
+    Program* getFallbackProgram() const;
+
+    /**
+     * @brief Gets the number of builds still running in the driver.
+     * @return Number of pending programs.
+     */
+    size_t getPendingCount() const;
+
+    /**
+     * @brief Checks if the driver reports completion without blocking.
+     * @return true if GL_KHR/ARB_parallel_shader_compile is supported.
+     */
+    bool isParallelSupported() const;
+
+    /**
+     * @brief Enables or disables rebuilding programs when their files change.
+     * @param enabled Whether to watch shader files.
+     */
+    void setHotReload( const bool enabled );
+
+    /**
+     * @brief Checks if shader files are being watched.
+     * @return true if hot reload is enabled.
+     */
+    bool isHotReloadEnabled() const;
+
+private:
+    /**
+     * @brief Rebuild of a program whose files changed.
+     */
+    struct Reload {
+        Program* target;                  //!< Program to swap the rebuild into.
+        std::unique_ptr< Program > build; //!< Rebuild in progress.
+    };
+
+    /**
+     * @brief Submits rebuilds for programs using any changed file.
+     */
+    void submitReloads();
+
+    /**
+     * @brief Swaps in finished rebuilds.
+     */
+    void resolveReloads();
+
+    std::vector< std::unique_ptr< Program > >
+        m_programs; //!< Every program built through the compiler.
+    std::vector< Program* > m_pending; //!< Programs still being built.
+    std::unique_ptr< Program >
+        m_fallback; //!< Program used while others are pending or failed.
+
+    std::unique_ptr< FileWatcher >
+        m_watcher; //!< Watches shader files, null if hot reload is off.
+    std::vector< Reload > m_reloads;           //!< Rebuilds in progress.
+    std::vector< std::string > m_changedFiles; //!< Reused poll results.
+
+    bool m_parallelSupported = false;      //!< Whether completion is polled.
+    bool m_isRenderThreadResolved = false; //!< Whether update() skips work.
+};
+
+} // namespace SquirrelEngine
+
+#endif
@@ -0,0 +1,43 @@
+/**
+ *
+ * @file eventSystemTests.hpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief
+ * @date 2025-06-07
+ *
+ */
+
+#ifndef EVENTSYSTEMTESTS_HPP
+#define EVENTSYSTEMTESTS_HPP
+#pragma once
+
+namespace SquirrelEngine {
+
+namespace EventTests {
+
+void init();
+void end();
+
+void subscribe();
+void unsubscribe();
+void churn();
+
+void publishSingleType();
+void publishManyTypes();
+
+void enqueue();
+void flushBatched();
+
+void channelStress();
+void channelBounded();
+void channelProducers();
+
+void dispatchRaw();
+void dispatchMember();
+void dispatchBoundMember();
+void dispatchConstMember();
+}; // namespace EventTests
+
+} // namespace SquirrelEngine
+
+#endif
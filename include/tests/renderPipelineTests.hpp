@@ -0,0 +1,28 @@
+/**
+ *
+ * @file renderPipelineTests.hpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief
+ * @date 2025-06-07
+ *
+ */
+
+#ifndef RENDERPIPELINETESTS_HPP
+#define RENDERPIPELINETESTS_HPP
+#pragma once
+
+namespace SquirrelEngine {
+
+namespace RenderPipelineTests {
+
+void init();
+void end();
+
+void serial();
+void pipelined();
+void pipelinedDropLate();
+}; // namespace RenderPipelineTests
+
+} // namespace SquirrelEngine
+
+#endif
@@ -0,0 +1,30 @@
+/**
+ *
+ * @file sceneSerializerTests.hpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief
+ * @date 2025-06-07
+ *
+ */
+
+#ifndef SCENESERIALIZERTESTS_HPP
+#define SCENESERIALIZERTESTS_HPP
+#pragma once
+
+namespace SquirrelEngine {
+
+namespace SceneSerializerTests {
+
+void init();
+void end();
+
+void saveText();
+void saveBinary();
+void loadText();
+void loadBinary();
+void readBinary();
+}; // namespace SceneSerializerTests
+
+} // namespace SquirrelEngine
+
+#endif
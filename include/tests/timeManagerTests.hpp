@@ -0,0 +1,26 @@
+/**
+ *
+ * @file timeManagerTests.hpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief
+ * @date 2025-06-07
+ *
+ */
+
+#ifndef TIMEMANAGERTESTS_HPP
+#define TIMEMANAGERTESTS_HPP
+#pragma once
+
+namespace SquirrelEngine {
+
+namespace TimeManagerTests {
+
+void init();
+void end();
+
+void soak();
+}; // namespace TimeManagerTests
+
+} // namespace SquirrelEngine
+
+#endif
@@ -0,0 +1,29 @@
+/**
+ *
+ * @file worldTests.hpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief
+ * @date 2025-06-07
+ *
+ */
+
+#ifndef WORLDTESTS_HPP
+#define WORLDTESTS_HPP
+#pragma once
+
+namespace SquirrelEngine {
+
+namespace WorldTests {
+
+void init();
+void end();
+
+void findByName();
+void findMissing();
+void queryTag();
+void removeTagged();
+}; // namespace WorldTests
+
+} // namespace SquirrelEngine
+
+#endif
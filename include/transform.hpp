@@ -130,11 +130,34 @@ public:
      */
     const matrix4& matrix();
 
+    /**
+     * @brief Copies the current state into the previous snapshot. Called
+     * before every fixed step so rendering can interpolate across it.
+     */
+    void storePrevious();
+
+    /**
+     * @brief Makes the previous snapshot match the current state, so the next
+     * frame doesn't interpolate across a teleport.
+     */
+    void resetInterpolation();
+
+    /**
+     * @brief Gets the transformation matrix between the previous snapshot and
+     * the current state.
+     * @param alpha Blend factor, 0 previous to 1 current.
+     * @return The interpolated transformation matrix.
+     */
+    const matrix4 interpolatedMatrix( const float alpha );
+
 private:
     matrix4 m_matrix;           //!< Cached transformation matrix.
     DualQuaternion m_transform; //!< dual quaternion for position and rotation
+    DualQuaternion m_previous;  //!< m_transform at the last fixed step
     vector3 m_scale;            //!< Scale vector.
+    vector3 m_previousScale;    //!< m_scale at the last fixed step
     bool m_isDirty;             //!< Dirty flag for matrix recalculation.
+    bool m_hasMoved;            //!< Changed since the last fixed step.
 };
 
 } // namespace SquirrelEngine
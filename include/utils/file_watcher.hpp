@@ -0,0 +1,96 @@
+/**
+ *
+ * @file file_watcher.hpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief Declares the FileWatcher class, which reports changes to files on
+ * disk for SquirrelEngine.
+ * @date 2025-06-06
+ *
+ */
+
+#ifndef FILE_WATCHER_HPP
+#define FILE_WATCHER_HPP
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace SquirrelEngine {
+
+/**
+ * @brief Watches files for modification. Uses inotify on Linux and change
+ * notifications on Windows, so polling with no changes is a single
+ * non-blocking check.
+ *
+ */
+class FileWatcher {
+public:
+    /**
+     * @brief Opens the notification handle
+     *
+     */
+    FileWatcher();
+
+    /**
+     * @brief Closes all notification handles
+     *
+     */
+    ~FileWatcher();
+
+    FileWatcher( const FileWatcher& ) = delete;
+    FileWatcher& operator=( const FileWatcher& ) = delete;
+
+    /**
+     * @brief Starts watching a file. Its directory is watched so that editors
+     * which save by replacing the file are still seen.
+     *
+     * @param filename File to watch
+     * @return true File is being watched
+     * @return false Watch could not be added
+     */
+    bool watch( const std::string& filename );
+
+    /**
+     * @brief Collects files that changed since the last poll
+     *
+     * @param changedFiles Cleared, then filled with changed file names
+     * @return true At least one watched file changed
+     * @return false Nothing changed
+     */
+    bool poll( std::vector< std::string >& changedFiles );
+
+private:
+    /**
+     * @brief Watched file inside a directory
+     *
+     */
+    struct WatchedFile {
+        std::string filename; //!< Name as given to watch()
+        std::filesystem::file_time_type lastWrite; //!< Last seen write time
+    };
+
+    /**
+     * @brief Watched directory and the watched files inside it
+     *
+     */
+    struct WatchedDirectory {
+        std::filesystem::path path; //!< Directory being watched
+        std::unordered_map< std::string, WatchedFile >
+            files; //!< Leaf name to watched file
+    };
+
+    std::unordered_map< std::string, intptr_t >
+        m_watchKeys; //!< Directory path to its watch descriptor/handle
+
+    std::unordered_map< intptr_t, WatchedDirectory >
+        m_directories; //!< Watch descriptor/handle to directory
+
+    int m_fd = -1; //!< inotify instance (Linux only)
+};
+
+} // namespace SquirrelEngine
+
+#endif
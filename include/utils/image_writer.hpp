@@ -0,0 +1,33 @@
+/**
+ *
+ * @file image_writer.hpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief Declares utilities for writing images to disk in SquirrelEngine.
+ * @date 2025-06-06
+ *
+ */
+
+#ifndef IMAGE_WRITER_HPP
+#define IMAGE_WRITER_HPP
+#pragma once
+
+#include <string>
+
+namespace SquirrelEngine {
+
+/**
+ * @brief Writes an 8-bit RGBA image as an uncompressed PNG
+ *
+ * @param filename Output file
+ * @param width Image width in pixels
+ * @param height Image height in pixels
+ * @param rgba Pixel data, top row first
+ * @return true File was written
+ * @return false File couldn't be opened
+ */
+bool writePNG( const std::string& filename, const int width, const int height,
+               const unsigned char* rgba );
+
+} // namespace SquirrelEngine
+
+#endif
@@ -0,0 +1,97 @@
+/**
+ *
+ * @file resource_tracker.hpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief Declares the ResourceTracker class, which counts live OpenGL objects
+ * so leaks can be reported on shutdown in SquirrelEngine.
+ * @date 2025-06-06
+ *
+ */
+
+#ifndef RESOURCE_TRACKER_HPP
+#define RESOURCE_TRACKER_HPP
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace SquirrelEngine {
+
+/**
+ * @brief Kinds of OpenGL objects the engine creates
+ *
+ */
+enum GpuResource : unsigned {
+    GR_Buffer = 0,
+    GR_VertexArray,
+    GR_Shader,
+    GR_Program,
+    GR_Query,
+    GR_Framebuffer,
+    GR_Renderbuffer,
+    GR_Count
+};
+
+/*! ResourceTracker class */
+class ResourceTracker {
+public:
+    /**
+     * @brief Counts OpenGL objects that were just generated
+     *
+     * @param type Kind of object
+     * @param count Number of objects
+     */
+    static void created( const GpuResource type, const int count = 1 );
+
+    /**
+     * @brief Counts OpenGL objects that were just deleted
+     *
+     * @param type Kind of object
+     * @param count Number of objects
+     */
+    static void released( const GpuResource type, const int count = 1 );
+
+    /**
+     * @brief Get the number of objects created and not yet released
+     *
+     * @param type Kind of object
+     * @return int
+     */
+    static int getLiveCount( const GpuResource type );
+
+    /**
+     * @brief Get the number of objects created since startup
+     *
+     * @param type Kind of object
+     * @return uint64_t
+     */
+    static uint64_t getCreatedCount( const GpuResource type );
+
+    /**
+     * @brief Get the name of a kind of object, for reports
+     *
+     * @param type Kind of object
+     * @return const char*
+     */
+    static const char* getName( const GpuResource type );
+
+    /**
+     * @brief Traces every kind of object still alive. Called once everything
+     * that owns OpenGL objects has been shut down.
+     *
+     * @return true Nothing leaked
+     * @return false Some objects are still alive
+     */
+    static bool report();
+
+private:
+    static std::array< std::atomic< int >, GR_Count >
+        s_live; //!< Objects alive per kind
+    static std::array< std::atomic< uint64_t >, GR_Count >
+        s_created; //!< Objects created per kind
+};
+
+} // namespace SquirrelEngine
+
+#endif
@@ -12,7 +12,9 @@
 #define TIME_MANAGER_HPP
 #pragma once
 
+#include <array>
 #include <chrono>
+#include <cstdint>
 
 #include "system.hpp"
 
@@ -25,6 +27,20 @@ namespace SquirrelEngine {
  */
 class TimeManager : public System {
 public:
+    /**
+     * @brief Frame time percentiles over the recent frame history
+     *
+     */
+    struct FrameTimeStats {
+        float p50 = 0.f;     //!< Median frame time in milliseconds
+        float p99 = 0.f;     //!< 99th percentile frame time in milliseconds
+        float max = 0.f;     //!< Longest frame time in milliseconds
+        int sampleCount = 0; //!< Frames the percentiles were taken over
+    };
+
+    //! Frames kept for the frame time percentiles
+    static constexpr int FrameHistorySize = 1024;
+
     /**
      * @brief Construct a new Time Manager object
      *
@@ -38,7 +54,8 @@ public:
     void increment();
 
     /**
-     * @brief Check if fixed time interval has been passed
+     * @brief Check if fixed time interval has been passed. Stops after the
+     * max fixed steps of a frame and drops the rest of the backlog.
      *
      * @return true
      * @return false
@@ -58,6 +75,60 @@ public:
      */
     const float getFixedDt() const;
 
+    /**
+     * @brief Set the fixed delta time interval
+     *
+     * @param fixedDt Interval in seconds, must be above 0. Rounded to the
+     * nearest nanosecond.
+     */
+    void setFixedDt( const float fixedDt );
+
+    /**
+     * @brief Set how many fixed steps may run in one frame before the
+     * remaining time is dropped, so one long frame can't make every following
+     * frame longer
+     *
+     * @param maxSteps Fixed steps per frame, at least 1
+     */
+    void setMaxFixedSteps( const int maxSteps );
+
+    /**
+     * @brief Return how far the simulation is into the next fixed step, used
+     * to interpolate between the previous and current fixed step
+     *
+     * @return const float 0 to 1
+     */
+    const float getAlpha() const;
+
+    /**
+     * @brief Return the number of fixed steps dropped by the max fixed steps
+     * clamp
+     *
+     * @return const uint64_t
+     */
+    const uint64_t getDroppedFixedSteps() const;
+
+    /**
+     * @brief Return the total simulated fixed time
+     *
+     * @return const double Seconds, under a microsecond off for decades
+     */
+    const double getTime() const;
+
+    /**
+     * @brief Return the total simulated fixed time in integer ticks
+     *
+     * @return const std::chrono::nanoseconds
+     */
+    const std::chrono::nanoseconds getTimeTicks() const;
+
+    /**
+     * @brief Return the number of fixed steps run since construction
+     *
+     * @return const uint64_t
+     */
+    const uint64_t getFixedStepCount() const;
+
     /**
      * @brief Return last non-fixed delta time
      *
@@ -65,6 +136,14 @@ public:
      */
     const float getDeltaTime() const;
 
+    /**
+     * @brief Steps by a constant frame time instead of the clock, so runs
+     * advance the same on every machine
+     *
+     * @param deltaTime Frame time in seconds, 0 to use the clock again
+     */
+    void setLockedDeltaTime( const float deltaTime );
+
     /**
      * @brief Sleeps main thread for given time in milliseconds
      *
@@ -72,15 +151,70 @@ public:
      */
     void sleep( const int milliseconds );
 
+    /**
+     * @brief Set the frame rate limitFrame paces to
+     *
+     * @param framesPerSecond Target rate, 0 for uncapped
+     */
+    void setTargetFrameRate( const float framesPerSecond );
+
+    /**
+     * @brief Return the frame rate limitFrame paces to
+     *
+     * @return const float Target rate, 0 when uncapped
+     */
+    const float getTargetFrameRate() const;
+
+    /**
+     * @brief Set how long before the frame deadline limitFrame stops sleeping
+     * and spins instead. Covers the scheduler oversleeping.
+     *
+     * @param spinTime Time to spin for at the end of each frame
+     */
+    void setSpinTime( const std::chrono::steady_clock::duration spinTime );
+
+    /**
+     * @brief Waits until the target frame time has passed since the last
+     * increment. Sleeps for the coarse part and spins for the rest. Returns
+     * immediately when uncapped or the frame is already late.
+     *
+     */
+    void limitFrame();
+
+    /**
+     * @brief Return percentiles of the measured frame times
+     *
+     * @return FrameTimeStats over the last FrameHistorySize frames
+     */
+    FrameTimeStats getFrameTimeStats() const;
+
 private:
     std::chrono::steady_clock::time_point m_lastTime; //!< last update time
     std::chrono::steady_clock::time_point m_currTime; //!< curr update time
-    std::chrono::steady_clock::duration m_timeTaken;  //!< time betwen
+    std::chrono::steady_clock::duration m_targetFrameTime{}; //!< 0 uncapped
+    std::chrono::steady_clock::duration m_spinTime =
+        std::chrono::milliseconds( 2 ); //!< spun instead of slept
+
+    // Kept in integer ticks so nothing drifts however long the engine runs
+    std::chrono::nanoseconds m_accumulator{};     //!< since last fixed update
+    std::chrono::nanoseconds m_time{};            //!< total fixed time
+    std::chrono::nanoseconds m_frameTime{};       //!< last time between updates
+    std::chrono::nanoseconds m_lockedFrameTime{}; //!< constant, 0 uses clock
+    std::chrono::nanoseconds m_fixedStep =
+        std::chrono::milliseconds( 20 ); //!< fixed interval time
+
+    float m_deltaTime = 0.f; //!< m_frameTime in seconds, set every frame
+    float m_fixedDt = 0.02f; //!< m_fixedStep in seconds
+
+    int m_maxFixedSteps = 5;          //!< fixed steps allowed per frame
+    int m_fixedSteps = 0;             //!< fixed steps run this frame
+    uint64_t m_fixedStepCount = 0;    //!< fixed steps run in total
+    uint64_t m_droppedFixedSteps = 0; //!< steps dropped by the clamp
 
-    float m_accumulator;           //!< accumulates time since last fixed update
-    float m_time;                  //!< total time running
-    float m_deltaTime;             //!< last time between updates
-    const float m_fixedDt = 0.02f; //!< fixed interval time
+    std::array< float, FrameHistorySize > m_frameTimes = {
+        0.f }; //!< measured frame times in milliseconds
+    int m_frameTimeCount = 0; //!< frames recorded, up to FrameHistorySize
+    int m_frameTimeNext = 0;  //!< next slot to overwrite
 };
 } // namespace SquirrelEngine
 
@@ -18,6 +18,7 @@
 // std includes //
 #include <string>
 #include <fstream>
+#include <mutex>
 #include <source_location>
 
 namespace SquirrelEngine {
@@ -36,6 +37,14 @@ public:
     message( std::string Message,
              std::source_location Src = std::source_location::current() );
 
+    /**
+     * @brief Opens the output file if it isn't open yet. Statics destroyed
+     * after the trace can't log, so singletons that log on exit call this
+     * while they are constructed
+     *
+     */
+    static void open();
+
     /**
      * @brief Close output file
      *
@@ -61,6 +70,7 @@ private:
 
 private:
     std::fstream TraceStream; //!< Output file
+    std::mutex TraceMutex;    //!< Serializes messages from worker threads
 };
 
 } // namespace SquirrelEngine
@@ -18,6 +18,19 @@ struct GLFWwindow;
 
 namespace SquirrelEngine {
 enum StartupErrors : unsigned;
+class InputSystem;
+class Keyboard;
+class Mouse;
+
+/**
+ * @brief Input devices fed by the window's GLFW callbacks. Stored as the GLFW
+ * window user pointer so callbacks reach their device without a lookup.
+ */
+struct WindowInput {
+    InputSystem* inputSystem = nullptr; //!< System the devices report to.
+    Keyboard* keyboard = nullptr;       //!< Receives key events.
+    Mouse* mouse = nullptr;             //!< Receives button and cursor events.
+};
 
 /**
  * @brief Manages the application window and its properties.
@@ -30,9 +43,10 @@ public:
     Window();
 
     /**
-     * @brief Virtual destructor for Window.
+     * @brief Virtual destructor for Window. Destroys the window if it is still
+     * open.
      */
-    ~Window() = default;
+    ~Window();
 
     /**
      * @brief Creates the window with the specified parameters.
@@ -40,10 +54,19 @@ public:
      * @param width The window width.
      * @param height The window height.
      * @param isFullscreen Whether the window should be fullscreen.
+     * @param isHeadless Whether to create a hidden window only used for its
+     * OpenGL context.
      * @return StartupErrors indicating success or failure.
      */
     StartupErrors create( const std::string title, const int width,
-                          const int height, bool isFullscreen );
+                          const int height, bool isFullscreen,
+                          bool isHeadless = false );
+
+    /**
+     * @brief Destroys the window and its OpenGL context and terminates GLFW.
+     * Every GL object must be deleted before this.
+     */
+    void destroy();
 
     /**
      * @brief Polls window events (input, close, etc.).
@@ -81,6 +104,19 @@ public:
      */
     GLFWwindow* getHandle();
 
+    /**
+     * @brief Gets the input devices the window's callbacks report to.
+     * @return Reference to the window's WindowInput.
+     */
+    WindowInput& getInput();
+
+    /**
+     * @brief Gets the input devices of a GLFW window from its user pointer.
+     * @param t_window Pointer to the GLFWwindow.
+     * @return Pointer to the WindowInput, nullptr if the window has none.
+     */
+    static WindowInput* getInput( GLFWwindow* t_window );
+
     /**
      * @brief GLFW callback for window close event.
      * @param t_window Pointer to the GLFWwindow.
@@ -89,6 +125,7 @@ public:
 
 protected:
     GLFWwindow* m_window; //!< Pointer to the GLFW window.
+    WindowInput m_input;  //!< Devices reached through the user pointer.
 };
 
 }; // namespace SquirrelEngine
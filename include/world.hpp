@@ -2,7 +2,7 @@
  *
  * @file world.hpp
  * @author Kelson Wysocki (kelson.wysocki@gmail.com)
- * @brief Declares the World class, which manages all entities and their
+ * @brief Declares the World class, which manages a set of entities and their
  * lifecycle in SquirrelEngine.
  * @date 2025-06-06
  *
@@ -12,7 +12,14 @@
 #define WORLD_HPP
 #pragma once
 
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <span>
+#include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -23,10 +30,77 @@ namespace SquirrelEngine {
 class Entity;
 
 /**
- * @brief Manages all entities and their lifecycle in the engine.
+ * @brief Tags an entity can be given. Games define their own from
+ * ET_FirstUser up to MaxEntityTags.
+ */
+enum EntityTag : unsigned {
+    ET_Static = 0,   //!< Never moves once placed.
+    ET_ShadowCaster, //!< Drawn into shadow maps.
+    ET_FirstUser     //!< First tag free for games.
+};
+
+//! Number of tags an entity can carry
+constexpr unsigned MaxEntityTags = 32;
+
+//! One bit per EntityTag
+using EntityTags = std::bitset< MaxEntityTags >;
+
+//! Interned name of entities, shared by every entity with that name
+using NameId = uint32_t;
+
+//! NameId of a name no entity in the world has had
+constexpr NameId NoName = UINT32_MAX;
+
+/**
+ * @brief Refers to a World owned by the WorldManager. Resolves to nullptr once
+ * the world is destroyed, even if its slot was reused.
+ */
+struct WorldHandle {
+    uint32_t index = UINT32_MAX; //!< Slot of the world in the WorldManager.
+    uint32_t generation = 0;     //!< Generation of the slot when handed out.
+
+    /**
+     * @brief Checks if the handle was ever given a world.
+     * @return true if the handle came from the WorldManager.
+     */
+    bool isValid() const { return index != UINT32_MAX; }
+};
+
+/**
+ * @brief Refers to an entity in any world. Resolves to nullptr once the entity
+ * is removed or its world unloads, so entities can reference each other
+ * across worlds without dangling.
+ */
+struct EntityHandle {
+    WorldHandle world;           //!< World the entity lives in.
+    uint32_t index = UINT32_MAX; //!< Slot of the entity in its world.
+    uint32_t generation = 0;     //!< Generation of the slot when handed out.
+
+    /**
+     * @brief Checks if the handle was ever given an entity.
+     * @return true if the handle came from World::getHandle.
+     */
+    bool isValid() const { return index != UINT32_MAX; }
+};
+
+/**
+ * @brief Manages a set of entities and their lifecycle. Each world can be
+ * simulated, rendered and unloaded independently of the others.
+ *
+ * Names are interned and indexed like a multi-map, so any number of entities
+ * can share a name and lookups never throw. Unnamed entities aren't indexed.
+ * The entities of each name and each tag are kept as a packed array, which
+ * queries return as spans. Spans stay valid until the next entity is
+ * created, removed, renamed or tagged in this world.
  */
 class World : public Object {
 public:
+    /**
+     * @brief Constructor for World.
+     * @param t_name Name of the world, used in reports.
+     */
+    World( const std::string& t_name = "" );
+
     /**
      * @brief Destructor for World.
      */
@@ -38,7 +112,15 @@ public:
      * @param id Optional unique ID for the entity.
      * @return Pointer to the created Entity.
      */
-    Entity* createEntity( const std::string name = "", const uint32_t id = 0 );
+    Entity* createEntity( const std::string& name = "",
+                          const uint32_t id = 0 );
+
+    /**
+     * @brief Reserves room for entities about to be created, so a bulk load
+     * doesn't regrow the lists as it goes.
+     * @param count Number of entities the world will hold.
+     */
+    void reserve( const size_t count );
 
     /**
      * @brief Finds an entity by its unique ID.
@@ -50,9 +132,99 @@ public:
     /**
      * @brief Finds an entity by its name.
      * @param name The entity's name.
-     * @return Pointer to the found Entity, or nullptr if not found.
+     * @return Pointer to an Entity with the name, or nullptr if none has
+     * it.
      */
-    Entity* findEntity( const std::string name );
+    Entity* findEntity( std::string_view name );
+
+    /**
+     * @brief Finds every entity with a name.
+     * @param name The entities' name.
+     * @return The entities in no particular order, empty if none has the
+     * name.
+     */
+    std::span< Entity* const > findEntities( std::string_view name ) const;
+
+    /**
+     * @brief Finds every entity with an interned name, without hashing it.
+     * @param name Id from getNameId.
+     * @return The entities, empty if none has the name.
+     */
+    std::span< Entity* const > findEntities( const NameId name ) const;
+
+    /**
+     * @brief Gets the interned id of a name. Ids stay the same for the life
+     * of the world, even once no entity has the name.
+     * @param name Name to look up.
+     * @return Id of the name, or NoName if no entity has had it.
+     */
+    NameId getNameId( std::string_view name ) const;
+
+    /**
+     * @brief Renames an entity and moves it in the name index. Entities
+     * should be renamed through here rather than through their name.
+     * @param entity Entity in this world.
+     * @param name New name.
+     */
+    void renameEntity( Entity* entity, const std::string& name );
+
+    /**
+     * @brief Gives an entity a tag.
+     * @param entity Entity in this world.
+     * @param tag Tag to add.
+     */
+    void addTag( const Entity* entity, const unsigned tag );
+
+    /**
+     * @brief Takes a tag from an entity.
+     * @param entity Entity in this world.
+     * @param tag Tag to remove.
+     */
+    void removeTag( const Entity* entity, const unsigned tag );
+
+    /**
+     * @brief Checks if an entity has a tag.
+     * @param entity Entity in this world.
+     * @param tag Tag to check.
+     * @return true if the entity has the tag.
+     */
+    bool hasTag( const Entity* entity, const unsigned tag ) const;
+
+    /**
+     * @brief Gives an entity exactly the tags set in a mask.
+     * @param entity Entity in this world.
+     * @param tags Tags the entity should have.
+     */
+    void setTags( const Entity* entity, const EntityTags tags );
+
+    /**
+     * @brief Gets every tag of an entity.
+     * @param entity Entity in this world.
+     * @return Tags of the entity, none if it isn't in this world.
+     */
+    EntityTags getTags( const Entity* entity ) const;
+
+    /**
+     * @brief Gets every entity with a tag.
+     * @param tag Tag to query.
+     * @return The entities, in no particular order.
+     */
+    std::span< Entity* const > getTagged( const unsigned tag ) const;
+
+    /**
+     * @brief Finds the entity a handle refers to.
+     * @param handle Handle from getHandle.
+     * @return Pointer to the Entity, or nullptr if it was removed or the
+     * handle belongs to another world.
+     */
+    Entity* findEntity( const EntityHandle& handle );
+
+    /**
+     * @brief Gets a handle that stays safe to resolve after the entity goes.
+     * @param entity Entity in this world.
+     * @return Handle to the entity, invalid if it isn't in this world.
+     */
+    EntityHandle getHandle( const Entity* entity ) const;
 
     /**
      * @brief Removes an entity from the world.
@@ -60,6 +232,19 @@ public:
      */
     void removeEntity( const Entity* entity );
 
+    /**
+     * @brief Removes every entity from the world. Models release their GL
+     * objects, so call while the context is still current.
+     */
+    void clear();
+
+    /**
+     * @brief Empties the world and hands its entities to the caller, who
+     * decides when they are destroyed. Handles to them stop resolving.
+     * @return The entities that were in the world.
+     */
+    std::vector< std::unique_ptr< Entity > > releaseEntities();
+
     /**
      * @brief Gets the list of all entities.
      * @return Reference to the vector of unique pointers to entities.
@@ -67,22 +252,150 @@ public:
     std::vector< std::unique_ptr< Entity > >& getEntityList();
 
     /**
-     * @brief Gets the singleton instance of the World.
-     * @return Pointer to the World instance.
+     * @brief Stores every entity's transform as its previous snapshot. Called
+     * before each fixed step.
+     */
+    void storePreviousTransforms();
+
+    /**
+     * @brief Gets the name of the world.
+     * @return Name given on construction.
+     */
+    const std::string& getName() const;
+
+    /**
+     * @brief Gets the handle the WorldManager knows this world by.
+     * @return Handle of the world, invalid if it isn't managed.
+     */
+    WorldHandle getHandle() const;
+
+    /**
+     * @brief Sets whether the world's entities are simulated.
+     * @param active Whether to simulate the world.
+     */
+    void setActive( const bool active );
+
+    /**
+     * @brief Checks if the world's entities are simulated.
+     * @return true if the world is active.
      */
-    static World* instance();
+    bool isActive() const;
+
+    /**
+     * @brief Sets whether the world's entities are rendered.
+     * @param visible Whether to render the world.
+     */
+    void setVisible( const bool visible );
+
+    /**
+     * @brief Checks if the world's entities are rendered.
+     * @return true if the world is visible.
+     */
+    bool isVisible() const;
 
 private:
+    friend class WorldManager;
+
     /**
-     * @brief Private constructor for singleton pattern.
+     * @brief Entity a handle index points at, with a generation that changes
+     * whenever the slot is emptied.
      */
-    World();
+    struct EntitySlot {
+        Entity* entity = nullptr;  //!< Entity in the slot, nullptr if free.
+        uint32_t generation = 0;   //!< Bumped each time the slot is freed.
+        NameId name = NoName;      //!< Name of the entity, NoName if unnamed.
+        uint32_t namePosition = 0; //!< Index in its name's list.
+        EntityTags tags;           //!< Tags of the entity.
+    };
+
+    /**
+     * @brief Entities that share something, packed so they can be handed
+     * out as a span, with where each sits so removal is a swap.
+     */
+    struct EntitySet {
+        std::vector< Entity* > entities; //!< Members, in no order.
+        std::vector< uint32_t >
+            positions; //!< Index in entities by slot, grown on demand.
+    };
+
+    /**
+     * @brief Hashes names and the string_views they are looked up with.
+     */
+    struct NameHash {
+        using is_transparent = void;
+
+        /**
+         * @brief Hashes a name.
+         * @param name Name to hash.
+         * @return Hash of the name.
+         */
+        size_t operator()( std::string_view name ) const {
+            return std::hash< std::string_view >{}( name );
+        }
+    };
+
+    /**
+     * @brief Empties a slot and makes its handles stale.
+     * @param index Slot to free.
+     */
+    void releaseSlot( const uint32_t index );
+
+    /**
+     * @brief Gets the slot of an entity in this world.
+     * @param entity Entity to look up.
+     * @return Pointer to the slot, or nullptr if the entity isn't here.
+     */
+    EntitySlot* findSlot( const Entity* entity );
+
+    /**
+     * @brief Gets the slot of an entity in this world.
+     * @param entity Entity to look up.
+     * @return Pointer to the slot, or nullptr if the entity isn't here.
+     */
+    const EntitySlot* findSlot( const Entity* entity ) const;
+
+    /**
+     * @brief Adds an entity to the list of its name, interning the name.
+     * @param index Slot of the entity.
+     */
+    void indexName( const uint32_t index );
+
+    /**
+     * @brief Takes an entity out of the list of its name.
+     * @param index Slot of the entity.
+     */
+    void unindexName( const uint32_t index );
+
+    /**
+     * @brief Adds an entity to a set.
+     * @param set Set to add to.
+     * @param index Slot of the entity.
+     */
+    void insert( EntitySet& set, const uint32_t index );
+
+    /**
+     * @brief Takes an entity out of a set by swapping the last member in.
+     * @param set Set to remove from.
+     * @param index Slot of the entity.
+     */
+    void erase( EntitySet& set, const uint32_t index );
 
 protected:
     std::vector< std::unique_ptr< Entity > >
         m_entitesList; //!< List of all entities.
-    std::unordered_map< std::string, Entity* >
-        m_entitesMap; //!< Map of entity names to pointers.
+    std::unordered_map< std::string, NameId, NameHash, std::equal_to<> >
+        m_nameIds; //!< Interned names, never removed.
+    std::vector< std::vector< Entity* > >
+        m_named; //!< Entities by NameId, in no order.
+    std::array< EntitySet, MaxEntityTags > m_tagged; //!< Entities by tag.
+
+    std::vector< EntitySlot > m_slots;   //!< Entities by handle index.
+    std::vector< uint32_t > m_freeSlots; //!< Slots free for new entities.
+
+    std::string m_name;      //!< Name of the world.
+    WorldHandle m_handle;    //!< Set by the WorldManager.
+    bool m_isActive = true;  //!< Whether the world is simulated.
+    bool m_isVisible = true; //!< Whether the world is rendered.
 };
 
 } // namespace SquirrelEngine
@@ -0,0 +1,199 @@
+/**
+ *
+ * @file worldManager.hpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief Declares the WorldManager class, which owns every World and streams
+ * them in and out around the camera in SquirrelEngine.
+ * @date 2025-06-06
+ *
+ */
+
+#ifndef WORLDMANAGER_HPP
+#define WORLDMANAGER_HPP
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "math_types.hpp"
+#include "system.hpp"
+#include "world.hpp"
+
+namespace SquirrelEngine {
+
+//! Fills a world with its entities when it streams in
+using WorldLoader = std::function< void( World& ) >;
+
+/**
+ * @brief Owns every World. The persistent world is always loaded; streamed
+ * worlds are loaded once the camera comes within their load radius and
+ * unloaded once it leaves their unload radius, so only the worlds around the
+ * camera take memory.
+ */
+class WorldManager : public System {
+public:
+    /**
+     * @brief Default constructor for WorldManager.
+     */
+    WorldManager();
+
+    /**
+     * @brief Destructor for WorldManager.
+     */
+    ~WorldManager();
+
+    /**
+     * @brief Creates the persistent world.
+     * @param t_owner Pointer to the Engine that owns this system.
+     * @return StartupErrors indicating success or failure.
+     */
+    StartupErrors initialize( Engine* t_owner ) override;
+
+    /**
+     * @brief Streams worlds in and out around the camera.
+     * @param delta Time elapsed since last update.
+     */
+    void update( const float ) override;
+
+    /**
+     * @brief Destroys every world and their entities.
+     */
+    void shutdown() override;
+
+    /**
+     * @brief Creates an empty world that stays loaded until destroyed.
+     * @param name Name of the world, used in reports.
+     * @return Handle to the world.
+     */
+    WorldHandle createWorld( const std::string& name );
+
+    /**
+     * @brief Creates a world that loads and unloads by camera distance.
+     * @param name Name of the world, used in reports.
+     * @param center Point distances are measured from.
+     * @param loadRadius Camera distance the world loads within.
+     * @param unloadRadius Camera distance the world unloads beyond, at least
+     * the load radius so a camera on the edge doesn't reload it every frame.
+     * @param loader Fills the world each time it loads.
+     * @return Handle to the world, which starts unloaded.
+     */
+    WorldHandle createStreamedWorld( const std::string& name,
+                                     const vector3& center,
+                                     const float loadRadius,
+                                     const float unloadRadius,
+                                     WorldLoader loader );
+
+    /**
+     * @brief Destroys a world and its entities. The persistent world can't be
+     * destroyed, and no world can be while rendering on another thread.
+     * @param handle Handle to the world.
+     */
+    void destroyWorld( const WorldHandle handle );
+
+    /**
+     * @brief Finds the world a handle refers to.
+     * @param handle Handle from createWorld or createStreamedWorld.
+     * @return Pointer to the World, or nullptr if it was destroyed.
+     */
+    World* getWorld( const WorldHandle handle );
+
+    /**
+     * @brief Gets the world that is never unloaded.
+     * @return Pointer to the persistent World.
+     */
+    World* getPersistentWorld();
+
+    /**
+     * @brief Gets every world, loaded or not.
+     * @return Pointers to the worlds.
+     */
+    const std::vector< World* >& getWorlds() const;
+
+    /**
+     * @brief Finds the entity a handle refers to in any world.
+     * @param handle Handle from World::getHandle.
+     * @return Pointer to the Entity, or nullptr if it or its world is gone.
+     */
+    Entity* resolve( const EntityHandle& handle );
+
+    /**
+     * @brief Checks if a streamed world is loaded. Other worlds always are.
+     * @param handle Handle to the world.
+     * @return true if the world exists and is loaded.
+     */
+    bool isLoaded( const WorldHandle handle ) const;
+
+    /**
+     * @brief Stores the previous transforms of every active world. Called
+     * before each fixed step.
+     */
+    void storePreviousTransforms();
+
+    /**
+     * @brief Sets the camera that is rendered from and streams worlds.
+     * @param camera Handle to an entity with a CameraComponent.
+     */
+    void setCamera( const EntityHandle& camera );
+
+    /**
+     * @brief Gets the camera that is rendered from and streams worlds.
+     * @return Pointer to the camera entity, or nullptr if it is gone.
+     */
+    Entity* getCamera();
+
+private:
+    /**
+     * @brief World a handle index points at, with a generation that changes
+     * whenever the slot is emptied.
+     */
+    struct WorldSlot {
+        std::unique_ptr< World > world; //!< World in the slot, null if free.
+        uint32_t generation = 0;        //!< Bumped each time it is freed.
+    };
+
+    /**
+     * @brief Distances and loader of a streamed world.
+     */
+    struct StreamedWorld {
+        WorldHandle handle;       //!< World being streamed.
+        vector3 center;           //!< Point distances are measured from.
+        float loadRadius = 0.f;   //!< Loads within this distance.
+        float unloadRadius = 0.f; //!< Unloads beyond this distance.
+        WorldLoader loader;       //!< Fills the world when it loads.
+        bool isLoaded = false;    //!< Whether the loader has run.
+    };
+
+    /**
+     * @brief Runs the loader of a streamed world and shows it.
+     * @param streamed World to load.
+     */
+    void load( StreamedWorld& streamed );
+
+    /**
+     * @brief Destroys the entities of a streamed world and hides it.
+     * @param streamed World to unload.
+     */
+    void unload( StreamedWorld& streamed );
+
+    /**
+     * @brief Rebuilds the list returned by getWorlds.
+     */
+    void updateWorldList();
+
+    std::vector< WorldSlot > m_slots;    //!< Worlds by handle index.
+    std::vector< uint32_t > m_freeSlots; //!< Slots free for new worlds.
+    std::vector< World* > m_worlds;      //!< Every world, by slot.
+
+    std::vector< StreamedWorld > m_streamed; //!< Worlds loaded by distance.
+
+    WorldHandle m_persistent; //!< World that is never unloaded.
+    EntityHandle m_camera;    //!< Camera rendered from and streamed around.
+    bool m_canStream = true;  //!< Off when another thread owns the context.
+};
+
+} // namespace SquirrelEngine
+
+#endif
@@ -0,0 +1,294 @@
+/**
+ *
+ * @file worldPartition.hpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief Declares the WorldPartition class, which splits the level into a
+ * grid of cells and streams them in and out around the camera in
+ * SquirrelEngine.
+ * @date 2025-06-06
+ *
+ */
+
+#ifndef WORLDPARTITION_HPP
+#define WORLDPARTITION_HPP
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "math_types.hpp"
+#include "mesh.hpp"
+#include "quaternion.hpp"
+#include "system.hpp"
+#include "world.hpp"
+
+namespace SquirrelEngine {
+class MeshCache;
+class WorldManager;
+
+/**
+ * @brief Cell of the partition grid on the ground plane.
+ */
+struct CellCoord {
+    int32_t x = 0; //!< Column, along world x.
+    int32_t z = 0; //!< Row, along world z.
+};
+
+/**
+ * @brief One entity of a cell as its loader describes it. Plain data, so it
+ * can be built on a loader thread.
+ */
+struct EntityDesc {
+    std::string name;                  //!< Name of the entity.
+    vector3 position = vector3( 0.f ); //!< Position in the world.
+    Quaternion rotation;               //!< Rotation in the world.
+    vector3 scale = vector3( 1.f );    //!< Scale in the world.
+    std::string mesh;                  //!< Model file, empty for no model.
+    std::string vertShader;            //!< Vertex shader file of the model.
+    std::string fragShader;            //!< Fragment shader file of the model.
+};
+
+/**
+ * @brief Everything a cell holds, filled by its loader.
+ */
+struct CellData {
+    std::vector< EntityDesc > entities; //!< Entities to create.
+};
+
+//! Describes the entities of a cell. Runs on a loader thread, so it must not
+//! touch the engine. Returns false if there is no such cell
+using CellLoader = std::function< bool( const CellCoord&, CellData& ) >;
+
+/**
+ * @brief Grid, ceilings and budgets of the world partition.
+ */
+struct PartitionSettings {
+    float cellSize = 32.f;        //!< Width of a cell in world units.
+    int loadRadius = 2;           //!< Rings of cells loaded around the camera.
+    int evictRadius = 3;          //!< Rings beyond which cells are evicted.
+    unsigned loaderThreads = 2;   //!< Threads describing cells.
+    size_t memoryBudget = 256;    //!< Memory ceiling in megabytes.
+    float activationBudget = 2.f; //!< Time spent activating per frame, ms.
+};
+
+/**
+ * @brief What the partition holds and how well it kept to its budgets.
+ */
+struct PartitionStats {
+    size_t activeCells = 0;        //!< Cells in the world.
+    size_t pendingCells = 0;       //!< Cells loading or being activated.
+    size_t memoryUsage = 0;        //!< Estimated bytes of cells and meshes.
+    size_t peakMemory = 0;         //!< Highest memory usage seen.
+    uint64_t activationFrames = 0; //!< Frames that activated entities.
+    uint64_t overBudgetFrames = 0; //!< Frames activation overran its budget.
+    float maxActivationTime = 0.f; //!< Longest activation in a frame, ms.
+    uint64_t heldBackFrames = 0;   //!< Frames loads waited on the ceiling.
+};
+
+/**
+ * @brief Splits the level into a grid of cells. Cells around the camera are
+ * described and their model files parsed on loader threads, then turned into
+ * entities on the main thread a few at a time, so no frame spends more than
+ * the activation budget on it. Cells beyond the evict radius are unloaded,
+ * and no new cells are loaded while over the memory ceiling.
+ */
+class WorldPartition : public System {
+public:
+    /**
+     * @brief Default constructor for WorldPartition.
+     */
+    WorldPartition();
+
+    /**
+     * @brief Destructor for WorldPartition.
+     */
+    ~WorldPartition();
+
+    /**
+     * @brief Finds the worlds and mesh cache cells are loaded into.
+     * @param t_owner Pointer to the Engine that owns this system.
+     * @return StartupErrors indicating success or failure.
+     */
+    StartupErrors initialize( Engine* t_owner ) override;
+
+    /**
+     * @brief Requests cells near the camera, evicts far ones and activates
+     * loaded ones within the budget.
+     * @param delta Time elapsed since last update.
+     */
+    void update( const float ) override;
+
+    /**
+     * @brief Stops the loader threads, unloads every cell and reports.
+     */
+    void shutdown() override;
+
+    /**
+     * @brief Sets the grid, ceilings and budgets. Cells already loaded stay
+     * until the new radii evict them.
+     * @param settings Settings to use.
+     */
+    void setSettings( const PartitionSettings& settings );
+
+    /**
+     * @brief Gets the grid, ceilings and budgets.
+     * @return Current settings.
+     */
+    const PartitionSettings& getSettings() const;
+
+    /**
+     * @brief Sets what fills each cell and starts the loader threads.
+     * @param loader Describes a cell's entities, on a loader thread.
+     */
+    void setCellLoader( CellLoader loader );
+
+    /**
+     * @brief Finds the cell a point is in.
+     * @param position Point in the world.
+     * @return Cell containing the point.
+     */
+    CellCoord getCell( const vector3& position ) const;
+
+    /**
+     * @brief Checks if a cell's entities are all in the world.
+     * @param coord Cell to check.
+     * @return true if the cell is active.
+     */
+    bool isCellActive( const CellCoord& coord ) const;
+
+    /**
+     * @brief Gets what the partition holds and how it kept to its budgets.
+     * @return Current statistics.
+     */
+    PartitionStats getStats() const;
+
+    /**
+     * @brief Traces the peak memory and budget overruns.
+     */
+    void report() const;
+
+private:
+    /**
+     * @brief Progress of a cell from requested to in the world.
+     */
+    enum CellState : unsigned {
+        CS_Queued = 0, //!< Waiting for a loader thread.
+        CS_Loading,    //!< Being described on a loader thread.
+        CS_Ready,      //!< Described, waiting to be activated.
+        CS_Activating, //!< Entities being created, world still hidden.
+        CS_Active      //!< In the world.
+    };
+
+    /**
+     * @brief A requested cell and everything loaded for it.
+     */
+    struct Cell {
+        CellCoord coord;             //!< Where the cell is.
+        CellState state = CS_Queued; //!< How far it has come.
+        bool isEvicted = false;      //!< Dropped while a thread loads it.
+        CellData data;               //!< Entities, freed once active.
+        std::vector< std::shared_ptr< const MeshData > >
+            meshes;            //!< Keeps its models cached until active.
+        size_t nextEntity = 0; //!< Next entity to activate.
+        size_t memory = 0;     //!< Estimated bytes once active.
+        WorldHandle world;     //!< World its entities go in.
+    };
+
+    /**
+     * @brief Packs a cell coordinate into a map key.
+     * @param coord Cell to pack.
+     * @return Key of the cell.
+     */
+    static uint64_t key( const CellCoord& coord );
+
+    /**
+     * @brief Counts the rings of cells between two cells.
+     * @param a First cell.
+     * @param b Second cell.
+     * @return Chebyshev distance in cells.
+     */
+    static int distance( const CellCoord& a, const CellCoord& b );
+
+    /**
+     * @brief Describes queued cells until the partition stops. Runs on each
+     * loader thread.
+     */
+    void loaderLoop();
+
+    /**
+     * @brief Joins the loader threads and drops cells still queued.
+     */
+    void stopLoaders();
+
+    /**
+     * @brief Queues the missing cells within the load radius, nearest first,
+     * unless over the memory ceiling.
+     * @param center Cell the camera is in.
+     * @param memoryUsage Memory used right now.
+     */
+    void requestCells( const CellCoord& center, const size_t memoryUsage );
+
+    /**
+     * @brief Unloads cells beyond the evict radius, or beyond the load radius
+     * while over the memory ceiling.
+     * @param center Cell the camera is in.
+     * @param overBudget Whether memory is over the ceiling.
+     */
+    void evictCells( const CellCoord& center, const bool overBudget );
+
+    /**
+     * @brief Creates entities of loaded cells, nearest first, until the
+     * activation budget runs out.
+     * @param center Cell the camera is in.
+     */
+    void activateCells( const CellCoord& center );
+
+    /**
+     * @brief Finds the loaded cell to activate next.
+     * @param center Cell the camera is in.
+     * @return Cell to activate, or nullptr if none is loaded.
+     */
+    Cell* nextToActivate( const CellCoord& center );
+
+    /**
+     * @brief Creates one entity of a cell.
+     * @param world World to create it in.
+     * @param desc Description of the entity.
+     */
+    void spawn( World& world, const EntityDesc& desc );
+
+    /**
+     * @brief Estimates the memory used by the cells and the mesh cache.
+     * @return Bytes in use.
+     */
+    size_t measureMemory() const;
+
+    PartitionSettings m_settings; //!< Grid, ceilings and budgets.
+    CellLoader m_loader;          //!< Describes each cell.
+
+    std::unordered_map< uint64_t, std::unique_ptr< Cell > >
+        m_cells;                          //!< Requested cells by key.
+    std::deque< Cell* > m_queue;          //!< Cells waiting for a loader.
+    std::vector< std::thread > m_loaders; //!< Loader threads.
+    mutable std::mutex m_mutex;           //!< Guards the queue and states.
+    std::condition_variable m_wake;       //!< Signalled when cells queue.
+    bool m_stopping = false;              //!< Tells the loaders to exit.
+
+    WorldManager* m_worldManager = nullptr; //!< Owns the cells' worlds.
+    MeshCache* m_meshCache = nullptr;       //!< Parses the cells' models.
+    bool m_isEnabled = true; //!< Off when another thread owns the context.
+
+    PartitionStats m_stats; //!< Budget statistics, kept on the main thread.
+};
+
+} // namespace SquirrelEngine
+
+#endif
@@ -9,6 +9,7 @@
  */
 
 #include "cameraComponent.hpp"
+#include "dataRecord.hpp"
 #include "entity.hpp"
 #include "transform.hpp"
 
@@ -52,6 +53,46 @@ matrix4 CameraComponent::projectionMatrix() {
                                       ffar );
 }
 
+/**
+ * @brief Serializes the camera component's data into the given record.
+ * @param record Pointer to the DataRecord to serialize into.
+ */
+void CameraComponent::serializeComponent( DataRecord* record ) {
+    record->setType( "Camera" );
+    record->set( "fov", fov );
+    record->set( "near", fnear );
+    record->set( "far", ffar );
+    record->set( "aspect", aspect );
+    record->set( "primary", primary );
+    record->set( "offset", m_localTransform.getPosition() );
+    record->set( "rotation", m_eulerRotation );
+    record->set( "sensitivity", m_sensitivity );
+}
+
+/**
+ * @brief Deserializes the camera component's data from the given record.
+ * Fields missing from the record keep their current values.
+ * @param record Pointer to the DataRecord to deserialize from.
+ */
+void CameraComponent::deserializeComponent( DataRecord* record ) {
+    record->get( "fov", fov );
+    record->get( "near", fnear );
+    record->get( "far", ffar );
+    record->get( "aspect", aspect );
+    record->get( "primary", primary );
+    record->get( "sensitivity", m_sensitivity );
+
+    vector3 offset = m_localTransform.getPosition();
+    if ( record->get( "offset", offset ) ) {
+        m_localTransform.setPosition( offset );
+    }
+
+    // The view rebuilds its rotation from these on the next viewMatrix
+    if ( record->get( "rotation", m_eulerRotation ) ) {
+        m_rotationIsDirty = true;
+    }
+}
+
 /**
  * @brief Sets the camera's pitch (rotation around the X axis).
  * @param angle The pitch angle in degrees or radians.
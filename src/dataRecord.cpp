@@ -0,0 +1,400 @@
+/**
+ *
+ * @file dataRecord.cpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief Implements the DataRecord class, a named set of text fields that
+ * entities and components serialize into in SquirrelEngine.
+ * @date 2025-06-06
+ *
+ */
+
+#include <charconv>
+#include <cstring>
+
+#include "dataRecord.hpp"
+
+namespace SquirrelEngine {
+
+/**
+ * @brief Writes a float in its shortest form that reads back exactly.
+ * @param text String to append to.
+ * @param value Float to write.
+ */
+static void appendFloat( std::string& text, const float value ) {
+    char buffer[32];
+    const std::to_chars_result result =
+        std::to_chars( buffer, buffer + sizeof( buffer ), value );
+    text.append( buffer, result.ptr );
+}
+
+/**
+ * @brief Constructs an empty record.
+ * @param t_type Type of the record, the name in brackets.
+ */
+DataRecord::DataRecord( const std::string& t_type ) : m_type( t_type ) {}
+
+/**
+ * @brief Gets the type of the record.
+ * @return Name in brackets.
+ */
+const std::string& DataRecord::getType() const { return m_type; }
+
+/**
+ * @brief Sets the type of the record.
+ * @param type Name in brackets.
+ */
+void DataRecord::setType( const std::string& type ) { m_type = type; }
+
+/**
+ * @brief Sets a field, replacing it if it exists.
+ * @param key Name of the field.
+ * @param value Value to store.
+ */
+void DataRecord::set( const std::string& key, const std::string& value ) {
+    for ( auto& field : m_fields ) {
+        if ( field.first == key ) {
+            field.second = value;
+            return;
+        }
+    }
+
+    m_fields.emplace_back( key, value );
+}
+
+/**
+ * @brief Sets a text field. Keeps literals from converting to bool.
+ * @param key Name of the field.
+ * @param value Value to store.
+ */
+void DataRecord::set( const std::string& key, const char* value ) {
+    set( key, std::string( value ) );
+}
+
+/**
+ * @brief Sets a float field.
+ * @param key Name of the field.
+ * @param value Value to store.
+ */
+void DataRecord::set( const std::string& key, const float value ) {
+    std::string text;
+    appendFloat( text, value );
+    set( key, text );
+}
+
+/**
+ * @brief Sets a signed integer field.
+ * @param key Name of the field.
+ * @param value Value to store.
+ */
+void DataRecord::set( const std::string& key, const int32_t value ) {
+    set( key, std::to_string( value ) );
+}
+
+/**
+ * @brief Sets an unsigned integer field.
+ * @param key Name of the field.
+ * @param value Value to store.
+ */
+void DataRecord::set( const std::string& key, const uint32_t value ) {
+    set( key, std::to_string( value ) );
+}
+
+/**
+ * @brief Sets a bool field, written as true or false.
+ * @param key Name of the field.
+ * @param value Value to store.
+ */
+void DataRecord::set( const std::string& key, const bool value ) {
+    set( key, value ? "true" : "false" );
+}
+
+/**
+ * @brief Sets a vector field, written as x y z.
+ * @param key Name of the field.
+ * @param value Value to store.
+ */
+void DataRecord::set( const std::string& key, const vector3& value ) {
+    std::string text;
+    for ( int i = 0; i < 3; ++i ) {
+        if ( i > 0 ) {
+            text += ' ';
+        }
+        appendFloat( text, value[i] );
+    }
+    set( key, text );
+}
+
+/**
+ * @brief Sets a quaternion field, written as w i j k.
+ * @param key Name of the field.
+ * @param value Value to store.
+ */
+void DataRecord::set( const std::string& key, const Quaternion& value ) {
+    const float parts[4] = { value.w, value.i, value.j, value.k };
+
+    std::string text;
+    for ( int i = 0; i < 4; ++i ) {
+        if ( i > 0 ) {
+            text += ' ';
+        }
+        appendFloat( text, parts[i] );
+    }
+    set( key, text );
+}
+
+/**
+ * @brief Gets a text field.
+ * @param key Name of the field.
+ * @param value Set to the stored value if there is one.
+ * @return true if the field exists.
+ */
+bool DataRecord::get( const std::string& key, std::string& value ) const {
+    const std::string* text = find( key );
+    if ( !text ) {
+        return false;
+    }
+
+    value = *text;
+    return true;
+}
+
+/**
+ * @brief Gets a float field.
+ * @param key Name of the field.
+ * @param value Set to the stored value if there is one.
+ * @return true if the field exists and parsed.
+ */
+bool DataRecord::get( const std::string& key, float& value ) const {
+    return getFloats( key, &value, 1 );
+}
+
+/**
+ * @brief Gets a signed integer field.
+ * @param key Name of the field.
+ * @param value Set to the stored value if there is one.
+ * @return true if the field exists and parsed.
+ */
+bool DataRecord::get( const std::string& key, int32_t& value ) const {
+    const std::string* text = find( key );
+    if ( !text ) {
+        return false;
+    }
+
+    const char* end = text->data() + text->size();
+    int32_t parsed = 0;
+    const std::from_chars_result result =
+        std::from_chars( text->data(), end, parsed );
+    if ( result.ec != std::errc() || result.ptr != end ) {
+        return false;
+    }
+
+    value = parsed;
+    return true;
+}
+
+/**
+ * @brief Gets an unsigned integer field.
+ * @param key Name of the field.
+ * @param value Set to the stored value if there is one.
+ * @return true if the field exists and parsed.
+ */
+bool DataRecord::get( const std::string& key, uint32_t& value ) const {
+    const std::string* text = find( key );
+    if ( !text ) {
+        return false;
+    }
+
+    const char* end = text->data() + text->size();
+    uint32_t parsed = 0;
+    const std::from_chars_result result =
+        std::from_chars( text->data(), end, parsed );
+    if ( result.ec != std::errc() || result.ptr != end ) {
+        return false;
+    }
+
+    value = parsed;
+    return true;
+}
+
+/**
+ * @brief Gets a bool field.
+ * @param key Name of the field.
+ * @param value Set to the stored value if there is one.
+ * @return true if the field is true or false.
+ */
+bool DataRecord::get( const std::string& key, bool& value ) const {
+    const std::string* text = find( key );
+    if ( !text || ( *text != "true" && *text != "false" ) ) {
+        return false;
+    }
+
+    value = *text == "true";
+    return true;
+}
+
+/**
+ * @brief Gets a vector field.
+ * @param key Name of the field.
+ * @param value Set to the stored value if there is one.
+ * @return true if the field exists and has three floats.
+ */
+bool DataRecord::get( const std::string& key, vector3& value ) const {
+    float parts[3];
+    if ( !getFloats( key, parts, 3 ) ) {
+        return false;
+    }
+
+    value = vector3( parts[0], parts[1], parts[2] );
+    return true;
+}
+
+/**
+ * @brief Gets a quaternion field.
+ * @param key Name of the field.
+ * @param value Set to the stored value if there is one.
+ * @return true if the field exists and has four floats.
+ */
+bool DataRecord::get( const std::string& key, Quaternion& value ) const {
+    float parts[4];
+    if ( !getFloats( key, parts, 4 ) ) {
+        return false;
+    }
+
+    value = Quaternion( parts[0], parts[1], parts[2], parts[3] );
+    return true;
+}
+
+/**
+ * @brief Checks if a field exists.
+ * @param key Name of the field.
+ * @return true if the field was set or read.
+ */
+bool DataRecord::has( const std::string& key ) const {
+    return find( key ) != nullptr;
+}
+
+/**
+ * @brief Removes the type and every field.
+ */
+void DataRecord::clear() {
+    m_type.clear();
+    m_fields.clear();
+}
+
+/**
+ * @brief Writes the record followed by a blank line.
+ * @param stream Stream to write to.
+ */
+void DataRecord::write( std::ostream& stream ) const {
+    stream << '[' << m_type << "]\n";
+    for ( const auto& [key, value] : m_fields ) {
+        stream << key << " = " << value << '\n';
+    }
+    stream << '\n';
+}
+
+/**
+ * @brief Reads the next record, skipping blank lines and # comments.
+ * @param stream Stream to read from.
+ * @param record Cleared, then filled with the record.
+ * @return false once there are no records left.
+ */
+bool DataRecord::read( std::istream& stream, DataRecord& record ) {
+    record.clear();
+
+    std::string line;
+    bool hasHeader = false;
+    while ( std::getline( stream, line ) ) {
+        // Files saved on Windows keep the \r
+        if ( !line.empty() && line.back() == '\r' ) {
+            line.pop_back();
+        }
+
+        if ( line.empty() ) {
+            if ( hasHeader ) {
+                return true;
+            }
+            continue;
+        }
+
+        if ( line[0] == '#' ) {
+            continue;
+        }
+
+        if ( !hasHeader ) {
+            if ( line.front() != '[' || line.back() != ']' ) {
+                continue;
+            }
+
+            record.m_type = line.substr( 1, line.size() - 2 );
+            hasHeader = true;
+            continue;
+        }
+
+        const size_t equals = line.find( " = " );
+        if ( equals == std::string::npos ) {
+            continue;
+        }
+
+        record.m_fields.emplace_back( line.substr( 0, equals ),
+                                      line.substr( equals + 3 ) );
+    }
+
+    return hasHeader;
+}
+
+/**
+ * @brief Finds the text of a field.
+ * @param key Name of the field.
+ * @return Pointer to the text, or nullptr if there is no such field.
+ */
+const std::string* DataRecord::find( const std::string& key ) const {
+    for ( const auto& field : m_fields ) {
+        if ( field.first == key ) {
+            return &field.second;
+        }
+    }
+
+    return nullptr;
+}
+
+/**
+ * @brief Parses whitespace separated floats.
+ * @param key Name of the field.
+ * @param values Filled with the floats.
+ * @param count Number of floats expected.
+ * @return true if the field has exactly that many floats.
+ */
+bool DataRecord::getFloats( const std::string& key, float* values,
+                            const int count ) const {
+    const std::string* text = find( key );
+    if ( !text ) {
+        return false;
+    }
+
+    const char* it = text->data();
+    const char* end = it + text->size();
+
+    float parsed[4];
+    for ( int i = 0; i < count; ++i ) {
+        while ( it != end && *it == ' ' ) {
+            ++it;
+        }
+
+        const std::from_chars_result result =
+            std::from_chars( it, end, parsed[i] );
+        if ( result.ec != std::errc() ) {
+            return false;
+        }
+        it = result.ptr;
+    }
+
+    if ( it != end ) {
+        return false;
+    }
+
+    std::memcpy( values, parsed, sizeof( float ) * count );
+    return true;
+}
+
+} // namespace SquirrelEngine
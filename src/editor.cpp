@@ -40,6 +40,13 @@ StartupErrors Editor::initialize( Engine* t_owner ) {
     return StartupErrors::SE_Success;
 }
 
+void Editor::shutdown() {
+    // Backends delete their GL objects, so this runs before the window goes
+    ImGui_ImplOpenGL3_Shutdown();
+    ImGui_ImplGlfw_Shutdown();
+    ImGui::DestroyContext();
+}
+
 void Editor::update( const float ) {
     // ImGui update functions
     ImGui_ImplOpenGL3_NewFrame();
@@ -0,0 +1,73 @@
+
+#include "imgui.h"
+
+#include "editor_windows/profiler_editor.hpp"
+#include "editor.hpp"
+#include "engine.hpp"
+#include "frameProfiler.hpp"
+
+namespace SquirrelEngine {
+
+ProfilerEditor::ProfilerEditor() {
+    getSystem< Editor >()->addDisplayMenuCallback(
+        std::bind( &ProfilerEditor::update, this ) );
+}
+
+StartupErrors ProfilerEditor::initialize( Engine* ) {
+    m_profiler = getSystem< FrameProfiler >();
+
+    return StartupErrors::SE_Success;
+}
+
+void ProfilerEditor::update() {
+    ImGui::Begin( "Frame Timings##1" );
+
+    if ( !m_profiler ) {
+        ImGui::End();
+        return;
+    }
+
+    ImGui::Text( "Dropped frames: %llu",
+                 static_cast< unsigned long long >(
+                     m_profiler->getDroppedFrames() ) );
+
+    const ImGuiTableFlags flags = ImGuiTableFlags_Borders |
+                                  ImGuiTableFlags_RowBg |
+                                  ImGuiTableFlags_SizingStretchProp;
+
+    if ( ImGui::BeginTable( "Passes", 5, flags ) ) {
+        ImGui::TableSetupColumn( "Pass" );
+        ImGui::TableSetupColumn( "CPU (ms)" );
+        ImGui::TableSetupColumn( "CPU avg" );
+        ImGui::TableSetupColumn( "GPU (ms)" );
+        ImGui::TableSetupColumn( "GPU avg" );
+        ImGui::TableHeadersRow();
+
+        for ( const auto& pass : m_profiler->getPassTimings() ) {
+            ImGui::TableNextRow();
+
+            // Nested passes are indented under their parent
+            const float indent = static_cast< float >( pass.depth ) * 10.f;
+
+            ImGui::TableNextColumn();
+            if ( indent > 0.f ) ImGui::Indent( indent );
+            ImGui::TextUnformatted( pass.name );
+            if ( indent > 0.f ) ImGui::Unindent( indent );
+
+            ImGui::TableNextColumn();
+            ImGui::Text( "%.3f", pass.cpuMs );
+            ImGui::TableNextColumn();
+            ImGui::Text( "%.3f", pass.cpuAvgMs );
+            ImGui::TableNextColumn();
+            ImGui::Text( "%.3f", pass.gpuMs );
+            ImGui::TableNextColumn();
+            ImGui::Text( "%.3f", pass.gpuAvgMs );
+        }
+
+        ImGui::EndTable();
+    }
+
+    ImGui::End();
+}
+
+} // namespace SquirrelEngine
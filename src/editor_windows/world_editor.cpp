@@ -10,6 +10,7 @@
 #include "engine.hpp"
 #include "entity.hpp"
 #include "world.hpp"
+#include "worldManager.hpp"
 
 namespace SquirrelEngine {
 
@@ -19,7 +20,7 @@ WorldEditor::WorldEditor() {
 }
 
 StartupErrors WorldEditor::initialize( Engine* ) {
-    m_world = World::instance();
+    m_world = getSystem< WorldManager >()->getPersistentWorld();
 
     return StartupErrors::SE_Success;
 }
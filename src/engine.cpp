@@ -12,29 +12,73 @@
 #include <GLFW/glfw3.h>
 
 #include "core.hpp"
+#include "renderPipeline.hpp"
 #include <memory>
 
 namespace SquirrelEngine {
 
 /**
- * @brief Default constructor for Engine.
+ * @brief Actions the engine reads every frame, interned once at startup.
  */
-Engine::Engine() {}
+static struct EngineActions {
+    ActionId enableCamera = InvalidAction; //!< Hold to fly the camera.
+    ActionId moveForward = InvalidAction;  //!< Camera forward.
+    ActionId moveBackward = InvalidAction; //!< Camera backward.
+    ActionId moveLeft = InvalidAction;     //!< Camera left.
+    ActionId moveRight = InvalidAction;    //!< Camera right.
+    ActionId moveUp = InvalidAction;       //!< Camera up.
+    ActionId moveDown = InvalidAction;     //!< Camera down.
+    ActionId closeWindow = InvalidAction;  //!< Quit.
+} engineActions;
 
 /**
- * @brief Virtual destructor for Engine.
+ * @brief Default constructor for Engine. Makes the trace first, so it is
+ * destroyed after the engine and shutdown can still log.
  */
-Engine::~Engine() {}
+Engine::Engine() { Trace::open(); }
+
+/**
+ * @brief Virtual destructor for Engine. Shuts down if the application didn't.
+ */
+Engine::~Engine() { shutdown(); }
 
 /**
  * @brief Starts all essential systems for the engine.
+ * @param settings Window and run mode settings.
  * @return StartupErrors indicating success or failure.
  */
-enum StartupErrors Engine::initialize() {
-    m_window = std::make_unique< Window >();
-    m_window->create( "SquirrelEngine", 1280, 720, false );
+enum StartupErrors Engine::initialize( const EngineSettings& settings ) {
+    m_settings = settings;
+
+    // Restarts may keep the window from the last run
+    if ( m_window ) {
+        glfwSetWindowShouldClose( m_window->getHandle(), GLFW_FALSE );
+    } else {
+        m_window = std::make_unique< Window >();
+        const StartupErrors windowResult =
+            m_window->create( m_settings.title, m_settings.width,
+                              m_settings.height, m_settings.fullscreen,
+                              m_settings.headless );
+        if ( windowResult != StartupErrors::SE_Success ) {
+            m_window.reset();
+            return windowResult;
+        }
+    }
+
+    if ( m_settings.headless ) {
+        m_headless = std::make_unique< HeadlessRunner >();
+        if ( !m_headless->initialize( m_settings ) ) {
+            return StartupErrors::SE_GraphicsWindowFailedInit;
+        }
+    }
 
-    if ( !createSystem< TimeManager >() ) {
+    if ( TimeManager* timeManager = createSystem< TimeManager >() ) {
+        // Headless runs are uncapped
+        timeManager->setTargetFrameRate(
+            m_settings.headless ? 0.f : m_settings.targetFrameRate );
+        timeManager->setFixedDt( m_settings.fixedDeltaTime );
+        timeManager->setMaxFixedSteps( m_settings.maxFixedSteps );
+    } else {
         return StartupErrors::SE_SystemFailedInit;
     }
     if ( !createSystem< EventSystem >() ) {
@@ -47,18 +91,95 @@ enum StartupErrors Engine::initialize() {
         Mouse* mouse = inputSystem->createInputDevice< Mouse >();
         mouse->initialize();
 
+        inputSystem->createInputDevice< Gamepad >();
+
+        engineActions.enableCamera =
+            inputSystem->internAction( "enable camera movement"_action );
+        engineActions.moveForward =
+            inputSystem->internAction( "move forward"_action );
+        engineActions.moveBackward =
+            inputSystem->internAction( "move backward"_action );
+        engineActions.moveLeft = inputSystem->internAction( "move left"_action );
+        engineActions.moveRight =
+            inputSystem->internAction( "move right"_action );
+        engineActions.moveUp = inputSystem->internAction( "move up"_action );
+        engineActions.moveDown = inputSystem->internAction( "move down"_action );
+        engineActions.closeWindow =
+            inputSystem->internAction( "close window"_action );
     } else {
         return StartupErrors::SE_SystemFailedInit;
     }
+
+    // Recordings and replays both step by the recorded frame time instead of
+    // the clock, so every frame's input lands on the same simulated time
+    if ( !m_settings.replayFile.empty() ) {
+        m_recorder = std::make_unique< InputRecorder >();
+        if ( !m_recorder->startReplay( m_settings.replayFile ) ) {
+            return StartupErrors::SE_SystemFailedInit;
+        }
+
+        getSystem< TimeManager >()->setLockedDeltaTime(
+            m_recorder->getDeltaTime() );
+        if ( m_settings.frameCount == 0 ) {
+            m_settings.frameCount = m_recorder->getFrameCount();
+        }
+    } else if ( !m_settings.recordFile.empty() ) {
+        m_recorder = std::make_unique< InputRecorder >();
+        if ( !m_recorder->startRecording( m_settings.recordFile,
+                                          m_settings.replayDeltaTime ) ) {
+            return StartupErrors::SE_SystemFailedInit;
+        }
+
+        getSystem< TimeManager >()->setLockedDeltaTime(
+            m_settings.replayDeltaTime );
+    }
+
+    if ( !createSystem< ShaderCompiler >() ) {
+        return StartupErrors::SE_SystemFailedInit;
+    }
+    if ( !createSystem< FrameProfiler >() ) {
+        return StartupErrors::SE_SystemFailedInit;
+    }
+    if ( !createSystem< MeshCache >() ) {
+        return StartupErrors::SE_SystemFailedInit;
+    }
+    if ( !createSystem< PrefabLibrary >() ) {
+        return StartupErrors::SE_SystemFailedInit;
+    }
     if ( !createSystem< ObjectRenderer >() ) {
         return StartupErrors::SE_SystemFailedInit;
     }
+
+    // Models delete their meshes when their world goes, so worlds are made
+    // after the renderer and shader compiler to be shut down before them
+    if ( !createSystem< WorldManager >() ) {
+        return StartupErrors::SE_SystemFailedInit;
+    }
+    if ( !createSystem< WorldPartition >() ) {
+        return StartupErrors::SE_SystemFailedInit;
+    }
+
+    // Editor windows need a visible window to draw into
+    if ( m_settings.headless ) {
+        return StartupErrors::SE_Success;
+    }
+
+    // The editor reads the world while drawing, which only the simulation
+    // thread may do
+    if ( m_settings.renderThread ) {
+        Trace::message( "Editor windows are disabled with a render thread." );
+        return StartupErrors::SE_Success;
+    }
+
     if ( !createSystem< Editor >() ) {
         return StartupErrors::SE_SystemFailedInit;
     }
     if ( !createSystem< WorldEditor >() ) {
         return StartupErrors::SE_SystemFailedInit;
     }
+    if ( !createSystem< ProfilerEditor >() ) {
+        return StartupErrors::SE_SystemFailedInit;
+    }
 
     return StartupErrors::SE_Success;
 }
@@ -73,7 +194,7 @@ static void moveCamera( Entity* camera, TimeManager* timeManager,
                         InputSystem* inputSystem ) {
     Mouse* mouse = inputSystem->findInputDevice< Mouse >();
 
-    if ( !inputSystem->getActionState( "enable camera movement" ) ) {
+    if ( !inputSystem->getActionState( engineActions.enableCamera ) ) {
         mouse->setCursorMode( GLFW_CURSOR_NORMAL );
         return;
     }
@@ -82,39 +203,27 @@ static void moveCamera( Entity* camera, TimeManager* timeManager,
     CameraComponent* cCamera = camera->findComponent< CameraComponent >();
 
     const float speed = 5.f;
-
-    camera->transform.move( cCamera->forwardVector() *
-                            timeManager->getDeltaTime() * speed *
-                            inputSystem->getActionState( "move forward" ) );
-
-    camera->transform.move( cCamera->forwardVector() *
-                            timeManager->getDeltaTime() * -speed *
-                            inputSystem->getActionState( "move backward" ) );
-
-    camera->transform.move( cCamera->rightVector() *
-                            timeManager->getDeltaTime() * -speed *
-                            inputSystem->getActionState( "move left" ) );
-
-    camera->transform.move( cCamera->rightVector() *
-                            timeManager->getDeltaTime() * speed *
-                            inputSystem->getActionState( "move right" ) );
-
-    camera->transform.move( cCamera->upVector() * timeManager->getDeltaTime() *
-                            speed * inputSystem->getActionState( "move up" ) );
-
-    camera->transform.move( cCamera->upVector() * timeManager->getDeltaTime() *
-                            -speed *
-                            inputSystem->getActionState( "move down" ) );
-
-    vector2 mouseDelta = mouse->getCursorDelta();
-
-    CameraComponent* cameraC = camera->findComponent< CameraComponent >();
-
-    cameraC->addPitch( glm::radians( cameraC->getSensitivity() * -mouseDelta.y *
-                                     timeManager->getDeltaTime() ) );
-
-    cameraC->addYaw( glm::radians( cameraC->getSensitivity() * -mouseDelta.x *
-                                   timeManager->getDeltaTime() ) );
+    const float step = timeManager->getDeltaTime() * speed;
+
+    const float forward =
+        inputSystem->getActionState( engineActions.moveForward ) -
+        inputSystem->getActionState( engineActions.moveBackward );
+    const float right = inputSystem->getActionState( engineActions.moveRight ) -
+                        inputSystem->getActionState( engineActions.moveLeft );
+    const float up = inputSystem->getActionState( engineActions.moveUp ) -
+                     inputSystem->getActionState( engineActions.moveDown );
+
+    camera->transform.move( cCamera->forwardVector() * step * forward );
+    camera->transform.move( cCamera->rightVector() * step * right );
+    camera->transform.move( cCamera->upVector() * step * up );
+
+    // Motion is already the distance moved this frame, scaling it by the
+    // frame time would make look speed depend on frame rate
+    const vector2 mouseDelta = mouse->getMotionDelta();
+    const float degreesPerCount = 0.022f * cCamera->getSensitivity();
+
+    cCamera->addPitch( glm::radians( degreesPerCount * -mouseDelta.y ) );
+    cCamera->addYaw( glm::radians( degreesPerCount * -mouseDelta.x ) );
 }
 
 /**
@@ -123,57 +232,290 @@ static void moveCamera( Entity* camera, TimeManager* timeManager,
 void Engine::update() {
     TimeManager* timeManager = getSystem< TimeManager >();
     InputSystem* inputSystem = getSystem< InputSystem >();
+    EventSystem* eventSystem = getSystem< EventSystem >();
     ObjectRenderer* objRenderer = getSystem< ObjectRenderer >();
+    FrameProfiler* profiler = getSystem< FrameProfiler >();
     Editor* editor = getSystem< Editor >();
 
+    // The profiler's GPU queries belong to the render thread when there is
+    // one, so the simulation passes go untimed
+    FrameProfiler* simProfiler = m_settings.renderThread ? nullptr : profiler;
+
     glfwSetInputMode( m_window->getHandle(), GLFW_CURSOR, GLFW_CURSOR_NORMAL );
 
-    World* world = World::instance();
-    Entity* camera = world->findEntity( "Main camera" );
+    WorldManager* worldManager = getSystem< WorldManager >();
+
+    int frame = 0;
+
+    // Don't count startup as the first frame
+    timeManager->resetLastTime();
+
+    if ( m_settings.renderThread ) {
+        startRenderThread();
+    }
 
     // Main update loop
     while ( !m_window->isClosing() ) {
+        if ( !m_pipeline ) {
+            if ( m_headless ) {
+                m_headless->beginFrame();
+            }
+            profiler->beginFrame();
+        }
+
         // Increment time values
         timeManager->increment();
 
-        // Gather inputs
-        m_window->pollEvents();
+        {
+            FrameProfiler::Scope scope( simProfiler, "Input" );
+
+            // Gather inputs
+            if ( m_recorder ) {
+                m_recorder->beginInput( frame );
+            }
+            m_window->pollEvents();
+            if ( m_recorder ) {
+                m_recorder->endInput();
+            }
+
+            // Deliver this frame's input before anything simulates
+            eventSystem->flush();
+            inputSystem->update( timeManager->getDeltaTime() );
+
+            if ( inputSystem->getSnapshot().wasPressed(
+                     engineActions.closeWindow ) ) {
+                glfwSetWindowShouldClose( m_window->getHandle(), GL_TRUE );
+            }
 
-        if ( inputSystem->getActionState( "close window" ) ) {
-            glfwSetWindowShouldClose( m_window->getHandle(), GL_TRUE );
+            // Looked up each frame, the camera may have been streamed out
+            if ( Entity* camera = worldManager->getCamera() ) {
+                moveCamera( camera, timeManager, inputSystem );
+            }
         }
 
-        moveCamera( camera, timeManager, inputSystem );
+        {
+            FrameProfiler::Scope scope( simProfiler, "Fixed update" );
+
+            // Fixed update loop
+            while ( timeManager->needsFixedUpdate() ) {
+                // Rendering interpolates from here to the end of the step
+                worldManager->storePreviousTransforms();
 
-        // Fixed update loop
-        while ( timeManager->needsFixedUpdate() ) {
-            // Fixed update callbacks
-            for ( auto& func : fixedUpdateCallbacks ) {
-                func();
+                // Fixed update callbacks
+                for ( auto& func : fixedUpdateCallbacks ) {
+                    func();
+                }
             }
         }
 
-        // Non-fixed update callbacks
-        for ( auto& func : updateCallbacks ) {
-            func( timeManager->getDeltaTime() );
+        {
+            FrameProfiler::Scope scope( simProfiler, "Update" );
+
+            // Non-fixed update callbacks
+            for ( auto& func : updateCallbacks ) {
+                func( timeManager->getDeltaTime() );
+            }
+
+            // Deliver events queued by the simulation before rendering
+            eventSystem->flush();
         }
 
-        // TODO: call render function
-        objRenderer->render();
-        editor->render();
+        if ( m_pipeline ) {
+            // Capture this frame while the render thread draws the last one
+            RenderSnapshot& snapshot = m_pipeline->beginWrite();
+            objRenderer->buildSnapshot( snapshot );
+            m_pipeline->endWrite();
+        } else {
+            {
+                FrameProfiler::Scope scope( profiler, "Objects" );
+                objRenderer->render();
+            }
+            if ( editor ) {
+                FrameProfiler::Scope scope( profiler, "Editor" );
+                editor->render();
+            }
 
-        m_window->swapBuffer();
+            profiler->endFrame();
 
-        // Don't use whole cpu
-        timeManager->sleep( 1 );
+            // Headless runs never present
+            if ( m_headless ) {
+                m_headless->endFrame();
+            } else {
+                m_window->swapBuffer();
+            }
+        }
+
+        ++frame;
+
+        // Pace to the target rate without oversleeping, headless is uncapped
+        timeManager->limitFrame();
+
+        if ( m_settings.frameCount > 0 && frame >= m_settings.frameCount ) {
+            break;
+        }
+    }
+
+    if ( m_pipeline ) {
+        stopRenderThread();
+    }
+
+    const TimeManager::FrameTimeStats stats = timeManager->getFrameTimeStats();
+    Trace::message( fmt::format(
+        "Frame time over {} frames: p50 {:.3f} ms, p99 {:.3f} ms, max {:.3f} "
+        "ms.",
+        stats.sampleCount, stats.p50, stats.p99, stats.max ) );
+
+    if ( m_headless ) {
+        m_headless->finish();
+    }
+    if ( m_recorder ) {
+        m_recorder->finish();
+    }
+}
+
+/**
+ * @brief Hands the OpenGL context to a new render thread and starts
+ * pipelining frames.
+ */
+void Engine::startRenderThread() {
+    m_pipeline = std::make_unique< RenderPipeline >();
+    m_pipeline->setMaxFramesAhead( m_settings.maxFramesAhead );
+    m_pipeline->setDropLateFrames( m_settings.dropLateFrames );
+
+    getSystem< ShaderCompiler >()->setResolveOnRenderThread( true );
+
+    // A context can only be current on one thread at a time
+    glfwMakeContextCurrent( nullptr );
+    m_renderThread = std::thread( &Engine::renderLoop, this );
+}
+
+/**
+ * @brief Waits for the published frames to be drawn, stops the render thread
+ * and takes the OpenGL context back.
+ */
+void Engine::stopRenderThread() {
+    m_pipeline->waitIdle();
+    m_pipeline->stop();
+    m_renderThread.join();
+
+    glfwMakeContextCurrent( m_window->getHandle() );
+    getSystem< ShaderCompiler >()->setResolveOnRenderThread( false );
+
+    if ( const uint64_t dropped = m_pipeline->getDroppedFrames() ) {
+        Trace::message(
+            fmt::format( "Render thread dropped {} late frames.", dropped ) );
+    }
+
+    m_pipeline.reset();
+}
+
+/**
+ * @brief Draws published snapshots until the pipeline stops. Runs on the
+ * render thread, which owns the OpenGL context meanwhile.
+ */
+void Engine::renderLoop() {
+    ObjectRenderer* objRenderer = getSystem< ObjectRenderer >();
+    ShaderCompiler* shaderCompiler = getSystem< ShaderCompiler >();
+    FrameProfiler* profiler = getSystem< FrameProfiler >();
+
+    glfwMakeContextCurrent( m_window->getHandle() );
+
+    while ( const RenderSnapshot* snapshot = m_pipeline->beginRead() ) {
+        if ( m_headless ) {
+            m_headless->beginFrame();
+        }
+        profiler->beginFrame();
+
+        shaderCompiler->resolve();
+
+        {
+            FrameProfiler::Scope scope( profiler, "Objects" );
+            objRenderer->render( *snapshot );
+        }
+
+        profiler->endFrame();
+
+        if ( m_headless ) {
+            m_headless->endFrame();
+        } else {
+            m_window->swapBuffer();
+        }
+
+        m_pipeline->endRead();
     }
+
+    glfwMakeContextCurrent( nullptr );
 }
 
 /**
- * @brief Properly shuts all systems down on engine close.
+ * @brief Properly shuts all systems down on engine close, then destroys the
+ * window. Safe to call more than once.
  */
 void Engine::shutdown() {
-    // TODO: shutdown each of the systems
+    if ( !m_window ) {
+        return;
+    }
+
+    shutdownSystems();
+
+    // Nothing may touch OpenGL past this point
+    m_window.reset();
+}
+
+/**
+ * @brief Shuts the engine down and starts it again. The window and its OpenGL
+ * context are kept when the window settings match, which skips the slowest
+ * part of startup. Entities and update callbacks are cleared, so the scene has
+ * to be set up again.
+ * @param settings Window and run mode settings.
+ * @return StartupErrors indicating success or failure.
+ */
+enum StartupErrors Engine::restart( const EngineSettings& settings ) {
+    const bool keepWindow = m_window && settings.title == m_settings.title &&
+                            settings.width == m_settings.width &&
+                            settings.height == m_settings.height &&
+                            settings.fullscreen == m_settings.fullscreen &&
+                            settings.headless == m_settings.headless;
+
+    if ( keepWindow ) {
+        shutdownSystems();
+    } else {
+        shutdown();
+    }
+
+    return initialize( settings );
+}
+
+/**
+ * @brief Shuts systems down newest first and releases everything holding
+ * OpenGL objects, leaving the window and its context alive.
+ */
+void Engine::shutdownSystems() {
+    if ( m_pipeline ) {
+        stopRenderThread();
+    }
+
+    m_headless.reset();
+    m_recorder.reset();
+
+    // Systems look up the ones created before them while starting, so
+    // stopping newest first never leaves one using a stopped system
+    for ( auto it = m_systems.rbegin(); it != m_systems.rend(); ++it ) {
+        ( *it )->shutdown();
+    }
+
+    // Callbacks are bound to systems and entities that are about to go
+    updateCallbacks.clear();
+    fixedUpdateCallbacks.clear();
+
+    while ( !m_systems.empty() ) {
+        m_systems.pop_back();
+    }
+
+    // Window callbacks must not reach the deleted input devices
+    m_window->getInput() = WindowInput();
+
+    ResourceTracker::report();
 }
 
 /**
@@ -182,6 +524,12 @@ void Engine::shutdown() {
  */
 Window* Engine::getWindowHandle() { return m_window.get(); }
 
+/**
+ * @brief Get the settings the engine was started with.
+ * @return Reference to the settings.
+ */
+const EngineSettings& Engine::getSettings() const { return m_settings; }
+
 /**
  * @brief Get the singleton instance of the Engine.
  * @return Pointer to the Engine instance.
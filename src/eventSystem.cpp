@@ -8,6 +8,8 @@
  *
  */
 
+#include <atomic>
+
 #include "eventSystem.hpp"
 
 namespace SquirrelEngine {
@@ -15,18 +17,181 @@ namespace SquirrelEngine {
 /**
  * @brief Default constructor for Subscriber.
  */
-EventSystem::Subscriber::Subscriber()
-    : type( typeid( this ) ), listener( nullptr ), callback( nullptr ) {}
+EventSystem::Subscriber::Subscriber() : id( 0 ) {}
+
+/**
+ * @brief Constructs a Subscriber with id and delegate.
+ * @param t_id ID of the subscription.
+ * @param t_delegate Delegate to call with each event.
+ */
+EventSystem::Subscriber::Subscriber( const uint32_t t_id,
+                                     const EventDelegate& t_delegate )
+    : id( t_id ), delegate( t_delegate ) {}
 
 /**
- * @brief Constructs a Subscriber with type, listener, and callback.
- * @param t_type The type_index of the event.
- * @param t_listener Pointer to the listener object.
- * @param t_callback Callback function pointer.
+ * @brief Removes a subscription by swapping the last subscriber of the type
+ * into its place, so delivery order is not kept. Safe to call from inside a
+ * callback.
+ * @param handle Handle returned by subscribe.
+ * @return true if the subscription existed.
  */
-EventSystem::Subscriber::Subscriber( std::type_index t_type, Object* t_listener,
-                                     EventHandlingCallback t_callback )
-    : type( typeid( t_type ) ), listener( t_listener ), callback( t_callback ) {
+bool EventSystem::unsubscribe( const SubscriptionHandle handle ) {
+    if ( !handle.isValid() || handle.id >= m_slots.size() ) return false;
+
+    SubscriptionSlot& slot = m_slots[handle.id];
+    if ( slot.generation != handle.generation || slot.index == RemovedSlot ) {
+        return false;
+    }
+
+    const uint32_t index = slot.index;
+    slot.index = RemovedSlot;
+    ++slot.generation;
+    m_freeSlots.push_back( handle.id );
+
+    if ( index == BatchSlot ) {
+        return handle.type < m_queues.size() && m_queues[handle.type] &&
+               m_queues[handle.type]->removeBatchSubscriber( handle.id );
+    }
+
+    Bucket& bucket = m_buckets[handle.type];
+    auto& subscribers = bucket.subscribers;
+
+    // Moving subscribers while publishing would skip or repeat some, so only
+    // mark it and erase once the outermost publish returns
+    if ( m_publishDepth > 0 ) {
+        subscribers[index].delegate.reset();
+        ++bucket.removedCount;
+        m_hasRemovals = true;
+        return true;
+    }
+
+    swapRemove( subscribers, index );
+    return true;
+}
+
+/**
+ * @brief Drains the channels, then delivers every queued event. Each type's
+ * events go to its batch listeners as arrays, then one by one to its regular
+ * subscribers. Types are flushed in type ID order, events queued while
+ * flushing wait for the next flush unless their type hasn't been reached yet.
+ */
+void EventSystem::flush() {
+    drainChannels();
+
+    // Index instead of iterators, listeners may queue events of a new type
+    for ( size_t type = 0; type < m_flushers.size(); ++type ) {
+        if ( m_queues[type] && m_queues[type]->size() > 0 ) {
+            ( this->*m_flushers[type] )();
+        }
+    }
+}
+
+/**
+ * @brief Moves the events pushed to every channel into the queues. Called by
+ * flush, which makes it the sync point with producer threads.
+ */
+void EventSystem::drainChannels() {
+    for ( size_t type = 0; type < m_drainers.size(); ++type ) {
+        if ( m_drainers[type] ) {
+            ( this->*m_drainers[type] )();
+        }
+    }
+}
+
+/**
+ * @brief Hands out the next dense event type ID.
+ * @return New type ID.
+ */
+uint32_t EventSystem::nextTypeId() {
+    static std::atomic< uint32_t > nextId = 0;
+    return nextId++;
+}
+
+/**
+ * @brief Hands out a subscription ID, reusing a freed one if possible.
+ * @param type Dense ID of the event type.
+ * @param index Bucket index of the subscriber, or BatchSlot.
+ * @return Handle to the new subscription.
+ */
+SubscriptionHandle EventSystem::claimSlot( const uint32_t type,
+                                           const uint32_t index ) {
+    SubscriptionHandle handle;
+    handle.type = type;
+
+    if ( m_freeSlots.empty() ) {
+        handle.id = static_cast< uint32_t >( m_slots.size() );
+        m_slots.emplace_back();
+    } else {
+        handle.id = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    }
+
+    SubscriptionSlot& slot = m_slots[handle.id];
+    slot.index = index;
+    handle.generation = slot.generation;
+
+    return handle;
+}
+
+/**
+ * @brief Adds a subscriber to the bucket of an event type.
+ * @param type Dense ID of the event type.
+ * @param t_delegate Delegate to call with each event.
+ * @return Handle to the new subscription.
+ */
+SubscriptionHandle EventSystem::addSubscriber(
+    const uint32_t type, const EventDelegate& t_delegate ) {
+    if ( type >= m_buckets.size() ) {
+        m_buckets.resize( type + 1 );
+    }
+
+    auto& subscribers = m_buckets[type].subscribers;
+    const SubscriptionHandle handle =
+        claimSlot( type, static_cast< uint32_t >( subscribers.size() ) );
+    subscribers.emplace_back( handle.id, t_delegate );
+
+    return handle;
+}
+
+/**
+ * @brief Swap-removes subscribers that were unsubscribed during a publish.
+ */
+void EventSystem::compact() {
+    for ( Bucket& bucket : m_buckets ) {
+        auto& subscribers = bucket.subscribers;
+
+        for ( size_t i = 0; i < subscribers.size() && bucket.removedCount; ) {
+            if ( subscribers[i].delegate.isBound() ) {
+                ++i;
+                continue;
+            }
+
+            swapRemove( subscribers, i );
+            --bucket.removedCount;
+        }
+    }
+
+    m_hasRemovals = false;
+}
+
+/**
+ * @brief Moves the last subscriber into a removed one's place.
+ * @param subscribers Subscribers of one event type.
+ * @param index Index of the subscriber to remove.
+ */
+void EventSystem::swapRemove( std::vector< Subscriber >& subscribers,
+                              const size_t index ) {
+    if ( index + 1 != subscribers.size() ) {
+        subscribers[index] = subscribers.back();
+
+        // A subscriber removed during a publish may have had its ID reused
+        if ( subscribers[index].delegate.isBound() ) {
+            m_slots[subscribers[index].id].index =
+                static_cast< uint32_t >( index );
+        }
+    }
+
+    subscribers.pop_back();
 }
 
 } // namespace SquirrelEngine
@@ -0,0 +1,252 @@
+/**
+ *
+ * @file frameProfiler.cpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief Implements the FrameProfiler class, which times named passes of a
+ * frame on the CPU and GPU in SquirrelEngine.
+ * @date 2025-06-06
+ *
+ */
+
+#include <cstring>
+
+#include "frameProfiler.hpp"
+#include "utils/resource_tracker.hpp"
+
+namespace SquirrelEngine {
+
+/**
+ * @brief Weight of the newest sample in the smoothed timings.
+ */
+static constexpr double smoothing = 0.1;
+
+/**
+ * @brief Blends a new sample into a smoothed value.
+ * @param average Current smoothed value, 0 if there is none yet.
+ * @param value New sample.
+ * @return Updated smoothed value.
+ */
+static double smooth( const double average, const double value ) {
+    return ( average == 0.0 ) ? value : average + ( value - average ) * smoothing;
+}
+
+/**
+ * @brief Starts timing a pass.
+ * @param t_profiler Profiler to record into, may be nullptr.
+ * @param name Name of the pass, must outlive the profiler.
+ */
+FrameProfiler::Scope::Scope( FrameProfiler* t_profiler, const char* name )
+    : m_profiler( t_profiler ) {
+    if ( m_profiler ) m_profiler->beginScope( name );
+}
+
+/**
+ * @brief Stops timing the pass.
+ */
+FrameProfiler::Scope::~Scope() {
+    if ( m_profiler ) m_profiler->endScope();
+}
+
+/**
+ * @brief Default constructor for FrameProfiler.
+ */
+FrameProfiler::FrameProfiler() {}
+
+/**
+ * @brief Creates the query objects.
+ * @param t_owner Pointer to the Engine that owns this system.
+ * @return StartupErrors indicating success or failure.
+ */
+StartupErrors FrameProfiler::initialize( Engine* t_owner ) {
+    System::initialize( t_owner );
+
+    glGenQueries( static_cast< GLsizei >( m_queries.size() ),
+                  m_queries.data() );
+    ResourceTracker::created( GR_Query,
+                              static_cast< int >( m_queries.size() ) );
+    m_hasQueries = true;
+
+    return StartupErrors::SE_Success;
+}
+
+/**
+ * @brief Deletes the query objects.
+ */
+void FrameProfiler::shutdown() {
+    if ( !m_hasQueries ) return;
+
+    glDeleteQueries( static_cast< GLsizei >( m_queries.size() ),
+                     m_queries.data() );
+    ResourceTracker::released( GR_Query,
+                               static_cast< int >( m_queries.size() ) );
+    m_hasQueries = false;
+}
+
+/**
+ * @brief Resolves an old frame if its results are ready and starts timing a
+ * new one.
+ */
+void FrameProfiler::beginFrame() {
+    const int slot = m_frame % FrameLatency;
+
+    // The slot still holds the frame from FrameLatency frames ago
+    resolveFrame( slot );
+
+    m_frames[slot].scopeCount = 0;
+    m_stackDepth = 0;
+
+    beginScope( "Frame" );
+}
+
+/**
+ * @brief Stops timing the current frame.
+ */
+void FrameProfiler::endFrame() {
+    while ( m_stackDepth > 0 ) {
+        endScope();
+    }
+
+    ++m_frame;
+}
+
+/**
+ * @brief Starts timing a named pass. Passes may be nested.
+ * @param name Name of the pass, must outlive the profiler.
+ */
+void FrameProfiler::beginScope( const char* name ) {
+    if ( m_stackDepth >= MaxScopes ) return;
+
+    const int slot = m_frame % FrameLatency;
+    FrameRecord& frame = m_frames[slot];
+
+    // Out of scopes this frame, keep the stack balanced but record nothing
+    if ( frame.scopeCount >= MaxScopes ) {
+        m_stack[m_stackDepth++] = -1;
+        return;
+    }
+
+    const int index = frame.scopeCount++;
+    ScopeRecord& scope = frame.scopes[index];
+    scope.name = name;
+    scope.depth = m_stackDepth;
+
+    m_stack[m_stackDepth++] = index;
+
+    if ( m_hasQueries ) {
+        glQueryCounter( queryFor( slot, index, false ), GL_TIMESTAMP );
+    }
+    scope.start = std::chrono::steady_clock::now();
+}
+
+/**
+ * @brief Stops timing the innermost open pass.
+ */
+void FrameProfiler::endScope() {
+    if ( m_stackDepth <= 0 ) return;
+
+    const int index = m_stack[--m_stackDepth];
+    if ( index < 0 ) return;
+
+    const int slot = m_frame % FrameLatency;
+    ScopeRecord& scope = m_frames[slot].scopes[index];
+
+    const std::chrono::duration< double, std::milli > cpuTime =
+        std::chrono::steady_clock::now() - scope.start;
+    scope.cpuMs = cpuTime.count();
+
+    if ( m_hasQueries ) {
+        glQueryCounter( queryFor( slot, index, true ), GL_TIMESTAMP );
+    }
+}
+
+/**
+ * @brief Gets the timings of every pass seen so far, in the order they were
+ * first recorded.
+ * @return Reference to the list of pass timings.
+ */
+const std::vector< FrameProfiler::PassTiming >&
+FrameProfiler::getPassTimings() const {
+    return m_passes;
+}
+
+/**
+ * @brief Finds the timing of a pass by name.
+ * @param name Name of the pass.
+ * @return Pointer to the pass timing, or nullptr if never recorded.
+ */
+const FrameProfiler::PassTiming*
+FrameProfiler::findPass( const char* name ) const {
+    for ( const PassTiming& pass : m_passes ) {
+        if ( pass.name == name || std::strcmp( pass.name, name ) == 0 ) {
+            return &pass;
+        }
+    }
+
+    return nullptr;
+}
+
+/**
+ * @brief Gets how many frames were discarded because their GPU results weren't
+ * ready in time.
+ * @return Number of dropped frames.
+ */
+uint64_t FrameProfiler::getDroppedFrames() const { return m_droppedFrames; }
+
+/**
+ * @brief Reads the results of a frame in flight if they are available.
+ * @param slot Ring slot of the frame.
+ */
+void FrameProfiler::resolveFrame( const int slot ) {
+    const FrameRecord& frame = m_frames[slot];
+    if ( frame.scopeCount == 0 || !m_hasQueries ) return;
+
+    // Never wait on the GPU, drop the frame if any result is missing
+    for ( int i = 0; i < frame.scopeCount; ++i ) {
+        GLint available = GL_FALSE;
+        glGetQueryObjectiv( queryFor( slot, i, true ),
+                            GL_QUERY_RESULT_AVAILABLE, &available );
+        if ( available == GL_FALSE ) {
+            ++m_droppedFrames;
+            return;
+        }
+    }
+
+    for ( int i = 0; i < frame.scopeCount; ++i ) {
+        const ScopeRecord& scope = frame.scopes[i];
+
+        GLuint64 start = 0;
+        GLuint64 end = 0;
+        glGetQueryObjectui64v( queryFor( slot, i, false ), GL_QUERY_RESULT,
+                               &start );
+        glGetQueryObjectui64v( queryFor( slot, i, true ), GL_QUERY_RESULT,
+                               &end );
+        const double gpuMs = static_cast< double >( end - start ) / 1.0e6;
+
+        PassTiming* pass = const_cast< PassTiming* >( findPass( scope.name ) );
+        if ( !pass ) {
+            m_passes.push_back(
+                { scope.name, scope.depth, 0.0, 0.0, 0.0, 0.0 } );
+            pass = &m_passes.back();
+        }
+
+        pass->depth = scope.depth;
+        pass->cpuMs = scope.cpuMs;
+        pass->gpuMs = gpuMs;
+        pass->cpuAvgMs = smooth( pass->cpuAvgMs, scope.cpuMs );
+        pass->gpuAvgMs = smooth( pass->gpuAvgMs, gpuMs );
+    }
+}
+
+/**
+ * @brief Gets the timestamp query for a scope.
+ * @param slot Ring slot of the frame.
+ * @param scope Index of the scope.
+ * @param isEnd Whether to get the end (true) or start (false) query.
+ * @return Query object name.
+ */
+GLuint FrameProfiler::queryFor( const int slot, const int scope,
+                                const bool isEnd ) const {
+    return m_queries[( slot * MaxScopes + scope ) * 2 + ( isEnd ? 1 : 0 )];
+}
+
+} // namespace SquirrelEngine
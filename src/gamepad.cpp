@@ -0,0 +1,205 @@
+/**
+ *
+ * @file gamepad.cpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief Implements the Gamepad class, which represents a gamepad input device
+ * for SquirrelEngine.
+ * @date 2025-06-06
+ *
+ */
+
+#include <GLFW/glfw3.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include "engine.hpp"
+#include "gamepad.hpp"
+#include "inputSystem.hpp"
+
+namespace SquirrelEngine {
+
+/**
+ * @brief Rescales a magnitude between the dead zones and applies the response
+ * curve.
+ * @param magnitude Raw magnitude, 0 to 1.
+ * @param settings Dead zones and curve.
+ * @return Processed magnitude, 0 to 1.
+ */
+static float applyResponse( const float magnitude,
+                            const Gamepad::AxisSettings& settings ) {
+    if ( magnitude <= settings.innerDeadZone ) {
+        return 0.f;
+    }
+
+    const float range = settings.outerDeadZone - settings.innerDeadZone;
+    const float scaled =
+        ( range > 0.f )
+            ? std::min( ( magnitude - settings.innerDeadZone ) / range, 1.f )
+            : 1.f;
+
+    return ( settings.exponent == 1.f ) ? scaled
+                                        : std::pow( scaled, settings.exponent );
+}
+
+/**
+ * @brief Constructs a Gamepad.
+ * @param t_joystick GLFW joystick id to read.
+ */
+Gamepad::Gamepad( const int t_joystick ) : m_joystick( t_joystick ) {}
+
+/**
+ * @brief Reads the gamepad state and reports buttons that changed.
+ */
+void Gamepad::poll() {
+    if ( !getSystem< InputSystem >()->isLiveInputEnabled() ) {
+        return;
+    }
+
+    GLFWgamepadstate state;
+
+    if ( !glfwJoystickIsGamepad( m_joystick ) ||
+         !glfwGetGamepadState( m_joystick, &state ) ) {
+        // Release everything once when the gamepad goes away
+        if ( m_isConnected ) {
+            for ( int button = 0; button < GAMEPAD_BUTTON_LAST; ++button ) {
+                report( button, 0.f );
+            }
+            m_isConnected = false;
+        }
+        return;
+    }
+    m_isConnected = true;
+
+    for ( int button = 0; button <= GLFW_GAMEPAD_BUTTON_LAST; ++button ) {
+        report( button, ( state.buttons[button] == GLFW_PRESS ) ? 1.f : 0.f );
+    }
+
+    float leftX, leftY, rightX, rightY;
+    processStick( state.axes[GLFW_GAMEPAD_AXIS_LEFT_X],
+                  state.axes[GLFW_GAMEPAD_AXIS_LEFT_Y], leftX, leftY );
+    processStick( state.axes[GLFW_GAMEPAD_AXIS_RIGHT_X],
+                  state.axes[GLFW_GAMEPAD_AXIS_RIGHT_Y], rightX, rightY );
+
+    report( GAMEPAD_LEFT_X, leftX );
+    report( GAMEPAD_LEFT_Y, leftY );
+    report( GAMEPAD_RIGHT_X, rightX );
+    report( GAMEPAD_RIGHT_Y, rightY );
+
+    report( GAMEPAD_LEFT_TRIGGER,
+            processTrigger( state.axes[GLFW_GAMEPAD_AXIS_LEFT_TRIGGER] ) );
+    report( GAMEPAD_RIGHT_TRIGGER,
+            processTrigger( state.axes[GLFW_GAMEPAD_AXIS_RIGHT_TRIGGER] ) );
+
+    // GLFW reports up as negative Y
+    report( GAMEPAD_LEFT_STICK_LEFT, std::max( -leftX, 0.f ) );
+    report( GAMEPAD_LEFT_STICK_RIGHT, std::max( leftX, 0.f ) );
+    report( GAMEPAD_LEFT_STICK_UP, std::max( -leftY, 0.f ) );
+    report( GAMEPAD_LEFT_STICK_DOWN, std::max( leftY, 0.f ) );
+    report( GAMEPAD_RIGHT_STICK_LEFT, std::max( -rightX, 0.f ) );
+    report( GAMEPAD_RIGHT_STICK_RIGHT, std::max( rightX, 0.f ) );
+    report( GAMEPAD_RIGHT_STICK_UP, std::max( -rightY, 0.f ) );
+    report( GAMEPAD_RIGHT_STICK_DOWN, std::max( rightY, 0.f ) );
+}
+
+/**
+ * @brief Gets the state of a gamepad button or axis.
+ * @param button The button index.
+ * @return The state of the button as a float.
+ */
+const float Gamepad::getButtonState( const int button ) {
+    if ( button < 0 || GAMEPAD_BUTTON_LAST <= button ) {
+        Trace::message( "Button outside of range." );
+        return 0.f;
+    }
+
+    return m_buttonStates[button];
+}
+
+/**
+ * @brief Sets the state of a gamepad button or axis.
+ * @param button The button index.
+ * @param state The new state of the button.
+ */
+void Gamepad::setButtonState( const int button, const float state ) {
+    if ( button < 0 || GAMEPAD_BUTTON_LAST <= button ) {
+        Trace::message( "Button outside of range." );
+        return;
+    }
+
+    m_buttonStates[button] = state;
+}
+
+/**
+ * @brief Checks if the joystick is connected and has a gamepad mapping.
+ * @return true if the gamepad was read on the last poll.
+ */
+bool Gamepad::isConnected() const { return m_isConnected; }
+
+/**
+ * @brief Sets the radial dead zone and response curve of both sticks.
+ * @param settings Stick settings.
+ */
+void Gamepad::setStickSettings( const AxisSettings& settings ) {
+    m_stickSettings = settings;
+}
+
+/**
+ * @brief Sets the dead zone and response curve of both triggers.
+ * @param settings Trigger settings.
+ */
+void Gamepad::setTriggerSettings( const AxisSettings& settings ) {
+    m_triggerSettings = settings;
+}
+
+/**
+ * @brief Applies the radial dead zone and response curve to a stick.
+ * @param x Raw X axis.
+ * @param y Raw Y axis.
+ * @param outX Processed X axis.
+ * @param outY Processed Y axis.
+ */
+void Gamepad::processStick( const float x, const float y, float& outX,
+                            float& outY ) const {
+    // Radial so diagonals aren't snapped to the axes like a per-axis dead
+    // zone would
+    const float magnitude = std::sqrt( x * x + y * y );
+    const float response =
+        applyResponse( std::min( magnitude, 1.f ), m_stickSettings );
+
+    if ( response == 0.f ) {
+        outX = 0.f;
+        outY = 0.f;
+        return;
+    }
+
+    const float scale = response / magnitude;
+    outX = x * scale;
+    outY = y * scale;
+}
+
+/**
+ * @brief Applies the dead zone and response curve to a trigger.
+ * @param raw Raw trigger axis, -1 to 1.
+ * @return Processed trigger, 0 to 1.
+ */
+float Gamepad::processTrigger( const float raw ) const {
+    return applyResponse( ( raw + 1.f ) * 0.5f, m_triggerSettings );
+}
+
+/**
+ * @brief Reports a new button state to the InputSystem if it changed.
+ * @param button The button index.
+ * @param state The new state of the button.
+ */
+void Gamepad::report( const int button, const float state ) {
+    if ( m_buttonStates[button] == state ) {
+        return;
+    }
+
+    InputSystem* inputSystem = getSystem< InputSystem >();
+    inputSystem->setButtonState( this, button, state );
+    inputSystem->triggerAction( this, button, state );
+}
+
+} // namespace SquirrelEngine
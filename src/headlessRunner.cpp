@@ -0,0 +1,202 @@
+/**
+ *
+ * @file headlessRunner.cpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief Implements the HeadlessRunner class, which renders frames offscreen
+ * and records their timings for automated runs of SquirrelEngine.
+ * @date 2025-06-06
+ *
+ */
+
+#include <algorithm>
+#include <fstream>
+
+#include "core.hpp"
+#include "headlessRunner.hpp"
+#include "utils/image_writer.hpp"
+
+namespace SquirrelEngine {
+
+/**
+ * @brief Default constructor for HeadlessRunner.
+ */
+HeadlessRunner::HeadlessRunner() {}
+
+/**
+ * @brief Destructor for HeadlessRunner. Releases GL objects.
+ */
+HeadlessRunner::~HeadlessRunner() {
+    // Queries are only made once the framebuffer is complete
+    if ( m_queries[0] ) {
+        glDeleteQueries( static_cast< GLsizei >( m_queries.size() ),
+                         m_queries.data() );
+        ResourceTracker::released( GR_Query,
+                                   static_cast< int >( m_queries.size() ) );
+    }
+    if ( m_fbo ) {
+        glDeleteRenderbuffers( 1, &m_color );
+        glDeleteRenderbuffers( 1, &m_depth );
+        glDeleteFramebuffers( 1, &m_fbo );
+        ResourceTracker::released( GR_Renderbuffer, 2 );
+        ResourceTracker::released( GR_Framebuffer );
+    }
+}
+
+/**
+ * @brief Creates the framebuffer and timer queries.
+ * @param settings Engine settings with size and output files.
+ * @return true if the framebuffer is complete.
+ */
+bool HeadlessRunner::initialize( const EngineSettings& settings ) {
+    m_width = settings.width;
+    m_height = settings.height;
+    m_timingsFile = settings.timingsFile;
+    m_captureFile = settings.captureFile;
+
+    glGenRenderbuffers( 1, &m_color );
+    glBindRenderbuffer( GL_RENDERBUFFER, m_color );
+    glRenderbufferStorage( GL_RENDERBUFFER, GL_RGBA8, m_width, m_height );
+
+    glGenRenderbuffers( 1, &m_depth );
+    glBindRenderbuffer( GL_RENDERBUFFER, m_depth );
+    glRenderbufferStorage( GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, m_width,
+                           m_height );
+    glBindRenderbuffer( GL_RENDERBUFFER, 0 );
+
+    glGenFramebuffers( 1, &m_fbo );
+    ResourceTracker::created( GR_Renderbuffer, 2 );
+    ResourceTracker::created( GR_Framebuffer );
+    glBindFramebuffer( GL_FRAMEBUFFER, m_fbo );
+    glFramebufferRenderbuffer( GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                               GL_RENDERBUFFER, m_color );
+    glFramebufferRenderbuffer( GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT,
+                               GL_RENDERBUFFER, m_depth );
+
+    const GLenum status = glCheckFramebufferStatus( GL_FRAMEBUFFER );
+    glBindFramebuffer( GL_FRAMEBUFFER, 0 );
+
+    if ( status != GL_FRAMEBUFFER_COMPLETE ) {
+        Trace::message(
+            fmt::format( "Headless framebuffer incomplete: {:#x}", status ) );
+        return false;
+    }
+
+    glGenQueries( static_cast< GLsizei >( m_queries.size() ),
+                  m_queries.data() );
+    ResourceTracker::created( GR_Query,
+                              static_cast< int >( m_queries.size() ) );
+
+    if ( settings.frameCount > 0 ) {
+        m_timings.reserve( settings.frameCount );
+    }
+
+    return true;
+}
+
+/**
+ * @brief Binds the framebuffer and starts timing a frame.
+ */
+void HeadlessRunner::beginFrame() {
+    // Queries are reused every QueryLatency frames, read the old result first
+    if ( m_frame >= QueryLatency ) {
+        resolveGpuTime( m_frame - QueryLatency );
+    }
+
+    glBindFramebuffer( GL_FRAMEBUFFER, m_fbo );
+    glViewport( 0, 0, m_width, m_height );
+
+    const int slot = ( m_frame % QueryLatency ) * 2;
+    glQueryCounter( m_queries[slot], GL_TIMESTAMP );
+
+    m_timings.emplace_back();
+    m_frameStart = std::chrono::steady_clock::now();
+}
+
+/**
+ * @brief Stops timing the current frame.
+ */
+void HeadlessRunner::endFrame() {
+    const int slot = ( m_frame % QueryLatency ) * 2;
+    glQueryCounter( m_queries[slot + 1], GL_TIMESTAMP );
+
+    const std::chrono::duration< double, std::milli > cpuTime =
+        std::chrono::steady_clock::now() - m_frameStart;
+    m_timings[m_frame].cpuMs = cpuTime.count();
+
+    ++m_frame;
+}
+
+/**
+ * @brief Collects outstanding timings and writes the timing CSV and the
+ * capture PNG, if requested.
+ */
+void HeadlessRunner::finish() {
+    for ( int frame = std::max( 0, m_frame - QueryLatency ); frame < m_frame;
+          ++frame ) {
+        resolveGpuTime( frame );
+    }
+
+    if ( !m_timingsFile.empty() ) {
+        std::ofstream file( m_timingsFile, std::ofstream::out );
+        file << "Frame, CPU time (ms), GPU time (ms)\n";
+
+        for ( size_t i = 0; i < m_timings.size(); ++i ) {
+            file << i << "," << m_timings[i].cpuMs << ","
+                 << m_timings[i].gpuMs << "\n";
+        }
+    }
+
+    if ( !m_captureFile.empty() && m_frame > 0 ) {
+        capture( m_captureFile );
+    }
+
+    glBindFramebuffer( GL_FRAMEBUFFER, 0 );
+}
+
+/**
+ * @brief Gets the number of frames rendered so far.
+ * @return Frame count.
+ */
+int HeadlessRunner::getFrameCount() const { return m_frame; }
+
+/**
+ * @brief Reads the GPU time of a frame whose queries were issued earlier.
+ * @param frame Index of the frame.
+ */
+void HeadlessRunner::resolveGpuTime( const int frame ) {
+    const int slot = ( frame % QueryLatency ) * 2;
+
+    GLuint64 start = 0;
+    GLuint64 end = 0;
+    glGetQueryObjectui64v( m_queries[slot], GL_QUERY_RESULT, &start );
+    glGetQueryObjectui64v( m_queries[slot + 1], GL_QUERY_RESULT, &end );
+
+    m_timings[frame].gpuMs = static_cast< double >( end - start ) / 1.0e6;
+}
+
+/**
+ * @brief Writes the color attachment to a PNG file.
+ * @param filename Output file.
+ */
+void HeadlessRunner::capture( const std::string& filename ) {
+    const size_t rowSize = static_cast< size_t >( m_width ) * 4;
+    std::vector< unsigned char > pixels( rowSize * m_height );
+
+    glBindFramebuffer( GL_READ_FRAMEBUFFER, m_fbo );
+    glPixelStorei( GL_PACK_ALIGNMENT, 1 );
+    glReadPixels( 0, 0, m_width, m_height, GL_RGBA, GL_UNSIGNED_BYTE,
+                  pixels.data() );
+
+    // OpenGL rows start at the bottom
+    std::vector< unsigned char > flipped( pixels.size() );
+    for ( int y = 0; y < m_height; ++y ) {
+        std::copy_n( pixels.data() + ( m_height - 1 - y ) * rowSize, rowSize,
+                     flipped.data() + y * rowSize );
+    }
+
+    if ( !writePNG( filename, m_width, m_height, flipped.data() ) ) {
+        Trace::message( fmt::format( "Failed to write {}.", filename ) );
+    }
+}
+
+} // namespace SquirrelEngine
@@ -15,16 +15,17 @@ namespace SquirrelEngine {
 /**
  * @brief Default constructor for InputAction.
  */
-InputAction::InputAction() : amount( 0.f ), device( nullptr ) {}
+InputAction::InputAction()
+    : action( InvalidAction ), device( nullptr ), amount( 0.f ) {}
 
 /**
- * @brief Constructs an InputAction with type, device, and amount.
- * @param t_type The type of input action.
+ * @brief Constructs an InputAction with action, device, and amount.
+ * @param t_action Id of the triggered action.
  * @param t_device Pointer to the input device.
  * @param t_amount The amount or value of the input.
  */
-InputAction::InputAction( const std::string t_type, InputDevice* t_device,
+InputAction::InputAction( const ActionId t_action, InputDevice* t_device,
                           const float t_amount )
-    : type( t_type ), device( t_device ), amount( t_amount ) {}
+    : action( t_action ), device( t_device ), amount( t_amount ) {}
 
 } // namespace SquirrelEngine
@@ -0,0 +1,303 @@
+/**
+ *
+ * @file inputRecorder.cpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief Implements the InputRecorder class, which records input to a binary
+ * log and replays it for repeatable runs of SquirrelEngine.
+ * @date 2025-06-06
+ *
+ */
+
+#include <cstddef>
+#include <cstring>
+
+#include "core.hpp"
+#include "inputRecorder.hpp"
+
+namespace SquirrelEngine {
+
+/**
+ * @brief Identifies input logs.
+ */
+static constexpr char logMagic[4] = { 'S', 'Q', 'I', 'R' };
+
+/**
+ * @brief Version of the log format.
+ */
+static constexpr uint32_t logVersion = 2;
+
+/**
+ * @brief Default constructor for InputRecorder.
+ */
+InputRecorder::InputRecorder() {}
+
+/**
+ * @brief Destructor for InputRecorder. Finishes an open recording.
+ */
+InputRecorder::~InputRecorder() { finish(); }
+
+/**
+ * @brief Starts writing a log.
+ * @param filename Log file to create.
+ * @param deltaTime Frame time replays of this log will step by.
+ * @return true if the file was opened.
+ */
+bool InputRecorder::startRecording( const std::string& filename,
+                                    const float deltaTime ) {
+    m_file.open( filename, std::ofstream::out | std::ofstream::binary );
+    if ( !m_file ) {
+        Trace::message( fmt::format( "Unable to open {}.", filename ) );
+        return false;
+    }
+
+    m_deltaTime = deltaTime;
+    m_inputSystem = getSystem< InputSystem >();
+
+    // Pin where motion is measured from, so the replay's first delta is taken
+    // against the same position as the live one
+    vector2 origin( 0.f );
+    if ( Mouse* mouse = m_inputSystem->findInputDevice< Mouse >() ) {
+        origin = mouse->getMotionOrigin();
+        mouse->setMotionOrigin( origin );
+    }
+
+    // Frame count is filled in by finish
+    Header header;
+    std::memcpy( header.magic, logMagic, sizeof( logMagic ) );
+    header.version = logVersion;
+    header.deltaTime = m_deltaTime;
+    header.frameCount = 0;
+    header.motionOrigin[0] = origin.x;
+    header.motionOrigin[1] = origin.y;
+    m_file.write( reinterpret_cast< const char* >( &header ),
+                  sizeof( header ) );
+
+    m_inputSystem->setRecorder( this );
+    m_isRecording = true;
+
+    return true;
+}
+
+/**
+ * @brief Loads a log and disables live input.
+ * @param filename Log file to read.
+ * @return true if the log was read.
+ */
+bool InputRecorder::startReplay( const std::string& filename ) {
+    std::ifstream file( filename, std::ifstream::in | std::ifstream::binary );
+    if ( !file ) {
+        Trace::message( fmt::format( "Unable to open {}.", filename ) );
+        return false;
+    }
+
+    Header header;
+    file.read( reinterpret_cast< char* >( &header ), sizeof( header ) );
+    if ( !file ||
+         std::memcmp( header.magic, logMagic, sizeof( logMagic ) ) != 0 ||
+         header.version != logVersion ) {
+        Trace::message( fmt::format( "{} is not an input log.", filename ) );
+        return false;
+    }
+
+    file.seekg( 0, std::ifstream::end );
+    const size_t recordBytes =
+        static_cast< size_t >( file.tellg() ) - sizeof( Header );
+    file.seekg( sizeof( Header ), std::ifstream::beg );
+
+    m_records.resize( recordBytes / sizeof( Record ) );
+    file.read( reinterpret_cast< char* >( m_records.data() ),
+               m_records.size() * sizeof( Record ) );
+
+    // Cursor records index a vector2, so a corrupt log must not reach it
+    for ( const Record& record : m_records ) {
+        const bool isValid = record.type == RT_State ||
+                             record.type == RT_Action ||
+                             ( record.type == RT_Cursor && record.button <= 1 );
+        if ( !isValid ) {
+            Trace::message(
+                fmt::format( "{} has a corrupt record.", filename ) );
+            m_records.clear();
+            return false;
+        }
+    }
+
+    m_deltaTime = header.deltaTime;
+    m_frameCount = static_cast< int >( header.frameCount );
+    m_nextRecord = 0;
+
+    m_inputSystem = getSystem< InputSystem >();
+    m_inputSystem->setLiveInput( false );
+    m_isReplaying = true;
+
+    if ( Mouse* mouse = m_inputSystem->findInputDevice< Mouse >() ) {
+        mouse->setMotionOrigin(
+            vector2( header.motionOrigin[0], header.motionOrigin[1] ) );
+    }
+
+    return true;
+}
+
+/**
+ * @brief Sets the frame being recorded, or applies the recorded input of the
+ * frame when replaying. Call before polling window events.
+ * @param frame Index of the frame.
+ */
+void InputRecorder::beginInput( const int frame ) {
+    m_frame = frame;
+
+    if ( !m_isReplaying ) {
+        return;
+    }
+
+    Mouse* mouse = m_inputSystem->findInputDevice< Mouse >();
+    bool isCursorMoved = false;
+
+    for ( ; m_nextRecord < m_records.size(); ++m_nextRecord ) {
+        const Record& record = m_records[m_nextRecord];
+        if ( record.frame > static_cast< uint32_t >( frame ) ) {
+            break;
+        }
+
+        InputDevice* device = m_inputSystem->getDevice( record.device );
+        if ( !device ) {
+            continue;
+        }
+
+        switch ( record.type ) {
+        case RT_State:
+            m_inputSystem->setButtonState( device, record.button,
+                                           record.value );
+            break;
+        case RT_Action:
+            m_inputSystem->triggerAction( device, record.button,
+                                          record.value );
+            break;
+        case RT_Cursor:
+            m_lastCursor[record.button] = record.value;
+            isCursorMoved = true;
+            break;
+        }
+    }
+
+    // Only the frame's last position is logged, so replays give one motion
+    // sample per frame, stamped with the frame's time on the locked clock
+    if ( mouse && isCursorMoved ) {
+        mouse->driveCursor( m_lastCursor,
+                            static_cast< double >( frame ) * m_deltaTime );
+    }
+}
+
+/**
+ * @brief Records the cursor position once the frame's events are in. Call
+ * after polling window events.
+ */
+void InputRecorder::endInput() {
+    if ( !m_isRecording ) {
+        return;
+    }
+
+    Mouse* mouse = m_inputSystem->findInputDevice< Mouse >();
+    if ( !mouse ) {
+        return;
+    }
+
+    const vector2 cursor = mouse->getCursorPosition();
+    const int device = m_inputSystem->getDeviceIndex( mouse );
+
+    for ( int axis = 0; axis < 2; ++axis ) {
+        if ( cursor[axis] != m_lastCursor[axis] ) {
+            write( RT_Cursor, device, axis, cursor[axis] );
+        }
+    }
+    m_lastCursor = cursor;
+}
+
+/**
+ * @brief Records a device state change.
+ * @param device Device that changed.
+ * @param button Button index.
+ * @param state New state of the button.
+ */
+void InputRecorder::recordState( const InputDevice* device, const int button,
+                                 const float state ) {
+    if ( m_isRecording ) {
+        write( RT_State, m_inputSystem->getDeviceIndex( device ), button,
+               state );
+    }
+}
+
+/**
+ * @brief Records an input action.
+ * @param device Device that triggered the action.
+ * @param button Button index.
+ * @param amount Amount passed to the action.
+ */
+void InputRecorder::recordAction( const InputDevice* device, const int button,
+                                  const float amount ) {
+    if ( m_isRecording ) {
+        write( RT_Action, m_inputSystem->getDeviceIndex( device ), button,
+               amount );
+    }
+}
+
+/**
+ * @brief Writes the frame count into the log and closes it.
+ */
+void InputRecorder::finish() {
+    if ( !m_isRecording ) {
+        return;
+    }
+
+    const uint32_t frameCount = static_cast< uint32_t >( m_frame + 1 );
+    m_file.seekp( offsetof( Header, frameCount ), std::ofstream::beg );
+    m_file.write( reinterpret_cast< const char* >( &frameCount ),
+                  sizeof( frameCount ) );
+    m_file.close();
+
+    m_inputSystem->setRecorder( nullptr );
+    m_isRecording = false;
+}
+
+/**
+ * @brief Checks if a log is being played back.
+ * @return true while replaying.
+ */
+bool InputRecorder::isReplaying() const { return m_isReplaying; }
+
+/**
+ * @brief Gets the frame time stored in the log.
+ * @return Delta time in seconds.
+ */
+float InputRecorder::getDeltaTime() const { return m_deltaTime; }
+
+/**
+ * @brief Gets the number of frames in the log.
+ * @return Recorded frame count.
+ */
+int InputRecorder::getFrameCount() const { return m_frameCount; }
+
+/**
+ * @brief Appends a record for the current frame.
+ * @param type Kind of record.
+ * @param device Device index.
+ * @param button Button index.
+ * @param value Recorded value.
+ */
+void InputRecorder::write( const RecordType type, const int device,
+                           const int button, const float value ) {
+    if ( device < 0 ) {
+        return;
+    }
+
+    Record record;
+    record.frame = static_cast< uint32_t >( m_frame );
+    record.type = type;
+    record.device = static_cast< uint8_t >( device );
+    record.button = static_cast< uint16_t >( button );
+    record.value = value;
+
+    m_file.write( reinterpret_cast< const char* >( &record ),
+                  sizeof( record ) );
+}
+
+} // namespace SquirrelEngine
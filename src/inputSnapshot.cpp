@@ -0,0 +1,168 @@
+/**
+ *
+ * @file inputSnapshot.cpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief Implements the InputSnapshot class, which holds the input state of a
+ * single frame in SquirrelEngine.
+ * @date 2025-06-06
+ *
+ */
+
+#include "inputSnapshot.hpp"
+
+namespace SquirrelEngine {
+
+/**
+ * @brief Gets the frame the snapshot was captured on.
+ * @return Frame number, 0 before the first capture.
+ */
+uint64_t InputSnapshot::getFrame() const { return m_frame; }
+
+/**
+ * @brief Gets the state of an action.
+ * @param action Id of the action.
+ * @return State of the action, 0 for unknown ids.
+ */
+float InputSnapshot::getActionState( const ActionId action ) const {
+    return ( action < m_actions.size() ) ? m_actions[action].value : 0.f;
+}
+
+/**
+ * @brief Gets how much an action changed since the previous snapshot.
+ * @param action Id of the action.
+ * @return Change in state, useful for analog axes.
+ */
+float InputSnapshot::getActionDelta( const ActionId action ) const {
+    if ( action >= m_actions.size() ) {
+        return 0.f;
+    }
+
+    return m_actions[action].value - m_actions[action].previous;
+}
+
+/**
+ * @brief Checks if an action is active.
+ * @param action Id of the action.
+ * @return true if the state is non-zero.
+ */
+bool InputSnapshot::isHeld( const ActionId action ) const {
+    return getActionState( action ) != 0.f;
+}
+
+/**
+ * @brief Checks if an action became active during the frame.
+ * @param action Id of the action.
+ * @return true if the action was pressed at least once.
+ */
+bool InputSnapshot::wasPressed( const ActionId action ) const {
+    return action < m_actions.size() && m_actions[action].presses > 0;
+}
+
+/**
+ * @brief Checks if an action stopped being active during the frame.
+ * @param action Id of the action.
+ * @return true if the action was released at least once.
+ */
+bool InputSnapshot::wasReleased( const ActionId action ) const {
+    return action < m_actions.size() && m_actions[action].releases > 0;
+}
+
+/**
+ * @brief Gets the state of a device button.
+ * @param device Pointer to the input device.
+ * @param button Button index.
+ * @return State of the button, 0 if out of range.
+ */
+float InputSnapshot::getButtonState( const InputDevice* device,
+                                     const int button ) const {
+    const int index = findButton( device, button );
+    return ( index >= 0 ) ? m_buttons[index] : 0.f;
+}
+
+/**
+ * @brief Gets how much a device button changed since the previous snapshot.
+ * @param device Pointer to the input device.
+ * @param button Button index.
+ * @return Change in state.
+ */
+float InputSnapshot::getButtonDelta( const InputDevice* device,
+                                     const int button ) const {
+    const int index = findButton( device, button );
+    return ( index >= 0 ) ? m_buttons[index] - m_previousButtons[index] : 0.f;
+}
+
+/**
+ * @brief Checks if a device button is down.
+ * @param device Pointer to the input device.
+ * @param button Button index.
+ * @return true if the state is non-zero.
+ */
+bool InputSnapshot::isButtonHeld( const InputDevice* device,
+                                  const int button ) const {
+    return getButtonState( device, button ) != 0.f;
+}
+
+/**
+ * @brief Checks if a device button went down since the previous snapshot.
+ * @param device Pointer to the input device.
+ * @param button Button index.
+ * @return true if the button is down now and wasn't before.
+ */
+bool InputSnapshot::wasButtonPressed( const InputDevice* device,
+                                      const int button ) const {
+    const int index = findButton( device, button );
+    return index >= 0 && m_buttons[index] != 0.f &&
+           m_previousButtons[index] == 0.f;
+}
+
+/**
+ * @brief Checks if a device button went up since the previous snapshot.
+ * @param device Pointer to the input device.
+ * @param button Button index.
+ * @return true if the button is up now and wasn't before.
+ */
+bool InputSnapshot::wasButtonReleased( const InputDevice* device,
+                                       const int button ) const {
+    const int index = findButton( device, button );
+    return index >= 0 && m_buttons[index] == 0.f &&
+           m_previousButtons[index] != 0.f;
+}
+
+/**
+ * @brief Gets the cursor position.
+ * @return Cursor position in window coordinates.
+ */
+const vector2& InputSnapshot::getCursorPosition() const { return m_cursor; }
+
+/**
+ * @brief Gets the summed motion of every cursor event in the frame.
+ * @return Cursor delta in window coordinates.
+ */
+const vector2& InputSnapshot::getCursorDelta() const { return m_cursorDelta; }
+
+/**
+ * @brief Finds a device button in the button arrays.
+ * @param device Pointer to the input device.
+ * @param button Button index.
+ * @return Index into the button arrays, or -1 if out of range.
+ */
+int InputSnapshot::findButton( const InputDevice* device,
+                               const int button ) const {
+    for ( size_t i = 0; i < m_devices.size(); ++i ) {
+        if ( m_devices[i] != device ) {
+            continue;
+        }
+
+        const uint32_t first = m_deviceOffsets[i];
+        const uint32_t count = m_deviceOffsets[i + 1] - first;
+        if ( button < 0 || static_cast< uint32_t >( button ) >= count ) {
+            return -1;
+        }
+
+        return static_cast< int >( first ) + button;
+    }
+
+    return -1;
+}
+
+} // namespace SquirrelEngine
@@ -8,23 +8,56 @@
  *
  */
 
+#include <fmt/core.h>
+
 #include "engine.hpp"
 #include "eventSystem.hpp"
 #include "inputAction.hpp"
+#include "inputRecorder.hpp"
 #include "inputSystem.hpp"
+#include "mouse.hpp"
+#include "utils/trace.hpp"
 
 namespace SquirrelEngine {
 
 /**
- * @brief Updates the input system and all input devices.
+ * @brief Sets the owning engine. The engine updates input itself right after
+ * window events are polled, so no update callback is registered.
+ * @param t_owner Pointer to the Engine that owns this system.
+ * @return StartupErrors indicating success or failure.
+ */
+StartupErrors InputSystem::initialize( Engine* t_owner ) {
+    owner = t_owner;
+
+    return StartupErrors::SE_Success;
+}
+
+/**
+ * @brief Polls devices, captures this frame's snapshot, then updates all input
+ * devices.
  * @param delta Time elapsed since last update.
  */
 void InputSystem::update( const float ) {
+    for ( auto& device : m_devices ) {
+        device->poll();
+    }
+
+    captureSnapshot();
+
     for ( auto it = m_devices.begin(); it != m_devices.end(); ++it ) {
         ( *it )->update();
     }
 }
 
+/**
+ * @brief Gets the most recently published snapshot. Safe to call from any
+ * thread, the snapshot stays valid until the end of the next frame.
+ * @return Reference to the snapshot.
+ */
+const InputSnapshot& InputSystem::getSnapshot() const {
+    return *m_published.load( std::memory_order_acquire );
+}
+
 /**
  * @brief Finds an input device by type and optional offset.
  * @param type The device type (see InputDeviceType).
@@ -47,26 +80,163 @@ InputDevice* InputSystem::findInputDevice( const int type, const int offset ) {
     return nullptr;
 }
 
+/**
+ * @brief Gets the index of a device, used to refer to it in input logs.
+ * @param device Pointer to the input device.
+ * @return Index of the device, or -1 if it isn't owned by this system.
+ */
+int InputSystem::getDeviceIndex( const InputDevice* device ) const {
+    for ( size_t i = 0; i < m_devices.size(); ++i ) {
+        if ( m_devices[i].get() == device ) {
+            return static_cast< int >( i );
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * @brief Gets a device by index.
+ * @param index Index returned by getDeviceIndex.
+ * @return Pointer to the device, or nullptr if out of range.
+ */
+InputDevice* InputSystem::getDevice( const int index ) {
+    if ( index < 0 || static_cast< size_t >( index ) >= m_devices.size() ) {
+        return nullptr;
+    }
+
+    return m_devices[index].get();
+}
+
+/**
+ * @brief Sets the state of a device's button from live input, recording it if
+ * a recording is running.
+ * @param device Pointer to the input device.
+ * @param button Button index.
+ * @param state New state of the button.
+ */
+void InputSystem::setButtonState( InputDevice* device, const int button,
+                                  const float state ) {
+    device->setButtonState( button, state );
+    refreshActions( device, button );
+
+    if ( m_recorder ) {
+        m_recorder->recordState( device, button, state );
+    }
+}
+
+/**
+ * @brief Sets the recorder that live input and actions are written to.
+ * @param recorder Recorder to write to, nullptr to stop recording.
+ */
+void InputSystem::setRecorder( InputRecorder* recorder ) {
+    m_recorder = recorder;
+}
+
+/**
+ * @brief Enables or disables input from the window, e.g. while a recording is
+ * replayed.
+ * @param enabled Whether device callbacks should change input state.
+ */
+void InputSystem::setLiveInput( const bool enabled ) { m_liveInput = enabled; }
+
+/**
+ * @brief Checks if input from the window is used.
+ * @return true if device callbacks should change input state.
+ */
+bool InputSystem::isLiveInputEnabled() const { return m_liveInput; }
+
+/**
+ * @brief Interns an action name, creating the action if it doesn't exist.
+ * @param name Name of the action.
+ * @return Id of the action, or InvalidAction if the name collides with another
+ * action's hash.
+ */
+ActionId InputSystem::internAction( const ActionName& name ) {
+    auto it = m_actionIds.find( name.hash );
+    if ( it != m_actionIds.end() ) {
+        if ( m_actionNames[it->second] != name.name ) {
+            Trace::message( fmt::format( "Actions {} and {} have the same hash.",
+                                         m_actionNames[it->second],
+                                         name.name ) );
+            return InvalidAction;
+        }
+
+        return it->second;
+    }
+
+    const ActionId action = static_cast< ActionId >( m_actionStates.size() );
+    m_actionStates.push_back( 0.f );
+    m_actionPresses.push_back( 0 );
+    m_actionReleases.push_back( 0 );
+    m_actionNames.emplace_back( name.name );
+    m_actionMappings.emplace_back();
+    m_actionIds.emplace( name.hash, action );
+
+    return action;
+}
+
+/**
+ * @brief Finds an interned action.
+ * @param name Name of the action.
+ * @return Id of the action, or InvalidAction if it was never interned.
+ */
+ActionId InputSystem::findAction( const ActionName& name ) const {
+    auto it = m_actionIds.find( name.hash );
+    if ( it == m_actionIds.end() ) {
+        return InvalidAction;
+    }
+
+    return it->second;
+}
+
+/**
+ * @brief Gets the name an action was interned with.
+ * @param action Id of the action.
+ * @return Name of the action, empty for unknown ids.
+ */
+const std::string& InputSystem::getActionName( const ActionId action ) const {
+    static const std::string unknown;
+
+    if ( action >= m_actionNames.size() ) {
+        return unknown;
+    }
+
+    return m_actionNames[action];
+}
+
+/**
+ * @brief Gets the number of interned actions.
+ * @return Action count.
+ */
+size_t InputSystem::getActionCount() const { return m_actionStates.size(); }
+
 /**
  * @brief Registers an action mapping for a device and button.
  * @param device Pointer to the input device.
  * @param button Button index.
  * @param name Name of the action.
+ * @return Id of the action, or InvalidAction on failure.
  */
-void InputSystem::registerActionMapping( InputDevice* device, const int button,
-                                         const std::string name ) {
-    auto it = m_actions.find( name );
-    if ( it == m_actions.end() ) {
-        m_actions[name] = std::vector< std::unique_ptr< ActionMapping > >();
+ActionId InputSystem::registerActionMapping( InputDevice* device,
+                                             const int button,
+                                             const ActionName& name ) {
+    const ActionId action = internAction( name );
+    if ( action == InvalidAction || !device ) {
+        return InvalidAction;
     }
 
-    m_actions[name].emplace_back(
-        std::make_unique< ActionMapping >( name, device, button ) );
-    m_deviceActions[device].push_back( m_actions[name].back().get() );
+    m_actionMappings[action].push_back( { device, button } );
+    m_deviceActions[device].push_back( { button, action } );
+
+    refreshAction( action );
+
+    return action;
 }
 
 /**
- * @brief Triggers an action for a device and button with a given amount.
+ * @brief Triggers an action for a device and button with a given amount. The
+ * InputAction events are queued on the EventSystem.
  * @param device Pointer to the input device.
  * @param button Button index.
  * @param amount Value or amount of the action.
@@ -75,44 +245,133 @@ void InputSystem::triggerAction( InputDevice* device, const int button,
                                  const float amount ) {
     EventSystem* eventSystem = owner->getSystem< EventSystem >();
 
-    auto actionMappingIt = m_deviceActions.find( device );
-    if ( actionMappingIt == m_deviceActions.end() ) {
-        return;
+    if ( m_recorder ) {
+        m_recorder->recordAction( device, button, amount );
     }
 
-    auto& actionList = actionMappingIt->second;
-
-    for ( auto it = actionList.begin(); it != actionList.end(); ++it ) {
-        ActionMapping* mapping = ( *it );
+    auto bindingIt = m_deviceActions.find( device );
+    if ( bindingIt == m_deviceActions.end() ) {
+        return;
+    }
 
-        if ( mapping->device == device && mapping->button == button ) {
-            eventSystem->publish( std::make_unique< InputAction >(
-                                      mapping->action, device, amount )
-                                      .get() );
+    for ( const DeviceBinding& binding : bindingIt->second ) {
+        // Delivered with the rest of the frame's input on the next flush
+        if ( binding.button == button ) {
+            eventSystem->enqueue< InputAction >( binding.action, device,
+                                                 amount );
         }
     }
 }
 
 /**
- * @brief Gets the current state of an action.
- * @param action Name of the action.
+ * @brief Gets the current state of an action by name. Prefer caching the
+ * ActionId for queries made every frame.
+ * @param name Name of the action.
  * @return The state of the action as a float.
  */
-const float InputSystem::getActionState( const std::string action ) {
-    auto thisAction = m_actions.find( action );
-    if ( thisAction == m_actions.end() ) {
-        return 0.f;
+float InputSystem::getActionState( const ActionName& name ) const {
+    return getActionState( findAction( name ) );
+}
+
+/**
+ * @brief Recomputes the state of every action fed by a device button.
+ * @param device Pointer to the input device.
+ * @param button Button index.
+ */
+void InputSystem::refreshActions( InputDevice* device, const int button ) {
+    auto bindingIt = m_deviceActions.find( device );
+    if ( bindingIt == m_deviceActions.end() ) {
+        return;
     }
 
-    auto& mappingList = thisAction->second;
+    for ( const DeviceBinding& binding : bindingIt->second ) {
+        if ( binding.button == button ) {
+            refreshAction( binding.action );
+        }
+    }
+}
 
+/**
+ * @brief Recomputes the state of an action from its mappings.
+ * @param action Id of the action.
+ */
+void InputSystem::refreshAction( const ActionId action ) {
     float value = 0.f;
-    for ( auto it = mappingList.begin(); it != mappingList.end(); ++it ) {
-        ActionMapping* mapping = ( *it ).get();
-        value += mapping->device->getButtonState( mapping->button );
+    for ( const ActionMapping& mapping : m_actionMappings[action] ) {
+        value += mapping.device->getButtonState( mapping.button );
+    }
+
+    // Count edges so presses shorter than a frame still reach the snapshot
+    const float previous = m_actionStates[action];
+    if ( previous == 0.f && value != 0.f ) {
+        ++m_actionPresses[action];
+    } else if ( previous != 0.f && value == 0.f ) {
+        ++m_actionReleases[action];
+    }
+
+    m_actionStates[action] = value;
+}
+
+/**
+ * @brief Fills the snapshot that isn't published and publishes it.
+ */
+void InputSystem::captureSnapshot() {
+    const InputSnapshot& front = *m_published.load( std::memory_order_relaxed );
+    InputSnapshot& back =
+        ( &front == &m_snapshots[0] ) ? m_snapshots[1] : m_snapshots[0];
+
+    back.m_frame = ++m_frame;
+
+    // Sizes only change when actions or devices are added, so steady state
+    // captures don't allocate
+    back.m_actions.resize( m_actionStates.size() );
+    for ( size_t i = 0; i < m_actionStates.size(); ++i ) {
+        InputSnapshot::ActionSample& sample = back.m_actions[i];
+        sample.previous =
+            ( i < front.m_actions.size() ) ? front.m_actions[i].value : 0.f;
+        sample.value = m_actionStates[i];
+        sample.presses = m_actionPresses[i];
+        sample.releases = m_actionReleases[i];
+
+        m_actionPresses[i] = 0;
+        m_actionReleases[i] = 0;
+    }
+
+    back.m_devices.resize( m_devices.size() );
+    back.m_deviceOffsets.resize( m_devices.size() + 1 );
+
+    uint32_t buttonCount = 0;
+    for ( size_t i = 0; i < m_devices.size(); ++i ) {
+        back.m_devices[i] = m_devices[i].get();
+        back.m_deviceOffsets[i] = buttonCount;
+        buttonCount += static_cast< uint32_t >( m_devices[i]->getButtonCount() );
+    }
+    back.m_deviceOffsets[m_devices.size()] = buttonCount;
+
+    if ( front.m_buttons.size() == buttonCount ) {
+        back.m_previousButtons.assign( front.m_buttons.begin(),
+                                       front.m_buttons.end() );
+    } else {
+        back.m_previousButtons.assign( buttonCount, 0.f );
+    }
+
+    back.m_buttons.resize( buttonCount );
+    for ( size_t i = 0; i < m_devices.size(); ++i ) {
+        InputDevice* device = m_devices[i].get();
+        const uint32_t first = back.m_deviceOffsets[i];
+        const int count = device->getButtonCount();
+
+        for ( int button = 0; button < count; ++button ) {
+            back.m_buttons[first + button] = device->getButtonState( button );
+        }
+    }
+
+    if ( Mouse* mouse = findInputDevice< Mouse >() ) {
+        back.m_cursor = mouse->getCursorPosition();
+        back.m_cursorDelta = mouse->getMotionDelta();
     }
 
-    return value;
+    m_published.store( &back, std::memory_order_release );
 }
 
 } // namespace SquirrelEngine
@@ -1,20 +1,135 @@
 
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
 #include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
 
 #include "core.hpp"
 #include "utils/crash_handler.hpp"
 
-int main( int, char** ) {
-    using namespace SquirrelEngine;
+/**
+ * @brief Reads engine settings from the command line.
+ *
+ * --headless               Render offscreen, uncapped (600 frames by default)
+ * --frames <count>         Stop after the given number of frames
+ * --fps <rate>             Frame limit, 0 for uncapped (windowed only)
+ * --tick-rate <rate>       Fixed updates per second
+ * --size <width> <height>  Window/framebuffer size
+ * --timings <file.csv>     Write per-frame CPU/GPU timings (headless)
+ * --capture <file.png>     Write the last frame to an image (headless)
+ * --record <file.log>      Record input to a log
+ * --replay <file.log>      Replay a recorded log with a fixed frame time
+ * --render-thread          Draw on a render thread pipelined with simulation
+ * --frames-ahead <count>   Frames the simulation may run ahead (1 or 2)
+ * --drop-late-frames       Replace frames the render thread fell behind on
+ * --stress <count>         Add a grid of spinning cubes as a heavy scene
+ * --runs <count>           Restart the engine in place between runs
+ * --partition <cells>      Stream a square grid of cells around the camera
+ * --cell-memory <mb>       Memory ceiling of the streamed cells
+ * --activation-budget <ms> Time spent activating cells per frame
+ * --scene <file>           Load a saved scene into its own world
+ * --save-scene <file>      Save the persistent world, as text if .txt
+ *
+ * @param argc Argument count
+ * @param argv Argument values
+ * @param stressCount Set to the number of stress cubes to add
+ * @param runCount Set to the number of times to run the scene
+ * @param partitionSize Set to the cells per side of the streamed grid
+ * @param partition Set to the world partition budgets
+ * @param sceneFile Set to the scene to load
+ * @param saveSceneFile Set to the file to save the scene to
+ * @return Settings to start the engine with
+ */
+static SquirrelEngine::EngineSettings
+parseArguments( int argc, char** argv, int& stressCount, int& runCount,
+                int& partitionSize,
+                SquirrelEngine::PartitionSettings& partition,
+                std::string& sceneFile, std::string& saveSceneFile ) {
+    SquirrelEngine::EngineSettings settings;
 
-    setupDump();
+    for ( int i = 1; i < argc; ++i ) {
+        const std::string_view arg = argv[i];
+        const int remaining = argc - i - 1;
 
-    Engine* engineInstance = Engine::instance();
-    if ( engineInstance->initialize() != StartupErrors::SE_Success ) {
-        Trace::message( "Failed to start." );
-        return EXIT_FAILURE;
+        if ( arg == "--headless" ) {
+            settings.headless = true;
+        } else if ( arg == "--frames" && remaining >= 1 ) {
+            settings.frameCount = std::atoi( argv[++i] );
+        } else if ( arg == "--fps" && remaining >= 1 ) {
+            settings.targetFrameRate =
+                static_cast< float >( std::atof( argv[++i] ) );
+        } else if ( arg == "--tick-rate" && remaining >= 1 ) {
+            const float rate = static_cast< float >( std::atof( argv[++i] ) );
+            if ( rate > 0.f ) {
+                settings.fixedDeltaTime = 1.f / rate;
+            }
+        } else if ( arg == "--size" && remaining >= 2 ) {
+            settings.width = std::atoi( argv[++i] );
+            settings.height = std::atoi( argv[++i] );
+        } else if ( arg == "--timings" && remaining >= 1 ) {
+            settings.timingsFile = argv[++i];
+        } else if ( arg == "--capture" && remaining >= 1 ) {
+            settings.captureFile = argv[++i];
+        } else if ( arg == "--record" && remaining >= 1 ) {
+            settings.recordFile = argv[++i];
+        } else if ( arg == "--replay" && remaining >= 1 ) {
+            settings.replayFile = argv[++i];
+        } else if ( arg == "--render-thread" ) {
+            settings.renderThread = true;
+        } else if ( arg == "--frames-ahead" && remaining >= 1 ) {
+            settings.maxFramesAhead = std::atoi( argv[++i] );
+        } else if ( arg == "--drop-late-frames" ) {
+            settings.dropLateFrames = true;
+        } else if ( arg == "--stress" && remaining >= 1 ) {
+            stressCount = std::atoi( argv[++i] );
+        } else if ( arg == "--runs" && remaining >= 1 ) {
+            runCount = std::max( std::atoi( argv[++i] ), 1 );
+        } else if ( arg == "--partition" && remaining >= 1 ) {
+            partitionSize = std::max( std::atoi( argv[++i] ), 0 );
+        } else if ( arg == "--cell-memory" && remaining >= 1 ) {
+            partition.memoryBudget =
+                static_cast< size_t >( std::max( std::atoi( argv[++i] ), 0 ) );
+        } else if ( arg == "--activation-budget" && remaining >= 1 ) {
+            partition.activationBudget =
+                static_cast< float >( std::atof( argv[++i] ) );
+        } else if ( arg == "--scene" && remaining >= 1 ) {
+            sceneFile = argv[++i];
+        } else if ( arg == "--save-scene" && remaining >= 1 ) {
+            saveSceneFile = argv[++i];
+        } else {
+            SquirrelEngine::Trace::message(
+                fmt::format( "Unknown argument {}.", arg ) );
+        }
+    }
+
+    // Replays run for the length of the log instead
+    if ( settings.headless && settings.frameCount == 0 &&
+         settings.replayFile.empty() ) {
+        settings.frameCount = 600;
     }
 
+    return settings;
+}
+
+/**
+ * @brief Binds the default controls and creates the demo scene. Runs again
+ * after every restart, which clears both.
+ *
+ * @param stressCount Number of stress cubes to add
+ * @param partitionSize Cells per side of the streamed grid, 0 for none
+ * @param partition World partition budgets
+ * @param sceneFile Saved scene to load, empty for none
+ */
+static void setupScene( const int stressCount, const int partitionSize,
+                        const SquirrelEngine::PartitionSettings& partition,
+                        const std::string& sceneFile ) {
+    using namespace SquirrelEngine;
+
+    Engine* engineInstance = Engine::instance();
+
     // Init inputs
     InputSystem* inputSystem = getSystem< InputSystem >();
     Keyboard* keyboard = inputSystem->findInputDevice< Keyboard >();
@@ -33,11 +148,33 @@ int main( int, char** ) {
     // Engine binds
     inputSystem->registerActionMapping( keyboard, KEY_ESCAPE, "close window" );
 
+    // Gamepad binds, summed with the keyboard
+    Gamepad* gamepad = inputSystem->findInputDevice< Gamepad >();
+    inputSystem->registerActionMapping( gamepad, GAMEPAD_LEFT_STICK_UP,
+                                        "move forward" );
+    inputSystem->registerActionMapping( gamepad, GAMEPAD_LEFT_STICK_DOWN,
+                                        "move backward" );
+    inputSystem->registerActionMapping( gamepad, GAMEPAD_LEFT_STICK_LEFT,
+                                        "move left" );
+    inputSystem->registerActionMapping( gamepad, GAMEPAD_LEFT_STICK_RIGHT,
+                                        "move right" );
+    inputSystem->registerActionMapping( gamepad, GAMEPAD_RIGHT_TRIGGER,
+                                        "move up" );
+    inputSystem->registerActionMapping( gamepad, GAMEPAD_LEFT_TRIGGER,
+                                        "move down" );
+    inputSystem->registerActionMapping( gamepad, GAMEPAD_LEFT_BUMPER,
+                                        "enable camera movement" );
+    inputSystem->registerActionMapping( gamepad, GAMEPAD_BACK,
+                                        "close window" );
+
     // Mouse setup
-    // inputSystem->createInputDevice< Mouse >();
+    Mouse* mouse = inputSystem->findInputDevice< Mouse >();
+    mouse->setRawMotion( true );
 
-    World* worldInstance = World::instance();
+    WorldManager* worldManager = getSystem< WorldManager >();
+    World* worldInstance = worldManager->getPersistentWorld();
     Entity* camera = worldInstance->createEntity( "Main camera" );
+    worldManager->setCamera( worldInstance->getHandle( camera ) );
     CameraComponent* cameraComp = camera->createComponent< CameraComponent >();
 
     Window* windowHandle = engineInstance->getWindowHandle();
@@ -55,7 +192,130 @@ int main( int, char** ) {
     cubeModel->initShader( "shaders/base.vert", "shaders/base.frag" );
     // cube->transform.setScale( vector3( 0.5f ) );
 
-    engineInstance->update();
+    // Synthetic heavy scene for comparing serial and pipelined rendering
+    if ( stressCount > 0 ) {
+        const int side =
+            static_cast< int >( std::ceil( std::sqrt( stressCount ) ) );
+
+        // Every cube draws the one mesh the prefab uploaded
+        PrefabDesc stressDesc;
+        stressDesc.name = "Stress";
+        stressDesc.scale = vector3( 0.5f );
+        stressDesc.mesh = "models/cube.obj";
+        stressDesc.vertShader = "shaders/base.vert";
+        stressDesc.fragShader = "shaders/base.frag";
+        const Prefab* stressPrefab =
+            getSystem< PrefabLibrary >()->create( stressDesc );
+
+        std::vector< vector3 > positions;
+        positions.reserve( stressCount );
+        for ( int i = 0; i < stressCount; ++i ) {
+            positions.emplace_back(
+                static_cast< float >( i % side - side / 2 ) * 2.f, -2.f,
+                static_cast< float >( i / side ) * -2.f - 4.f );
+        }
+
+        std::vector< Entity* > stressCubes =
+            stressPrefab->instantiate( *worldInstance, positions );
+
+        // Spin at 90 degrees per second
+        const float step = 90.f * getSystem< TimeManager >()->getFixedDt();
+        engineInstance->addFixedUpdateCallback( [stressCubes, step]() {
+            for ( Entity* stressCube : stressCubes ) {
+                stressCube->transform.rotate( vector3( 0.f, 1.f, 0.f ), step );
+            }
+        } );
+    }
+
+    // Synthetic level too large to load at once, streamed around the camera
+    if ( partitionSize > 0 ) {
+        WorldPartition* worldPartition = getSystem< WorldPartition >();
+        worldPartition->setSettings( partition );
+
+        const float cellSize = partition.cellSize;
+        const int half = partitionSize / 2;
+        const int side = 4;
+
+        // Runs on a loader thread, so it only describes the cell
+        worldPartition->setCellLoader(
+            [cellSize, half, side]( const CellCoord& coord, CellData& data ) {
+                if ( std::abs( coord.x ) > half ||
+                     std::abs( coord.z ) > half ) {
+                    return false;
+                }
+
+                const float spacing = cellSize / side;
+                for ( int i = 0; i < side * side; ++i ) {
+                    EntityDesc desc;
+                    desc.name =
+                        fmt::format( "Cell{}_{}_{:02}", coord.x, coord.z, i );
+                    desc.position = vector3(
+                        ( coord.x * side + i % side + 0.5f ) * spacing, -2.f,
+                        ( coord.z * side + i / side + 0.5f ) * spacing );
+                    desc.mesh = "models/cube.obj";
+                    desc.vertShader = "shaders/base.vert";
+                    desc.fragShader = "shaders/base.frag";
+                    data.entities.push_back( std::move( desc ) );
+                }
+
+                return true;
+            } );
+    }
+
+    // Its own world, so the saved cameras and lights don't mix with ours
+    if ( !sceneFile.empty() ) {
+        World* sceneWorld =
+            worldManager->getWorld( worldManager->createWorld( sceneFile ) );
+        if ( SceneSerializer::load( sceneFile, *sceneWorld ) ) {
+            Trace::message( fmt::format( "Loaded {} entities from {}.",
+                                         sceneWorld->getEntityList().size(),
+                                         sceneFile ) );
+        }
+    }
+}
+
+int main( int argc, char** argv ) {
+    using namespace SquirrelEngine;
+
+    setupDump();
+
+    int stressCount = 0;
+    int runCount = 1;
+    int partitionSize = 0;
+    PartitionSettings partition;
+    std::string sceneFile;
+    std::string saveSceneFile;
+    const EngineSettings settings =
+        parseArguments( argc, argv, stressCount, runCount, partitionSize,
+                        partition, sceneFile, saveSceneFile );
+
+    Engine* engineInstance = Engine::instance();
+
+    for ( int run = 0; run < runCount; ++run ) {
+        // Later runs keep the window and context
+        const StartupErrors result =
+            ( run == 0 ) ? engineInstance->initialize( settings )
+                         : engineInstance->restart( settings );
+        if ( result != StartupErrors::SE_Success ) {
+            Trace::message( "Failed to start." );
+            engineInstance->shutdown();
+            return EXIT_FAILURE;
+        }
+
+        setupScene( stressCount, partitionSize, partition, sceneFile );
+
+        if ( run == 0 && !saveSceneFile.empty() ) {
+            World* persistent =
+                getSystem< WorldManager >()->getPersistentWorld();
+            if ( saveSceneFile.ends_with( ".txt" ) ) {
+                SceneSerializer::saveText( *persistent, saveSceneFile );
+            } else {
+                SceneSerializer::saveBinary( *persistent, saveSceneFile );
+            }
+        }
+        engineInstance->update();
+    }
+
     engineInstance->shutdown();
 
     return EXIT_SUCCESS;
@@ -21,21 +21,18 @@ Mesh::Mesh() {}
  * @brief Copy constructor for Mesh.
  * @param other Mesh to copy from.
  */
-Mesh::Mesh( const Mesh& other ) : vao( other.vao ), vbo( other.vbo ) {
-    for ( Vertex vert : other.m_vertices ) {
-        m_vertices.emplace_back( vert );
-    }
+Mesh::Mesh( const Mesh& other )
+    : m_shader( other.m_shader ), m_vertices( other.m_vertices ),
+      m_modelName( other.m_modelName ) {
+    // Each mesh deletes its own buffers, so copies can't share them
+    upload();
 }
 
 /**
  * @brief Copy constructor from pointer for Mesh.
  * @param other Pointer to Mesh to copy from.
  */
-Mesh::Mesh( const Mesh* other ) : vao( other->vao ), vbo( other->vbo ) {
-    for ( Vertex vert : other->m_vertices ) {
-        m_vertices.emplace_back( vert );
-    }
-}
+Mesh::Mesh( const Mesh* other ) : Mesh( *other ) {}
 
 /**
  * @brief Constructs a Mesh with a given Model.
@@ -47,8 +44,14 @@ Mesh::Mesh( Model* t_model ) : m_model( t_model ) {}
  * @brief Destructor for Mesh.
  */
 Mesh::~Mesh() {
-    glDeleteBuffers( 1, &vao );
-    glDeleteBuffers( 1, &vbo );
+    if ( vao ) {
+        glDeleteVertexArrays( 1, &vao );
+        ResourceTracker::released( GR_VertexArray );
+    }
+    if ( vbo ) {
+        glDeleteBuffers( 1, &vbo );
+        ResourceTracker::released( GR_Buffer );
+    }
 }
 
 /**
@@ -59,7 +62,7 @@ Mesh::~Mesh() {
 bool Mesh::load( std::string t_modelName ) { return read( t_modelName ); }
 
 /**
- * @brief Reads mesh data from a model file.
+ * @brief Gets the model file's vertices from the MeshCache and uploads them.
  * @param t_modelName Name of the model file.
  * @return true if read successfully, false otherwise.
  */
@@ -67,70 +70,36 @@ bool Mesh::read( std::string t_modelName ) {
     // Setting the name of the file (used in model_data_manager)
     m_modelName = t_modelName;
 
-    FILE* file;
-    errno_t err = fopen_s( &file, m_modelName.c_str(), "r" );
-    if ( err != 0 ) {
-        Trace::message( fmt::format( "Unable to open {}.", m_modelName ) );
+    // Every mesh of the same file shares one parse of it
+    m_vertices = getSystem< MeshCache >()->load( m_modelName );
+    if ( !m_vertices ) {
         return false;
     }
 
-    // Creating variables for reading
-    std::vector< unsigned > vertexIndices, uvIndices, normalIndices;
-    std::vector< vector3 > tempVertices;
-    std::vector< vector2 > tempUvs;
-    std::vector< vector3 > tempNormals;
-
-    // Until the whole file is read
-    char line[64];
-    char* temp;
-    while ( fgets( line, 64, file ) ) {
-        char* words[4];
-        words[0] = strtok_s( line, " ", &temp );
-        for ( int i = 1; i < 4; ++i ) {
-            words[i] = strtok_s( nullptr, " ", &temp );
-        }
-
-        if ( strcmp( words[0], "v" ) == 0 ) {
-            tempVertices.push_back(
-                { atof( words[1] ), atof( words[2] ), atof( words[3] ) } );
-        } else if ( strcmp( words[0], "vt" ) == 0 ) {
-            tempUvs.push_back( { atof( words[1] ), atof( words[2] ) } );
-        } else if ( strcmp( words[0], "vn" ) == 0 ) {
-            tempNormals.push_back(
-                { atof( words[1] ), atof( words[2] ), atof( words[3] ) } );
-        } else if ( strcmp( words[0], "f" ) == 0 ) {
-            char* v1[3];
-            char* v2[3];
-            char* v3[3];
-
-            v1[0] = strtok_s( words[1], "/", &temp );
-            v1[1] = strtok_s( nullptr, "/", &temp );
-            v1[2] = strtok_s( nullptr, "/", &temp );
-
-            v2[0] = strtok_s( words[2], "/", &temp );
-            v2[1] = strtok_s( nullptr, "/", &temp );
-            v2[2] = strtok_s( nullptr, "/", &temp );
-
-            v3[0] = strtok_s( words[3], "/", &temp );
-            v3[1] = strtok_s( nullptr, "/", &temp );
-            v3[2] = strtok_s( nullptr, "/", &temp );
-
-            insertData( v1, tempVertices, tempUvs, tempNormals );
-            insertData( v2, tempVertices, tempUvs, tempNormals );
-            insertData( v3, tempVertices, tempUvs, tempNormals );
-        }
-    }
+    upload();
 
-    vertCount = static_cast< GLsizei >( m_vertices.size() );
+    return true;
+}
+
+/**
+ * @brief Creates the vertex array and buffer holding the vertices.
+ */
+void Mesh::upload() {
+    vertCount = m_vertices ? static_cast< GLsizei >( m_vertices->size() ) : 0;
+    if ( vertCount == 0 ) {
+        return;
+    }
 
     glGenVertexArrays( 1, &vao );
     glBindVertexArray( vao );
 
     glGenBuffers( 1, &vbo );
+    ResourceTracker::created( GR_VertexArray );
+    ResourceTracker::created( GR_Buffer );
 
     glBindBuffer( GL_ARRAY_BUFFER, vbo );
     glBufferData( GL_ARRAY_BUFFER, sizeof( Vertex ) * vertCount,
-                  m_vertices.data(), GL_STATIC_DRAW );
+                  m_vertices->data(), GL_STATIC_DRAW );
 
     // Positions
     glEnableVertexAttribArray( 0 );
@@ -149,51 +118,32 @@ bool Mesh::read( std::string t_modelName ) {
 
     glBindBuffer( GL_ARRAY_BUFFER, 0 );
     glBindVertexArray( 0 );
-
-    return true;
 }
 
 /**
- * @brief Inserts vertex data from parsed model data.
- * @param data Array of strings containing vertex data.
- * @param v Vector of positions.
- * @param vt Vector of texture coordinates.
- * @param vn Vector of normals.
+ * @brief Draws the mesh. Models sharing the mesh each pass their own render
+ * method.
+ * @param matrix Model matrix to draw with.
+ * @param renderMethod OpenGL primitive type to draw with.
  */
-void Mesh::insertData( char* data[3], std::vector< vector3 >& v,
-                       std::vector< vector2 >& vt,
-                       std::vector< vector3 >& vn ) {
-
-    m_vertices.emplace_back( v[atoi( data[0] ) - 1], vn[atoi( data[2] ) - 1],
-                             vt[atoi( data[1] ) - 1] );
-}
-
-/**
- * @brief Draws the mesh.
- */
-void Mesh::draw() {
-    Transform& transform = m_model->owner->transform;
-    World* world = World::instance();
-
-    CameraComponent* camera =
-        world->findEntity( "Main camera" )->findComponent< CameraComponent >();
-
-    // Creating the MVP (Model * View * Projection) matrix
-    matrix4 model = transform.matrix();
+void Mesh::draw( const matrix4& matrix, const GLuint renderMethod ) {
+    // View and projection come from the PerFrameData block bound by the
+    // ObjectRenderer, only the model matrix changes per draw
+
+    // Draw with the fallback until the real program has finished building
+    Program* shader = m_shader;
+    if ( !shader || !shader->isReady() ) {
+        shader = getSystem< ShaderCompiler >()->getFallbackProgram();
+    }
 
-    glUseProgram( m_shader->getHandle() );
+    glUseProgram( shader->getHandle() );
 
-    // Sending data to the shaders
-    glUniformMatrix4fv( m_shader->getLocation( "projection" ), 1, GL_FALSE,
-                        &camera->projectionMatrix()[0][0] );
-    glUniformMatrix4fv( m_shader->getLocation( "model" ), 1, GL_FALSE,
-                        &model[0][0] );
-    glUniformMatrix4fv( m_shader->getLocation( "view" ), 1, GL_FALSE,
-                        &camera->viewMatrix()[0][0] );
+    glUniformMatrix4fv( shader->getLocation( "model" ), 1, GL_FALSE,
+                        &matrix[0][0] );
 
     glBindVertexArray( vao );
 
-    glDrawArrays( m_model->getRenderMethod(), 0, vertCount );
+    glDrawArrays( renderMethod, 0, vertCount );
 
     glUseProgram( 0 );
 
@@ -202,26 +152,26 @@ void Mesh::draw() {
 
 /**
  * @brief Sets the shader program for this mesh.
- * @param t_shader Pointer to the shader Program.
+ * @param t_shader Pointer to the shader Program (not owned by the mesh).
  */
-void Mesh::setShader( Program* t_shader ) {
-    m_shader = std::make_unique< Program >( t_shader );
-}
+void Mesh::setShader( Program* t_shader ) { m_shader = t_shader; }
 
 /**
  * @brief Gets the shader program associated with this mesh.
  * @return Pointer to the shader Program.
  */
-const Program* Mesh::getShader() const { return m_shader.get(); }
+const Program* Mesh::getShader() const { return m_shader; }
 
 /**
- * @brief Loads and sets the shader from vertex and fragment shader files.
+ * @brief Requests the shader from the ShaderCompiler. The mesh draws with the
+ * fallback program until the build is ready.
  * @param vertName Vertex shader filename.
  * @param fragName Fragment shader filename.
  */
 void Mesh::loadShader( const std::string& vertName,
                        const std::string& fragName ) {
-    m_shader = std::make_unique< Program >( vertName, fragName );
+    m_shader =
+        getSystem< ShaderCompiler >()->requestProgram( vertName, fragName );
 }
 
 /**
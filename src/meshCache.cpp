@@ -0,0 +1,194 @@
+/**
+ *
+ * @file meshCache.cpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief Implements the MeshCache class, which parses each model file once and
+ * shares its vertices between meshes in SquirrelEngine.
+ * @date 2025-06-06
+ *
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <fmt/core.h>
+
+#include "meshCache.hpp"
+#include "utils/trace.hpp"
+
+namespace SquirrelEngine {
+
+/**
+ * @brief Default constructor for MeshCache.
+ */
+MeshCache::MeshCache() {}
+
+/**
+ * @brief Destructor for MeshCache.
+ */
+MeshCache::~MeshCache() {}
+
+/**
+ * @brief Drops every cached file. Meshes keep the data they already have.
+ */
+void MeshCache::shutdown() {
+    std::lock_guard< std::mutex > lock( m_mutex );
+    m_meshes.clear();
+    m_memoryUsage = 0;
+}
+
+/**
+ * @brief Gets the vertices of a model file, parsing it on the first call.
+ * Thread safe.
+ * @param filename Name of the model file.
+ * @return Shared vertices, or nullptr if the file can't be opened.
+ */
+std::shared_ptr< const MeshData >
+MeshCache::load( const std::string& filename ) {
+    {
+        std::lock_guard< std::mutex > lock( m_mutex );
+        auto found = m_meshes.find( filename );
+        if ( found != m_meshes.end() ) {
+            return found->second;
+        }
+    }
+
+    // Parsed unlocked so loader threads don't wait on each other's files
+    std::shared_ptr< const MeshData > vertices = read( filename );
+    if ( !vertices ) {
+        return nullptr;
+    }
+
+    std::lock_guard< std::mutex > lock( m_mutex );
+
+    // Another thread may have parsed the same file meanwhile, keep the first
+    auto [it, inserted] = m_meshes.emplace( filename, vertices );
+    if ( inserted ) {
+        m_memoryUsage += vertices->size() * sizeof( Vertex );
+    }
+
+    return it->second;
+}
+
+/**
+ * @brief Drops the files no mesh or loader is using anymore.
+ * @return Bytes of vertices freed.
+ */
+size_t MeshCache::trim() {
+    std::lock_guard< std::mutex > lock( m_mutex );
+
+    size_t freed = 0;
+    for ( auto it = m_meshes.begin(); it != m_meshes.end(); ) {
+        if ( it->second.use_count() == 1 ) {
+            freed += it->second->size() * sizeof( Vertex );
+            it = m_meshes.erase( it );
+        } else {
+            ++it;
+        }
+    }
+
+    m_memoryUsage -= freed;
+    return freed;
+}
+
+/**
+ * @brief Gets the bytes of vertices currently cached.
+ * @return Memory used by the cache.
+ */
+size_t MeshCache::getMemoryUsage() const {
+    std::lock_guard< std::mutex > lock( m_mutex );
+    return m_memoryUsage;
+}
+
+/**
+ * @brief Gets the number of files currently cached.
+ * @return Number of cached files.
+ */
+size_t MeshCache::getMeshCount() const {
+    std::lock_guard< std::mutex > lock( m_mutex );
+    return m_meshes.size();
+}
+
+/**
+ * @brief Parses a Wavefront OBJ file into triangle vertices.
+ * @param filename Name of the model file.
+ * @return Parsed vertices, or nullptr if the file can't be opened.
+ */
+std::shared_ptr< MeshData > MeshCache::read( const std::string& filename ) {
+    FILE* file;
+    errno_t err = fopen_s( &file, filename.c_str(), "r" );
+    if ( err != 0 ) {
+        Trace::message( fmt::format( "Unable to open {}.", filename ) );
+        return nullptr;
+    }
+
+    auto vertices = std::make_shared< MeshData >();
+
+    // Creating variables for reading
+    std::vector< vector3 > tempVertices;
+    std::vector< vector2 > tempUvs;
+    std::vector< vector3 > tempNormals;
+
+    // Until the whole file is read
+    char line[64];
+    char* temp;
+    while ( fgets( line, 64, file ) ) {
+        char* words[4];
+        words[0] = strtok_s( line, " ", &temp );
+        for ( int i = 1; i < 4; ++i ) {
+            words[i] = strtok_s( nullptr, " ", &temp );
+        }
+
+        if ( strcmp( words[0], "v" ) == 0 ) {
+            tempVertices.push_back(
+                { atof( words[1] ), atof( words[2] ), atof( words[3] ) } );
+        } else if ( strcmp( words[0], "vt" ) == 0 ) {
+            tempUvs.push_back( { atof( words[1] ), atof( words[2] ) } );
+        } else if ( strcmp( words[0], "vn" ) == 0 ) {
+            tempNormals.push_back(
+                { atof( words[1] ), atof( words[2] ), atof( words[3] ) } );
+        } else if ( strcmp( words[0], "f" ) == 0 ) {
+            char* v1[3];
+            char* v2[3];
+            char* v3[3];
+
+            v1[0] = strtok_s( words[1], "/", &temp );
+            v1[1] = strtok_s( nullptr, "/", &temp );
+            v1[2] = strtok_s( nullptr, "/", &temp );
+
+            v2[0] = strtok_s( words[2], "/", &temp );
+            v2[1] = strtok_s( nullptr, "/", &temp );
+            v2[2] = strtok_s( nullptr, "/", &temp );
+
+            v3[0] = strtok_s( words[3], "/", &temp );
+            v3[1] = strtok_s( nullptr, "/", &temp );
+            v3[2] = strtok_s( nullptr, "/", &temp );
+
+            insertData( v1, tempVertices, tempUvs, tempNormals, *vertices );
+            insertData( v2, tempVertices, tempUvs, tempNormals, *vertices );
+            insertData( v3, tempVertices, tempUvs, tempNormals, *vertices );
+        }
+    }
+
+    fclose( file );
+
+    return vertices;
+}
+
+/**
+ * @brief Adds the vertex a face corner refers to.
+ * @param data Position, uv and normal indices of the corner.
+ * @param v List of positions.
+ * @param vt List of texture coordinates.
+ * @param vn List of normals.
+ * @param vertices Vertices to add to.
+ */
+void MeshCache::insertData( char* data[3], std::vector< vector3 >& v,
+                            std::vector< vector2 >& vt,
+                            std::vector< vector3 >& vn, MeshData& vertices ) {
+    vertices.emplace_back( v[atoi( data[0] ) - 1], vn[atoi( data[2] ) - 1],
+                           vt[atoi( data[1] ) - 1] );
+}
+
+} // namespace SquirrelEngine
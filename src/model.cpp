@@ -35,12 +35,13 @@ Model::~Model() {}
  * @param filename The mesh file name.
  */
 void Model::initMesh( const std::string& filename ) {
-    m_mesh = std::make_unique< Mesh >( this );
+    m_mesh = std::make_shared< Mesh >( this );
     m_mesh->load( filename );
 }
 
 /**
- * @brief Initializes the shader for this model.
+ * @brief Initializes the shader for this model. A mesh shared with other
+ * models is copied first, so they keep their shader.
  * @param vertName Vertex shader file name.
  * @param fragName Fragment shader file name.
  */
@@ -51,20 +52,37 @@ void Model::initShader( const std::string& vertName,
         return;
     }
 
+    // Copy on write, only the models that override pay for their own mesh
+    if ( isMeshShared() ) {
+        m_mesh = std::make_shared< Mesh >( *m_mesh );
+    }
+
     m_mesh->loadShader( vertName, fragName );
 }
 
 /**
  * @brief Draws the model.
+ * @param matrix Model matrix to draw with.
  */
-void Model::draw() { m_mesh->draw(); }
+void Model::draw( const matrix4& matrix ) {
+    m_mesh->draw( matrix, m_renderMethod );
+}
 
 /**
  * @brief Sets the mesh for this model.
  * @param t_mesh Pointer to the Mesh.
  */
 void Model::setMesh( Mesh* t_mesh ) {
-    m_mesh = std::make_unique< Mesh >( t_mesh );
+    m_mesh = std::make_shared< Mesh >( t_mesh );
+}
+
+/**
+ * @brief Draws a mesh shared with other models, such as a Prefab's, without
+ * copying or uploading it again.
+ * @param t_mesh Shared mesh.
+ */
+void Model::setMesh( std::shared_ptr< Mesh > t_mesh ) {
+    m_mesh = std::move( t_mesh );
 }
 
 /**
@@ -73,6 +91,18 @@ void Model::setMesh( Mesh* t_mesh ) {
  */
 Mesh* Model::getMesh() const { return m_mesh.get(); }
 
+/**
+ * @brief Gets the mesh for other models to share with setMesh.
+ * @return Shared pointer to the Mesh.
+ */
+std::shared_ptr< Mesh > Model::getSharedMesh() const { return m_mesh; }
+
+/**
+ * @brief Checks if other models draw the same mesh.
+ * @return true if the mesh is shared.
+ */
+bool Model::isMeshShared() const { return m_mesh && m_mesh.use_count() > 1; }
+
 /**
  * @brief Sets the render method (OpenGL primitive type).
  * @param t_renderMethod The render method (e.g., GL_TRIANGLES).
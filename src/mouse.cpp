@@ -24,15 +24,22 @@ namespace SquirrelEngine {
  * @param action Mouse button action (press/release).
  * @param mods Modifier keys.
  */
-static void mouseCallback( GLFWwindow*, int button, int action, int ) {
-    InputSystem* inputSystem = getSystem< InputSystem >();
-
-    Mouse* mouse = inputSystem->findInputDevice< Mouse >();
+static void mouseCallback( GLFWwindow* window, int button, int action, int ) {
+    // GLFW buttons start at 0, MouseButtons start at BUTTON_LEFT
+    if ( button < GLFW_MOUSE_BUTTON_LEFT || GLFW_MOUSE_BUTTON_MIDDLE < button ) {
+        return;
+    }
 
-    const int state = ( action == GLFW_PRESS ) ? 1 : 0;
-    mouse->setButtonState( button, static_cast< float >( state ) );
+    const WindowInput* input = Window::getInput( window );
+    if ( !input || !input->mouse ||
+         !input->inputSystem->isLiveInputEnabled() ) {
+        return;
+    }
 
-    inputSystem->triggerAction( mouse, button, static_cast< float >( state ) );
+    const int mapped = MouseButtons::BUTTON_LEFT + button;
+    const float state = ( action == GLFW_PRESS ) ? 1.f : 0.f;
+    input->inputSystem->setButtonState( input->mouse, mapped, state );
+    input->inputSystem->triggerAction( input->mouse, mapped, state );
 }
 
 /**
@@ -41,19 +48,42 @@ static void mouseCallback( GLFWwindow*, int button, int action, int ) {
  * @param xoffset Scroll offset in X direction (unused).
  * @param yoffset Scroll offset in Y direction.
  */
-static void mouseScrollCallback( GLFWwindow*, double, double yoffset ) {
-    InputSystem* inputSystem = getSystem< InputSystem >();
+static void mouseScrollCallback( GLFWwindow* window, double,
+                                 double yoffset ) {
+    const WindowInput* input = Window::getInput( window );
+    if ( !input || !input->mouse ||
+         !input->inputSystem->isLiveInputEnabled() ) {
+        return;
+    }
 
-    Mouse* mouse = inputSystem->findInputDevice< Mouse >();
+    InputSystem* inputSystem = input->inputSystem;
+    Mouse* mouse = input->mouse;
 
     float scroll = mouse->getButtonState( MouseButtons::BUTTON_SCROLL );
     scroll += static_cast< float >( yoffset );
-    mouse->setButtonState( MouseButtons::BUTTON_SCROLL, scroll );
+    inputSystem->setButtonState( mouse, MouseButtons::BUTTON_SCROLL, scroll );
 
     inputSystem->triggerAction( mouse, MouseButtons::BUTTON_SCROLL,
                                 static_cast< float >( yoffset ) );
 }
 
+/**
+ * @brief GLFW cursor position callback, collects every motion event.
+ * @param window Pointer to the GLFW window.
+ * @param xpos Cursor X position.
+ * @param ypos Cursor Y position.
+ */
+static void mouseMotionCallback( GLFWwindow* window, double xpos,
+                                 double ypos ) {
+    const WindowInput* input = Window::getInput( window );
+    if ( !input || !input->mouse ||
+         !input->inputSystem->isLiveInputEnabled() ) {
+        return;
+    }
+
+    input->mouse->addMotion( vector2( xpos, ypos ), glfwGetTime() );
+}
+
 /**
  * @brief Default constructor for Mouse.
  */
@@ -66,8 +96,33 @@ Mouse::Mouse()
 void Mouse::initialize() {
     Window* window = Engine::instance()->getWindowHandle();
 
+    WindowInput& input = window->getInput();
+    input.inputSystem = getSystem< InputSystem >();
+    input.mouse = this;
+
     glfwSetMouseButtonCallback( window->getHandle(), mouseCallback );
     glfwSetScrollCallback( window->getHandle(), mouseScrollCallback );
+    glfwSetCursorPosCallback( window->getHandle(), mouseMotionCallback );
+}
+
+/**
+ * @brief Hands the motion accumulated since the last poll to this frame.
+ */
+void Mouse::poll() {
+    m_pendingMotion = 1 - m_pendingMotion;
+    m_motionCount[m_pendingMotion] = 0;
+    m_motionDelta[m_pendingMotion] = vector2( 0.f );
+}
+
+/**
+ * @brief Clears the scroll accumulated during the last frame. Goes through the
+ * InputSystem so actions mapped to the wheel are reset too.
+ */
+void Mouse::update() {
+    if ( m_buttonStates[MouseButtons::BUTTON_SCROLL] != 0 ) {
+        getSystem< InputSystem >()->setButtonState(
+            this, MouseButtons::BUTTON_SCROLL, 0.f );
+    }
 }
 
 /**
@@ -76,17 +131,11 @@ void Mouse::initialize() {
  * @return The state of the button as a float.
  */
 const float Mouse::getButtonState( const int button ) {
-    if ( button < 0 || BUTTON_MOUSE_LAST < button ) {
+    if ( button < 0 || BUTTON_MOUSE_LAST <= button ) {
         Trace::message( "Button outside of range." );
         return 0.f;
     }
 
-    if ( button == MouseButtons::BUTTON_SCROLL ) {
-        const float amount = static_cast< float >( m_buttonStates[button] );
-        m_buttonStates[button] = 0;
-        return amount;
-    }
-
     return static_cast< float >( m_buttonStates[button] );
 }
 
@@ -96,7 +145,7 @@ const float Mouse::getButtonState( const int button ) {
  * @param state The new state of the button.
  */
 void Mouse::setButtonState( const int button, const float state ) {
-    if ( button < 0 || BUTTON_MOUSE_LAST < button ) {
+    if ( button < 0 || BUTTON_MOUSE_LAST <= button ) {
         Trace::message( "Button outside of range." );
         return;
     }
@@ -109,6 +158,10 @@ void Mouse::setButtonState( const int button, const float state ) {
  * @return The cursor position as a vector2.
  */
 const vector2 Mouse::getCursorPosition() {
+    if ( m_isCursorDriven ) {
+        return m_drivenCursorPosition;
+    }
+
     Window* window = Engine::instance()->getWindowHandle();
 
     double xpos, ypos;
@@ -130,6 +183,22 @@ const vector2 Mouse::getCursorDelta() {
     return currPosition - lastPosition;
 }
 
+/**
+ * @brief Overrides the cursor position reported by the mouse, e.g. with a
+ * recorded one. The window's cursor is no longer read afterwards. Each call
+ * adds one motion sample, so a replay driving the cursor once per frame
+ * reports one sample per frame.
+ * @param position Cursor position to report.
+ * @param time Time of the motion sample in seconds.
+ */
+void Mouse::driveCursor( const vector2& position, const double time ) {
+    m_drivenCursorPosition = position;
+    m_isCursorDriven = true;
+
+    // Replays record positions, turn them back into motion
+    addMotion( position, time );
+}
+
 /**
  * @brief Sets the cursor mode (e.g., normal, hidden, disabled).
  * @param t_cursorMode The cursor mode to set.
@@ -145,6 +214,114 @@ void Mouse::setCursorMode( const int t_cursorMode ) {
     m_cursorMode = t_cursorMode;
 
     m_lastCursorPosition = getCursorPosition();
+
+    // The cursor jumps when its mode changes, don't report that as motion
+    m_lastMotionPosition = m_lastCursorPosition;
+    m_hasMotionPosition = true;
+}
+
+/**
+ * @brief Enables or disables unscaled, unaccelerated motion while the cursor
+ * is disabled.
+ * @param enabled Whether to use raw motion.
+ * @return true if the platform supports raw motion.
+ */
+bool Mouse::setRawMotion( const bool enabled ) {
+    if ( !glfwRawMouseMotionSupported() ) {
+        m_isRawMotion = false;
+        return false;
+    }
+
+    GLFWwindow* window = Engine::instance()->getWindowHandle()->getHandle();
+    glfwSetInputMode( window, GLFW_RAW_MOUSE_MOTION,
+                      enabled ? GLFW_TRUE : GLFW_FALSE );
+    m_isRawMotion = enabled;
+
+    return true;
+}
+
+/**
+ * @brief Checks if raw motion is enabled.
+ * @return true if raw motion was enabled and is supported.
+ */
+bool Mouse::isRawMotionEnabled() const { return m_isRawMotion; }
+
+/**
+ * @brief Adds a cursor motion event. Called for every cursor position event
+ * between polls.
+ * @param position New cursor position.
+ * @param time Time of the event in seconds.
+ */
+void Mouse::addMotion( const vector2& position, const double time ) {
+    if ( !m_hasMotionPosition ) {
+        m_lastMotionPosition = position;
+        m_hasMotionPosition = true;
+        return;
+    }
+
+    const vector2 delta = position - m_lastMotionPosition;
+    m_lastMotionPosition = position;
+
+    int& count = m_motionCount[m_pendingMotion];
+    auto& samples = m_motionSamples[m_pendingMotion];
+
+    // Fold overflow into the newest sample so the sum stays exact
+    if ( count == MaxMotionSamples ) {
+        samples[count - 1].time = time;
+        samples[count - 1].delta += delta;
+    } else {
+        samples[count++] = { time, delta };
+    }
+
+    m_motionDelta[m_pendingMotion] += delta;
+}
+
+/**
+ * @brief Gets the position the next motion event is measured from, or the
+ * cursor position if no event was seen yet.
+ * @return Motion origin in cursor units.
+ */
+const vector2 Mouse::getMotionOrigin() {
+    if ( m_hasMotionPosition ) {
+        return m_lastMotionPosition;
+    }
+
+    return getCursorPosition();
+}
+
+/**
+ * @brief Sets the position the next motion event is measured from, so the
+ * first event reports a delta instead of being swallowed.
+ * @param position Motion origin in cursor units.
+ */
+void Mouse::setMotionOrigin( const vector2& position ) {
+    m_lastMotionPosition = position;
+    m_hasMotionPosition = true;
+}
+
+/**
+ * @brief Gets the summed motion of every event delivered this frame. Unlike
+ * the cursor delta it doesn't depend on when it is read.
+ * @return Motion in cursor units.
+ */
+const vector2& Mouse::getMotionDelta() const {
+    return m_motionDelta[1 - m_pendingMotion];
+}
+
+/**
+ * @brief Gets the motion events delivered this frame, oldest first.
+ * @return Pointer to the first sample.
+ */
+const Mouse::MotionSample* Mouse::getMotionSamples() const {
+    return m_motionSamples[1 - m_pendingMotion].data();
+}
+
+/**
+ * @brief Gets the number of motion events delivered this frame.
+ * @return Sample count, at most MaxMotionSamples.
+ */
+int Mouse::getMotionSampleCount() const {
+    return m_motionCount[1 - m_pendingMotion];
 }
 
 } // namespace SquirrelEngine
@@ -26,25 +26,174 @@ namespace SquirrelEngine {
 ObjectRenderer::ObjectRenderer() {}
 
 /**
- * @brief Renders all entities in the world by drawing their models and swapping
- * the window buffer.
+ * @brief Creates the per-frame uniform buffer and requests the grid program.
+ * @param t_owner Pointer to the Engine that owns this system.
+ * @return StartupErrors indicating success or failure.
+ */
+StartupErrors ObjectRenderer::initialize( Engine* t_owner ) {
+    System::initialize( t_owner );
+
+    m_profiler = getSystem< FrameProfiler >();
+    m_timeManager = getSystem< TimeManager >();
+
+    glGenBuffers( 1, &m_perFrameBuffer );
+    glBindBuffer( GL_UNIFORM_BUFFER, m_perFrameBuffer );
+    glBufferData( GL_UNIFORM_BUFFER, sizeof( PerFrameData ), nullptr,
+                  GL_DYNAMIC_DRAW );
+    glBindBuffer( GL_UNIFORM_BUFFER, 0 );
+    ResourceTracker::created( GR_Buffer );
+
+    // Core profile won't draw without a VAO bound, even with no attributes
+    glGenVertexArrays( 1, &m_emptyVao );
+    ResourceTracker::created( GR_VertexArray );
+
+    m_gridShader = getSystem< ShaderCompiler >()->requestProgram(
+        "shaders/grid.vert", "shaders/grid.frag" );
+
+    return StartupErrors::SE_Success;
+}
+
+/**
+ * @brief Deletes the GL objects owned by the renderer.
+ */
+void ObjectRenderer::shutdown() {
+    glDeleteVertexArrays( 1, &m_emptyVao );
+    glDeleteBuffers( 1, &m_perFrameBuffer );
+    ResourceTracker::released( GR_VertexArray );
+    ResourceTracker::released( GR_Buffer );
+    m_emptyVao = 0;
+    m_perFrameBuffer = 0;
+}
+
+/**
+ * @brief Renders all entities in the world by drawing their models, then draws
+ * the ground grid over them. Models are drawn between their last two fixed
+ * steps so motion stays smooth when the display outpaces the simulation.
  */
 void ObjectRenderer::render() {
-    World* world = World::instance();
+    m_snapshot.draws.clear();
+    m_snapshot.hasCamera = false;
 
-    // TODO: update shaders
+    buildSnapshot( m_snapshot );
+    render( m_snapshot );
+}
 
-    glClear( GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT );
+/**
+ * @brief Captures the camera and every model's interpolated matrix. Doesn't
+ * touch OpenGL, so it runs on the simulation thread.
+ * @param snapshot Snapshot to fill, draws are appended.
+ */
+void ObjectRenderer::buildSnapshot( RenderSnapshot& snapshot ) {
+    WorldManager* worldManager = getSystem< WorldManager >();
+
+    Entity* cameraEntity = worldManager->getCamera();
+    CameraComponent* camera =
+        cameraEntity ? cameraEntity->findComponent< CameraComponent >()
+                     : nullptr;
+    if ( !camera ) {
+        return;
+    }
 
-    auto& entityList = world->getEntityList();
-    for ( auto& entity : entityList ) {
-        Model* model = entity->findComponent< Model >();
-        if ( !model ) {
+    snapshot.frameData.view = camera->viewMatrix();
+    snapshot.frameData.proj = camera->projectionMatrix();
+    snapshot.frameData.cameraPos =
+        vector4( cameraEntity->transform.getPosition(), 1.f );
+    snapshot.hasCamera = true;
+
+    const float alpha = m_timeManager ? m_timeManager->getAlpha() : 1.f;
+
+    for ( World* world : worldManager->getWorlds() ) {
+        if ( !world->isVisible() ) {
             continue;
         }
 
-        model->draw();
+        for ( auto& entity : world->getEntityList() ) {
+            Model* model = entity->findComponent< Model >();
+            if ( !model ) {
+                continue;
+            }
+
+            snapshot.draws.push_back(
+                { model, entity->transform.interpolatedMatrix( alpha ) } );
+        }
     }
 }
 
+/**
+ * @brief Draws a captured frame. Only reads the snapshot and the models it
+ * points to.
+ * @param snapshot Frame to draw.
+ */
+void ObjectRenderer::render( const RenderSnapshot& snapshot ) {
+    glClear( GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT );
+
+    if ( !snapshot.hasCamera ) {
+        return;
+    }
+
+    updatePerFrameData( snapshot.frameData );
+
+    for ( const DrawItem& item : snapshot.draws ) {
+        item.model->draw( item.matrix );
+    }
+
+    // Grid is transparent, so it goes after the opaque objects
+    if ( m_gridEnabled ) {
+        FrameProfiler::Scope scope( m_profiler, "Grid" );
+        renderGrid();
+    }
+}
+
+/**
+ * @brief Enables or disables the ground grid pass.
+ * @param enabled Whether to draw the grid.
+ */
+void ObjectRenderer::setGridEnabled( const bool enabled ) {
+    m_gridEnabled = enabled;
+}
+
+/**
+ * @brief Checks if the ground grid pass is drawn.
+ * @return true if the grid is enabled.
+ */
+bool ObjectRenderer::isGridEnabled() const { return m_gridEnabled; }
+
+/**
+ * @brief Uploads the camera matrices of a frame to the per-frame buffer.
+ * @param data Camera data of the frame.
+ */
+void ObjectRenderer::updatePerFrameData( const PerFrameData& data ) {
+    glBindBuffer( GL_UNIFORM_BUFFER, m_perFrameBuffer );
+    glBufferSubData( GL_UNIFORM_BUFFER, 0, sizeof( PerFrameData ), &data );
+    glBindBuffer( GL_UNIFORM_BUFFER, 0 );
+
+    glBindBufferBase( GL_UNIFORM_BUFFER, PerFrameBinding, m_perFrameBuffer );
+}
+
+/**
+ * @brief Draws the procedural ground grid with a single attribute-less draw
+ * call. The vertex shader builds a camera-following quad from gl_VertexID.
+ */
+void ObjectRenderer::renderGrid() {
+    if ( !m_gridShader || !m_gridShader->isReady() ) {
+        return;
+    }
+
+    // Blend over the scene and test against it, but don't occlude anything.
+    // The quad is seen from both sides, so culling is off for it
+    glDisable( GL_CULL_FACE );
+    glDepthMask( GL_FALSE );
+
+    glUseProgram( m_gridShader->getHandle() );
+    glBindVertexArray( m_emptyVao );
+
+    glDrawArrays( GL_TRIANGLES, 0, 6 );
+
+    glBindVertexArray( 0 );
+    glUseProgram( 0 );
+
+    glDepthMask( GL_TRUE );
+    glEnable( GL_CULL_FACE );
+}
+
 } // namespace SquirrelEngine
@@ -0,0 +1,111 @@
+/**
+ *
+ * @file prefab.cpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief Implements the Prefab class, an immutable entity template whose
+ * assets are loaded once and shared by every instance in SquirrelEngine.
+ * @date 2025-06-06
+ *
+ */
+
+#include <glad/glad.h>
+
+#include "entity.hpp"
+#include "mesh.hpp"
+#include "model.hpp"
+#include "prefab.hpp"
+#include "world.hpp"
+
+namespace SquirrelEngine {
+
+/**
+ * @brief Loads the prefab's assets.
+ * @param t_desc What to build the prefab from.
+ */
+Prefab::Prefab( const PrefabDesc& t_desc ) : m_desc( t_desc ) {
+    m_transform.setRotation( m_desc.rotation );
+    m_transform.setScale( m_desc.scale );
+
+    if ( m_desc.mesh.empty() ) {
+        return;
+    }
+
+    m_mesh = std::make_shared< Mesh >();
+    m_mesh->load( m_desc.mesh );
+    if ( !m_desc.vertShader.empty() ) {
+        m_mesh->loadShader( m_desc.vertShader, m_desc.fragShader );
+    }
+}
+
+/**
+ * @brief Destructor for Prefab. Instances keep the mesh alive.
+ */
+Prefab::~Prefab() {}
+
+/**
+ * @brief Creates an instance of the prefab.
+ * @param world World to create it in.
+ * @param position Position of the instance.
+ * @return Pointer to the created Entity.
+ */
+Entity* Prefab::instantiate( World& world, const vector3& position ) const {
+    Entity* entity = world.createEntity( m_desc.name );
+
+    // Rotation and scale come with the copy, only the position is the
+    // instance's own
+    entity->transform = m_transform;
+    entity->transform.setPosition( position );
+    entity->transform.resetInterpolation();
+    world.setTags( entity, m_desc.tags );
+
+    if ( m_mesh ) {
+        entity->createComponent< Model >()->setMesh( m_mesh );
+    }
+
+    return entity;
+}
+
+/**
+ * @brief Creates an instance of the prefab at each position, reserving room
+ * for them all first.
+ * @param world World to create them in.
+ * @param positions Position of each instance.
+ * @return Pointers to the created entities, in the order of positions.
+ */
+std::vector< Entity* >
+Prefab::instantiate( World& world,
+                     const std::vector< vector3 >& positions ) const {
+    world.reserve( world.getEntityList().size() + positions.size() );
+
+    std::vector< Entity* > entities;
+    entities.reserve( positions.size() );
+
+    for ( const vector3& position : positions ) {
+        entities.push_back( instantiate( world, position ) );
+    }
+
+    return entities;
+}
+
+/**
+ * @brief Gets the name of the prefab.
+ * @return Name given to instances.
+ */
+const std::string& Prefab::getName() const { return m_desc.name; }
+
+/**
+ * @brief Gets what the prefab was built from.
+ * @return Description of the prefab.
+ */
+const PrefabDesc& Prefab::getDesc() const { return m_desc; }
+
+/**
+ * @brief Gets the number of models still drawing the prefab's mesh. Instances
+ * that overrode it aren't counted.
+ * @return Number of sharing instances.
+ */
+size_t Prefab::getInstanceCount() const {
+    return m_mesh ? static_cast< size_t >( m_mesh.use_count() - 1 ) : 0;
+}
+
+} // namespace SquirrelEngine
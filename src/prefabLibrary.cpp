@@ -0,0 +1,70 @@
+/**
+ *
+ * @file prefabLibrary.cpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief Implements the PrefabLibrary class, which owns every Prefab by name
+ * in SquirrelEngine.
+ * @date 2025-06-06
+ *
+ */
+
+#include <fmt/core.h>
+
+#include "prefabLibrary.hpp"
+#include "utils/trace.hpp"
+
+namespace SquirrelEngine {
+
+/**
+ * @brief Default constructor for PrefabLibrary.
+ */
+PrefabLibrary::PrefabLibrary() {}
+
+/**
+ * @brief Destructor for PrefabLibrary.
+ */
+PrefabLibrary::~PrefabLibrary() {}
+
+/**
+ * @brief Drops every prefab. Instances keep the meshes they draw.
+ */
+void PrefabLibrary::shutdown() { m_prefabs.clear(); }
+
+/**
+ * @brief Creates a prefab, loading its assets.
+ * @param desc What to build the prefab from.
+ * @return Pointer to the prefab. If the name is taken the existing prefab is
+ * returned unchanged.
+ */
+const Prefab* PrefabLibrary::create( const PrefabDesc& desc ) {
+    auto [it, inserted] = m_prefabs.try_emplace( desc.name );
+    if ( !inserted ) {
+        // Changing it would change every instance already made from it
+        if ( it->second->getDesc().mesh != desc.mesh ) {
+            Trace::message( fmt::format(
+                "Prefab {} already exists, keeping the first.", desc.name ) );
+        }
+        return it->second.get();
+    }
+
+    it->second = std::make_unique< Prefab >( desc );
+    return it->second.get();
+}
+
+/**
+ * @brief Finds a prefab by name.
+ * @param name Name the prefab was created with.
+ * @return Pointer to the prefab, or nullptr if there is none.
+ */
+const Prefab* PrefabLibrary::find( const std::string& name ) const {
+    auto found = m_prefabs.find( name );
+    return ( found != m_prefabs.end() ) ? found->second.get() : nullptr;
+}
+
+/**
+ * @brief Gets the number of prefabs.
+ * @return Number of prefabs created.
+ */
+size_t PrefabLibrary::getPrefabCount() const { return m_prefabs.size(); }
+
+} // namespace SquirrelEngine
@@ -0,0 +1,187 @@
+/**
+ *
+ * @file renderPipeline.cpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief Implements the RenderPipeline class, which hands render snapshots from
+ * the simulation thread to the render thread in SquirrelEngine.
+ * @date 2025-06-06
+ *
+ */
+
+#include <algorithm>
+
+#include "renderPipeline.hpp"
+
+namespace SquirrelEngine {
+
+/**
+ * @brief Default constructor for RenderPipeline.
+ */
+RenderPipeline::RenderPipeline() {}
+
+/**
+ * @brief Sets how many published frames may wait for the render thread.
+ * @param frames 1 for the lowest latency, 2 for the most overlap.
+ */
+void RenderPipeline::setMaxFramesAhead( const int frames ) {
+    std::lock_guard< std::mutex > lock( m_mutex );
+
+    // One snapshot is always being read and one written
+    m_maxFramesAhead = std::clamp( frames, 1, SnapshotCount - 1 );
+}
+
+/**
+ * @brief Gets how many published frames may wait for the render thread.
+ * @return Frames the simulation may run ahead.
+ */
+int RenderPipeline::getMaxFramesAhead() const {
+    std::lock_guard< std::mutex > lock( m_mutex );
+    return m_maxFramesAhead;
+}
+
+/**
+ * @brief Sets whether a newly published frame replaces frames that are still
+ * waiting instead of queueing behind them. The simulation never waits on the
+ * render thread then, at the cost of dropped frames, and the max frames ahead
+ * is ignored.
+ * @param enabled Whether to drop late frames.
+ */
+void RenderPipeline::setDropLateFrames( const bool enabled ) {
+    std::lock_guard< std::mutex > lock( m_mutex );
+    m_dropLateFrames = enabled;
+}
+
+/**
+ * @brief Waits for a free snapshot for the simulation to write into.
+ * @return Snapshot to fill, cleared of the previous frame's draws.
+ */
+RenderSnapshot& RenderPipeline::beginWrite() {
+    std::unique_lock< std::mutex > lock( m_mutex );
+
+    m_freed.wait( lock, [this]() {
+        return find( SS_Free ) >= 0 &&
+               ( m_dropLateFrames || m_readyCount < m_maxFramesAhead );
+    } );
+
+    m_writing = find( SS_Free );
+    m_states[m_writing] = SS_Writing;
+
+    // Clear keeps the capacity, so steady frames don't allocate
+    RenderSnapshot& snapshot = m_snapshots[m_writing];
+    snapshot.draws.clear();
+    snapshot.hasCamera = false;
+    snapshot.frame = m_nextFrame++;
+
+    return snapshot;
+}
+
+/**
+ * @brief Publishes the snapshot returned by beginWrite.
+ */
+void RenderPipeline::endWrite() {
+    {
+        std::lock_guard< std::mutex > lock( m_mutex );
+
+        if ( m_dropLateFrames ) {
+            for ( int i = 0; i < m_readyCount; ++i ) {
+                m_states[m_readyOrder[i]] = SS_Free;
+            }
+            m_droppedFrames += m_readyCount;
+            m_readyCount = 0;
+        }
+
+        m_states[m_writing] = SS_Ready;
+        m_readyOrder[m_readyCount++] = m_writing;
+        m_writing = -1;
+    }
+
+    m_ready.notify_one();
+}
+
+/**
+ * @brief Waits for the oldest published snapshot.
+ * @return Snapshot to render, or nullptr once the pipeline is stopped.
+ */
+const RenderSnapshot* RenderPipeline::beginRead() {
+    std::unique_lock< std::mutex > lock( m_mutex );
+
+    m_ready.wait( lock,
+                  [this]() { return m_isStopped || m_readyCount > 0; } );
+    if ( m_isStopped ) {
+        return nullptr;
+    }
+
+    m_reading = m_readyOrder[0];
+    std::copy( m_readyOrder.begin() + 1, m_readyOrder.begin() + m_readyCount,
+               m_readyOrder.begin() );
+    --m_readyCount;
+    m_states[m_reading] = SS_Reading;
+
+    return &m_snapshots[m_reading];
+}
+
+/**
+ * @brief Returns the snapshot from beginRead to the simulation.
+ */
+void RenderPipeline::endRead() {
+    {
+        std::lock_guard< std::mutex > lock( m_mutex );
+        m_states[m_reading] = SS_Free;
+        m_reading = -1;
+    }
+
+    m_freed.notify_all();
+}
+
+/**
+ * @brief Waits until every published snapshot has been rendered. Call before
+ * changing anything the render thread reads through a snapshot, like removing
+ * entities.
+ */
+void RenderPipeline::waitIdle() {
+    std::unique_lock< std::mutex > lock( m_mutex );
+
+    m_freed.wait( lock, [this]() {
+        return m_isStopped || ( m_readyCount == 0 && m_reading < 0 );
+    } );
+}
+
+/**
+ * @brief Wakes the render thread and makes beginRead return nullptr. Call from
+ * the simulation thread.
+ */
+void RenderPipeline::stop() {
+    {
+        std::lock_guard< std::mutex > lock( m_mutex );
+        m_isStopped = true;
+    }
+
+    m_ready.notify_all();
+    m_freed.notify_all();
+}
+
+/**
+ * @brief Gets the number of frames replaced before they were rendered.
+ * @return Dropped frame count.
+ */
+uint64_t RenderPipeline::getDroppedFrames() const {
+    std::lock_guard< std::mutex > lock( m_mutex );
+    return m_droppedFrames;
+}
+
+/**
+ * @brief Finds a snapshot in a given state.
+ * @param state State to look for.
+ * @return Index of the snapshot, or -1 if none.
+ */
+int RenderPipeline::find( const SnapshotState state ) const {
+    for ( int i = 0; i < SnapshotCount; ++i ) {
+        if ( m_states[i] == state ) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+} // namespace SquirrelEngine
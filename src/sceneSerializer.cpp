@@ -0,0 +1,601 @@
+/**
+ *
+ * @file sceneSerializer.cpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief Implements the SceneSerializer class, which saves and loads the
+ * entities of a World as diffable text or packed binary in SquirrelEngine.
+ * @date 2025-06-06
+ *
+ */
+
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+
+#include <fmt/core.h>
+
+#include "cameraComponent.hpp"
+#include "dataRecord.hpp"
+#include "entity.hpp"
+#include "mesh.hpp"
+#include "model.hpp"
+#include "sceneSerializer.hpp"
+#include "shader.hpp"
+#include "world.hpp"
+#include "utils/trace.hpp"
+
+namespace SquirrelEngine {
+
+namespace {
+
+const char sceneMagic[4] = { 'S', 'Q', 'S', 'C' };
+constexpr uint32_t sceneVersion = 2;
+
+/**
+ * @brief Start of a binary scene.
+ */
+struct SceneHeader {
+    char magic[4];         //!< "SQSC".
+    uint32_t version;      //!< Format version.
+    uint32_t sectionCount; //!< Sections that follow.
+    uint32_t entityCount;  //!< Entities in the scene.
+};
+
+/**
+ * @brief Kinds of section in a binary scene.
+ */
+enum SectionType : uint32_t {
+    ST_Strings = 0,
+    ST_Entities,
+    ST_Models,
+    ST_Cameras
+};
+
+/**
+ * @brief Start of one array in a binary scene.
+ */
+struct SectionHeader {
+    uint32_t type;        //!< SectionType.
+    uint32_t elementSize; //!< Bytes per record, checked against this build.
+    uint64_t count;       //!< Records in the section.
+};
+
+static_assert( sizeof( SceneHeader ) == 16, "SceneHeader must be 16 bytes" );
+static_assert( sizeof( SectionHeader ) == 16,
+               "SectionHeader must be 16 bytes" );
+
+/**
+ * @brief Writes one array as a section.
+ * @param file File to write to.
+ * @param type Kind of section.
+ * @param records Records to write.
+ */
+template < class T >
+void writeSection( std::ofstream& file, const SectionType type,
+                   const std::vector< T >& records ) {
+    const SectionHeader header = { type, sizeof( T ), records.size() };
+    file.write( reinterpret_cast< const char* >( &header ), sizeof( header ) );
+    file.write( reinterpret_cast< const char* >( records.data() ),
+                records.size() * sizeof( T ) );
+}
+
+/**
+ * @brief Reads one section straight into its array.
+ * @param file File positioned after the section header.
+ * @param header Header of the section.
+ * @param records Resized and filled with the records.
+ * @return true if the record size matches and the records were read.
+ */
+template < class T >
+bool readSection( std::ifstream& file, const SectionHeader& header,
+                  std::vector< T >& records ) {
+    if ( header.elementSize != sizeof( T ) ) {
+        return false;
+    }
+
+    records.resize( header.count );
+    file.read( reinterpret_cast< char* >( records.data() ),
+               header.count * sizeof( T ) );
+    return static_cast< bool >( file );
+}
+
+/**
+ * @brief Loads a model's mesh and shader, or shares the mesh of an earlier
+ * model with the same files so a scene of copies uploads each file once.
+ * @param model Model to initialize.
+ * @param mesh Model file name.
+ * @param vert Vertex shader file name, empty for none.
+ * @param frag Fragment shader file name.
+ * @param loaded Meshes loaded so far, by their files.
+ */
+void initModel( Model* model, const std::string& mesh, const std::string& vert,
+                const std::string& frag,
+                std::unordered_map< std::string, std::shared_ptr< Mesh > >&
+                    loaded ) {
+    const std::string key = mesh + '\n' + vert + '\n' + frag;
+
+    auto found = loaded.find( key );
+    if ( found != loaded.end() ) {
+        model->setMesh( found->second );
+        return;
+    }
+
+    model->initMesh( mesh );
+    if ( !vert.empty() ) {
+        model->initShader( vert, frag );
+    }
+    loaded.emplace( key, model->getSharedMesh() );
+}
+
+} // namespace
+
+/**
+ * @brief Appends a string to the string table.
+ * @param text String to add.
+ * @return Offset of the string.
+ */
+uint32_t SceneData::addString( const std::string& text ) {
+    const uint32_t offset = static_cast< uint32_t >( strings.size() );
+    strings.insert( strings.end(), text.begin(), text.end() );
+    strings.push_back( '\0' );
+    return offset;
+}
+
+/**
+ * @brief Gets a string from the string table.
+ * @param offset Offset from addString.
+ * @return The string, empty for NoString or a bad offset.
+ */
+const char* SceneData::getString( const uint32_t offset ) const {
+    if ( offset >= strings.size() ) {
+        return "";
+    }
+
+    return strings.data() + offset;
+}
+
+/**
+ * @brief Empties every array.
+ */
+void SceneData::clear() {
+    strings.clear();
+    entities.clear();
+    models.clear();
+    cameras.clear();
+}
+
+/**
+ * @brief Copies the entities of a world into flat arrays.
+ * @param world World to capture.
+ * @param scene Cleared, then filled with the world.
+ */
+void SceneSerializer::capture( World& world, SceneData& scene ) {
+    scene.clear();
+
+    // Thousands of entities share a handful of asset files
+    std::unordered_map< std::string, uint32_t > offsets;
+    auto intern = [&scene, &offsets]( const std::string& text ) {
+        if ( text.empty() ) {
+            return NoString;
+        }
+
+        auto [it, inserted] = offsets.emplace( text, 0 );
+        if ( inserted ) {
+            it->second = scene.addString( text );
+        }
+        return it->second;
+    };
+
+    auto& entityList = world.getEntityList();
+    scene.entities.reserve( entityList.size() );
+
+    for ( auto& entity : entityList ) {
+        const uint32_t index = static_cast< uint32_t >( scene.entities.size() );
+        const Quaternion& rotation = entity->transform.getRotation();
+
+        EntityRecord record;
+        record.name = intern( entity->name );
+        record.id = entity->id;
+        record.position = entity->transform.getPosition();
+        record.rotation[0] = rotation.w;
+        record.rotation[1] = rotation.i;
+        record.rotation[2] = rotation.j;
+        record.rotation[3] = rotation.k;
+        record.scale = entity->transform.getScale();
+        record.tags = static_cast< uint32_t >(
+            world.getTags( entity.get() ).to_ulong() );
+        scene.entities.push_back( record );
+
+        for ( Model* model : entity->findComponents< Model >() ) {
+            const Mesh* mesh = model->getMesh();
+            const Program* shader = mesh ? mesh->getShader() : nullptr;
+
+            ModelRecord modelRecord;
+            modelRecord.entity = index;
+            modelRecord.mesh = intern( mesh ? mesh->getModelName() : "" );
+            modelRecord.vertShader =
+                intern( shader ? shader->getFirstFile() : "" );
+            modelRecord.fragShader =
+                intern( shader ? shader->getSecondFile() : "" );
+            scene.models.push_back( modelRecord );
+        }
+
+        for ( CameraComponent* camera :
+              entity->findComponents< CameraComponent >() ) {
+            CameraRecord cameraRecord;
+            cameraRecord.entity = index;
+            cameraRecord.fov = camera->fov;
+            cameraRecord.fnear = camera->fnear;
+            cameraRecord.ffar = camera->ffar;
+            cameraRecord.aspect = camera->aspect;
+            cameraRecord.sensitivity = camera->getSensitivity();
+            cameraRecord.offset = camera->getLocalTransform()->getPosition();
+            cameraRecord.rotation = camera->getEulerRotation();
+            cameraRecord.primary = camera->primary ? 1 : 0;
+            scene.cameras.push_back( cameraRecord );
+        }
+    }
+}
+
+/**
+ * @brief Creates the entities and components of a scene in a world.
+ * @param scene Scene to create.
+ * @param world World to create them in.
+ */
+void SceneSerializer::instantiate( const SceneData& scene, World& world ) {
+    std::vector< Entity* > created;
+    created.reserve( scene.entities.size() );
+    world.reserve( scene.entities.size() );
+
+    for ( const EntityRecord& record : scene.entities ) {
+        Entity* entity =
+            world.createEntity( scene.getString( record.name ), record.id );
+
+        // Rotation first, the translation is stored relative to it
+        entity->transform.setRotation(
+            Quaternion( record.rotation[0], record.rotation[1],
+                        record.rotation[2], record.rotation[3] ) );
+        entity->transform.setPosition( record.position );
+        entity->transform.setScale( record.scale );
+        entity->transform.resetInterpolation();
+        world.setTags( entity, EntityTags( record.tags ) );
+
+        created.push_back( entity );
+    }
+
+    std::unordered_map< std::string, std::shared_ptr< Mesh > > loaded;
+    for ( const ModelRecord& record : scene.models ) {
+        if ( record.entity >= created.size() ) {
+            continue;
+        }
+
+        Model* model = created[record.entity]->createComponent< Model >();
+        if ( record.mesh != NoString ) {
+            initModel( model, scene.getString( record.mesh ),
+                       scene.getString( record.vertShader ),
+                       scene.getString( record.fragShader ), loaded );
+        }
+    }
+
+    for ( const CameraRecord& record : scene.cameras ) {
+        if ( record.entity >= created.size() ) {
+            continue;
+        }
+
+        CameraComponent* camera =
+            created[record.entity]->createComponent< CameraComponent >();
+        camera->fov = record.fov;
+        camera->fnear = record.fnear;
+        camera->ffar = record.ffar;
+        camera->aspect = record.aspect;
+        camera->primary = record.primary != 0;
+        camera->setSensitivity( record.sensitivity );
+        camera->getLocalTransform()->setPosition( record.offset );
+        camera->setPitch( record.rotation.x );
+        camera->setYaw( record.rotation.y );
+        camera->setRoll( record.rotation.z );
+    }
+}
+
+/**
+ * @brief Writes a scene in the binary form.
+ * @param scene Scene to write.
+ * @param filename File to create.
+ * @return true if the file was written.
+ */
+bool SceneSerializer::writeBinary( const SceneData& scene,
+                                   const std::string& filename ) {
+    std::ofstream file( filename, std::ofstream::out | std::ofstream::binary );
+    if ( !file ) {
+        Trace::message( fmt::format( "Unable to create {}.", filename ) );
+        return false;
+    }
+
+    SceneHeader header;
+    std::memcpy( header.magic, sceneMagic, sizeof( sceneMagic ) );
+    header.version = sceneVersion;
+    header.sectionCount = 4;
+    header.entityCount = static_cast< uint32_t >( scene.entities.size() );
+    file.write( reinterpret_cast< const char* >( &header ), sizeof( header ) );
+
+    writeSection( file, ST_Strings, scene.strings );
+    writeSection( file, ST_Entities, scene.entities );
+    writeSection( file, ST_Models, scene.models );
+    writeSection( file, ST_Cameras, scene.cameras );
+
+    return static_cast< bool >( file );
+}
+
+/**
+ * @brief Reads a scene in the binary form. Touches nothing but the scene, so
+ * it is safe on loader threads.
+ * @param filename File to read.
+ * @param scene Filled with the file's records.
+ * @return true if the file is a binary scene with this build's layout.
+ */
+bool SceneSerializer::readBinary( const std::string& filename,
+                                  SceneData& scene ) {
+    scene.clear();
+
+    std::ifstream file( filename, std::ifstream::in | std::ifstream::binary );
+    if ( !file ) {
+        Trace::message( fmt::format( "Unable to open {}.", filename ) );
+        return false;
+    }
+
+    SceneHeader header;
+    file.read( reinterpret_cast< char* >( &header ), sizeof( header ) );
+    if ( !file ||
+         std::memcmp( header.magic, sceneMagic, sizeof( sceneMagic ) ) != 0 ||
+         header.version != sceneVersion ) {
+        Trace::message( fmt::format( "{} is not a binary scene.", filename ) );
+        return false;
+    }
+
+    const std::streamoff headerEnd = file.tellg();
+    file.seekg( 0, std::ifstream::end );
+    const uint64_t fileSize = static_cast< uint64_t >( file.tellg() );
+    file.seekg( headerEnd, std::ifstream::beg );
+
+    for ( uint32_t i = 0; i < header.sectionCount; ++i ) {
+        SectionHeader section;
+        file.read( reinterpret_cast< char* >( &section ), sizeof( section ) );
+        if ( !file ) {
+            break;
+        }
+
+        // Counts come from the file, check them before allocating or seeking
+        const uint64_t remaining =
+            fileSize - static_cast< uint64_t >( file.tellg() );
+        if ( section.elementSize != 0 &&
+             section.count > remaining / section.elementSize ) {
+            Trace::message( fmt::format( "{} is truncated.", filename ) );
+            scene.clear();
+            return false;
+        }
+
+        bool isRead = true;
+        switch ( section.type ) {
+        case ST_Strings:
+            isRead = readSection( file, section, scene.strings );
+            break;
+        case ST_Entities:
+            isRead = readSection( file, section, scene.entities );
+            break;
+        case ST_Models:
+            isRead = readSection( file, section, scene.models );
+            break;
+        case ST_Cameras:
+            isRead = readSection( file, section, scene.cameras );
+            break;
+        default:
+            // Written by a newer build, skip what this one doesn't know
+            file.seekg( section.elementSize * section.count,
+                        std::ifstream::cur );
+            break;
+        }
+
+        if ( !isRead ) {
+            Trace::message( fmt::format(
+                "{} was saved with a different record layout.", filename ) );
+            scene.clear();
+            return false;
+        }
+    }
+
+    if ( !file || scene.entities.size() != header.entityCount ) {
+        Trace::message( fmt::format( "{} is truncated.", filename ) );
+        scene.clear();
+        return false;
+    }
+
+    // getString hands out pointers into the table, every one must end
+    if ( !scene.strings.empty() && scene.strings.back() != '\0' ) {
+        Trace::message(
+            fmt::format( "{} has an unterminated string table.", filename ) );
+        scene.clear();
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Writes the entities of a world in the text form.
+ * @param world World to save.
+ * @param filename File to create.
+ * @return true if the file was written.
+ */
+bool SceneSerializer::saveText( World& world, const std::string& filename ) {
+    std::ofstream file( filename, std::ofstream::out );
+    if ( !file ) {
+        Trace::message( fmt::format( "Unable to create {}.", filename ) );
+        return false;
+    }
+
+    file << "# SquirrelEngine scene\n\n";
+
+    DataRecord record;
+    for ( auto& entity : world.getEntityList() ) {
+        record.clear();
+        record.setType( "Entity" );
+        record.set( "name", entity->name );
+        record.set( "id", entity->id );
+        record.set( "position", entity->transform.getPosition() );
+        record.set( "rotation", entity->transform.getRotation() );
+        record.set( "scale", entity->transform.getScale() );
+
+        const EntityTags tags = world.getTags( entity.get() );
+        if ( tags.any() ) {
+            record.set( "tags", static_cast< uint32_t >( tags.to_ulong() ) );
+        }
+        record.write( file );
+
+        for ( Model* model : entity->findComponents< Model >() ) {
+            const Mesh* mesh = model->getMesh();
+            const Program* shader = mesh ? mesh->getShader() : nullptr;
+
+            record.clear();
+            record.setType( "Model" );
+            if ( mesh ) {
+                record.set( "mesh", mesh->getModelName() );
+            }
+            if ( shader ) {
+                record.set( "vert", shader->getFirstFile() );
+                record.set( "frag", shader->getSecondFile() );
+            }
+            record.write( file );
+        }
+
+        for ( CameraComponent* camera :
+              entity->findComponents< CameraComponent >() ) {
+            record.clear();
+            camera->serializeComponent( &record );
+            record.write( file );
+        }
+    }
+
+    return static_cast< bool >( file );
+}
+
+/**
+ * @brief Creates the entities of a text scene in a world.
+ * @param filename File to read.
+ * @param world World to create them in.
+ * @return true if the file was read.
+ */
+bool SceneSerializer::loadText( const std::string& filename, World& world ) {
+    std::ifstream file( filename, std::ifstream::in );
+    if ( !file ) {
+        Trace::message( fmt::format( "Unable to open {}.", filename ) );
+        return false;
+    }
+
+    // Components belong to the entity above them
+    Entity* entity = nullptr;
+    std::unordered_map< std::string, std::shared_ptr< Mesh > > loaded;
+
+    DataRecord record;
+    while ( DataRecord::read( file, record ) ) {
+        const std::string& type = record.getType();
+
+        if ( type == "Entity" ) {
+            std::string name;
+            uint32_t id = 0;
+            record.get( "name", name );
+            record.get( "id", id );
+            entity = world.createEntity( name, id );
+
+            vector3 position( 0.f );
+            Quaternion rotation;
+            vector3 scale( 1.f );
+            record.get( "position", position );
+            record.get( "rotation", rotation );
+            record.get( "scale", scale );
+
+            entity->transform.setRotation( rotation );
+            entity->transform.setPosition( position );
+            entity->transform.setScale( scale );
+            entity->transform.resetInterpolation();
+
+            uint32_t tags = 0;
+            record.get( "tags", tags );
+            world.setTags( entity, EntityTags( tags ) );
+        } else if ( !entity ) {
+            Trace::message( fmt::format(
+                "{}: [{}] comes before any entity.", filename, type ) );
+        } else if ( type == "Model" ) {
+            Model* model = entity->createComponent< Model >();
+
+            std::string mesh, vert, frag;
+            if ( record.get( "mesh", mesh ) ) {
+                record.get( "vert", vert );
+                record.get( "frag", frag );
+                initModel( model, mesh, vert, frag, loaded );
+            }
+        } else if ( type == "Camera" ) {
+            entity->createComponent< CameraComponent >()->deserializeComponent(
+                &record );
+        } else {
+            Trace::message( fmt::format( "{}: Skipped unknown record [{}].",
+                                         filename, type ) );
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Writes the entities of a world in the binary form.
+ * @param world World to save.
+ * @param filename File to create.
+ * @return true if the file was written.
+ */
+bool SceneSerializer::saveBinary( World& world, const std::string& filename ) {
+    SceneData scene;
+    capture( world, scene );
+    return writeBinary( scene, filename );
+}
+
+/**
+ * @brief Creates the entities of a binary scene in a world.
+ * @param filename File to read.
+ * @param world World to create them in.
+ * @return true if the file was read.
+ */
+bool SceneSerializer::loadBinary( const std::string& filename, World& world ) {
+    SceneData scene;
+    if ( !readBinary( filename, scene ) ) {
+        return false;
+    }
+
+    instantiate( scene, world );
+    return true;
+}
+
+/**
+ * @brief Creates the entities of a scene in either form, told apart by the
+ * binary header.
+ * @param filename File to read.
+ * @param world World to create them in.
+ * @return true if the file was read.
+ */
+bool SceneSerializer::load( const std::string& filename, World& world ) {
+    return isBinary( filename ) ? loadBinary( filename, world )
+                                : loadText( filename, world );
+}
+
+/**
+ * @brief Checks if a file starts with the binary header.
+ * @param filename File to check.
+ * @return true if the file is a binary scene.
+ */
+bool SceneSerializer::isBinary( const std::string& filename ) {
+    std::ifstream file( filename, std::ifstream::in | std::ifstream::binary );
+
+    char magic[4] = {};
+    file.read( magic, sizeof( magic ) );
+    return file && std::memcmp( magic, sceneMagic, sizeof( sceneMagic ) ) == 0;
+}
+
+} // namespace SquirrelEngine
@@ -9,6 +9,7 @@
  */
 
 #include <fstream>
+#include <utility>
 
 #include "core.hpp"
 #include "shader.hpp"
@@ -39,7 +40,7 @@ const std::string ShaderBase::readFile( const std::string& FileName ) {
     std::ifstream file( FileName );
     if ( !file.is_open() ) {
         Trace::message( fmt::format( "Failed to open shader {}.", FileName ) );
-        return nullptr;
+        return content;
     }
 
     std::string line = "";
@@ -67,6 +68,10 @@ void ShaderBase::getCompileStatus( const std::string& filename ) {
         GLchar* infoLog = new GLchar[logSize];
         glGetShaderInfoLog( m_handle, logSize, &logSize, infoLog );
         glDeleteShader( m_handle );
+        ResourceTracker::released( GR_Shader );
+
+        // The destructor would delete the name again, maybe after reuse
+        m_handle = 0;
         Trace::message(
             fmt::format( "Vertex Shader {}: {}\n", filename, infoLog ) );
         delete[] infoLog;
@@ -88,27 +93,61 @@ GLuint ShaderBase::getLocation( const char* locationName ) {
  * @brief Constructs a Shader from a file.
  * @param filename Path to the shader file.
  */
-Shader::Shader( const std::string& filename )
+Shader::Shader( const std::string& filename ) : Shader( filename, true ) {}
+
+/**
+ * @brief Constructs a Shader from a file, optionally without waiting for the
+ * driver to finish compiling it.
+ * @param filename Path to the shader file.
+ * @param waitForCompile Whether to query the compile status immediately.
+ */
+Shader::Shader( const std::string& filename, const bool waitForCompile )
     : m_type( typeFromName( filename ) ) {
     m_handle = glCreateShader( m_type );
+    ResourceTracker::created( GR_Shader );
 
+    // An empty source makes the link fail, so a file that vanished mid-save
+    // keeps the previous program instead of throwing out of a reload
     std::string sourceStr = readFile( filename );
     const char* source = sourceStr.c_str();
-    if ( !source ) {
+    if ( sourceStr.empty() ) {
         Trace::message( fmt::format( "Bad source file: {}", filename ) );
-        return;
     }
 
     glShaderSource( m_handle, 1, &source, nullptr );
     glCompileShader( m_handle );
 
-    getCompileStatus( filename );
+    // Querying the status here would stall until the driver is done
+    if ( waitForCompile ) {
+        getCompileStatus( filename );
+    }
+}
+
+/**
+ * @brief Constructs a Shader from source held in memory.
+ * @param t_type Shader type (e.g., GL_VERTEX_SHADER).
+ * @param source GLSL source code.
+ * @param name Name used when reporting compile errors.
+ */
+Shader::Shader( const GLenum t_type, const char* source,
+                const std::string& name )
+    : ShaderBase( glCreateShader( t_type ) ), m_type( t_type ) {
+    ResourceTracker::created( GR_Shader );
+    glShaderSource( m_handle, 1, &source, nullptr );
+    glCompileShader( m_handle );
+
+    getCompileStatus( name );
 }
 
 /**
  * @brief Destructor for Shader.
  */
-Shader::~Shader() { glDeleteShader( m_handle ); }
+Shader::~Shader() {
+    if ( m_handle ) {
+        glDeleteShader( m_handle );
+        ResourceTracker::released( GR_Shader );
+    }
+}
 
 /**
  * @brief Gets the type of the shader (e.g., GL_VERTEX_SHADER).
@@ -122,6 +161,13 @@ GLenum Shader::getType() const { return m_type; }
  */
 GLuint Shader::getHandle() const { return m_handle; }
 
+/**
+ * @brief Gives up ownership of the OpenGL handle, so the destructor no longer
+ * deletes it.
+ * @return Shader handle as GLuint.
+ */
+GLuint Shader::release() { return std::exchange( m_handle, 0 ); }
+
 /**
  * @brief Determines the shader type from the filename extension.
  * @param filename Path to the shader file.
@@ -151,13 +197,17 @@ GLenum Shader::typeFromName( const std::string& filename ) {
  * @brief Copy constructor for Program.
  * @param other Program to copy from.
  */
-Program::Program( const Program& other ) : ShaderBase( other.m_handle ) {}
+Program::Program( const Program& other )
+    : ShaderBase( other.m_handle ), m_status( other.m_status ),
+      m_firstFile( other.m_firstFile ), m_secondFile( other.m_secondFile ) {}
 
 /**
  * @brief Copy constructor from pointer for Program.
  * @param other Pointer to Program to copy from.
  */
-Program::Program( const Program* other ) : ShaderBase( other->m_handle ) {}
+Program::Program( const Program* other )
+    : ShaderBase( other->m_handle ), m_status( other->m_status ),
+      m_firstFile( other->m_firstFile ), m_secondFile( other->m_secondFile ) {}
 
 /**
  * @brief Constructs a Program from two shaders.
@@ -166,10 +216,14 @@ Program::Program( const Program* other ) : ShaderBase( other->m_handle ) {}
  */
 Program::Program( const Shader& first, const Shader& second )
     : ShaderBase( glCreateProgram() ) {
+    ResourceTracker::created( GR_Program );
+
     glAttachShader( m_handle, first.getHandle() );
     glAttachShader( m_handle, second.getHandle() );
 
     glLinkProgram( m_handle );
+
+    checkLinkStatus();
 }
 
 /**
@@ -178,20 +232,50 @@ Program::Program( const Shader& first, const Shader& second )
  * @param secondFile Fragment shader file.
  */
 Program::Program( const std::string& firstFile, const std::string& secondFile )
-    : ShaderBase( glCreateProgram() ) {
-    Shader first( firstFile );
-    Shader second( secondFile );
+    : Program( firstFile, secondFile, true ) {}
+
+/**
+ * @brief Constructs a Program from two shader files, optionally leaving the
+ * compile and link running in the driver.
+ * @param firstFile Vertex shader file.
+ * @param secondFile Fragment shader file.
+ * @param waitForLink Whether to query the link status immediately.
+ */
+Program::Program( const std::string& firstFile, const std::string& secondFile,
+                  const bool waitForLink )
+    : ShaderBase( glCreateProgram() ), m_firstFile( firstFile ),
+      m_secondFile( secondFile ) {
+    ResourceTracker::created( GR_Program );
+
+    // Shaders are only flagged for deletion while attached, so they stay
+    // alive until the program is deleted
+    Shader first( firstFile, waitForLink );
+    Shader second( secondFile, waitForLink );
 
     glAttachShader( m_handle, first.getHandle() );
     glAttachShader( m_handle, second.getHandle() );
 
     glLinkProgram( m_handle );
+
+    if ( waitForLink ) {
+        checkLinkStatus();
+        return;
+    }
+
+    // The compile logs are only read once the link resolves, so the shaders
+    // have to outlive this constructor
+    m_shaders[0] = first.release();
+    m_shaders[1] = second.release();
 }
 
 /**
  * @brief Destructor for Program.
  */
-Program::~Program() { glDeleteProgram( m_handle ); }
+Program::~Program() {
+    releaseShaders( false );
+    glDeleteProgram( m_handle );
+    ResourceTracker::released( GR_Program );
+}
 
 /**
  * @brief Gets the OpenGL handle for the program.
@@ -199,4 +283,121 @@ Program::~Program() { glDeleteProgram( m_handle ); }
  */
 GLuint Program::getHandle() const { return m_handle; }
 
+/**
+ * @brief Resolves a pending link once the driver has finished it.
+ * @param canQueryCompletion Whether GL_COMPLETION_STATUS_KHR is available.
+ * @return true if the program is no longer pending.
+ */
+bool Program::pollStatus( const bool canQueryCompletion ) {
+    if ( m_status != PS_Pending ) {
+        return true;
+    }
+
+    if ( canQueryCompletion ) {
+        GLint completed = GL_FALSE;
+        glGetProgramiv( m_handle, GL_COMPLETION_STATUS_KHR, &completed );
+        if ( completed == GL_FALSE ) {
+            return false;
+        }
+    }
+
+    checkLinkStatus();
+    return true;
+}
+
+/**
+ * @brief Gets the link state of the program.
+ * @return Current ProgramStatus.
+ */
+Program::ProgramStatus Program::getStatus() const { return m_status; }
+
+/**
+ * @brief Checks if the program linked and can be used for drawing.
+ * @return true if the program is ready.
+ */
+bool Program::isReady() const { return m_status == PS_Ready; }
+
+/**
+ * @brief Exchanges the OpenGL program and link state with another program, so
+ * users holding a pointer pick up a rebuilt program.
+ * @param other Program to swap with.
+ */
+void Program::swap( Program& other ) {
+    std::swap( m_handle, other.m_handle );
+    std::swap( m_status, other.m_status );
+    std::swap( m_shaders, other.m_shaders );
+}
+
+/**
+ * @brief Gets the vertex shader file the program was built from.
+ * @return File name, empty if not built from files.
+ */
+const std::string& Program::getFirstFile() const { return m_firstFile; }
+
+/**
+ * @brief Gets the fragment shader file the program was built from.
+ * @return File name, empty if not built from files.
+ */
+const std::string& Program::getSecondFile() const { return m_secondFile; }
+
+/**
+ * @brief Queries the link status and reports errors to Trace.
+ */
+void Program::checkLinkStatus() {
+    GLint success = 0;
+    GLint logSize = 0;
+
+    glGetProgramiv( m_handle, GL_LINK_STATUS, &success );
+    if ( success == GL_FALSE ) {
+        glGetProgramiv( m_handle, GL_INFO_LOG_LENGTH, &logSize );
+        GLchar* infoLog = new GLchar[logSize + 1];
+        infoLog[0] = '\0';
+        glGetProgramInfoLog( m_handle, logSize + 1, &logSize, infoLog );
+        Trace::message( fmt::format( "Program {} + {}: {}\n", m_firstFile,
+                                     m_secondFile, infoLog ) );
+        delete[] infoLog;
+
+        m_status = PS_Failed;
+        releaseShaders( true );
+        return;
+    }
+
+    m_status = PS_Ready;
+    releaseShaders( false );
+}
+
+/**
+ * @brief Detaches and deletes the shaders kept for a pending link.
+ * @param reportErrors Whether to report shaders that failed to compile.
+ */
+void Program::releaseShaders( const bool reportErrors ) {
+    const std::string* files[2] = { &m_firstFile, &m_secondFile };
+
+    for ( unsigned i = 0; i < 2; ++i ) {
+        if ( !m_shaders[i] ) {
+            continue;
+        }
+
+        GLint compiled = GL_TRUE;
+        if ( reportErrors ) {
+            glGetShaderiv( m_shaders[i], GL_COMPILE_STATUS, &compiled );
+        }
+        if ( compiled == GL_FALSE ) {
+            GLint logSize = 0;
+            glGetShaderiv( m_shaders[i], GL_INFO_LOG_LENGTH, &logSize );
+            GLchar* infoLog = new GLchar[logSize + 1];
+            infoLog[0] = '\0';
+            glGetShaderInfoLog( m_shaders[i], logSize + 1, &logSize, infoLog );
+            Trace::message(
+                fmt::format( "Shader {}: {}\n", *files[i], infoLog ) );
+            delete[] infoLog;
+        }
+
+        glDetachShader( m_handle, m_shaders[i] );
+        glDeleteShader( m_shaders[i] );
+        ResourceTracker::released( GR_Shader );
+        m_shaders[i] = 0;
+    }
+}
+
 } // namespace SquirrelEngine
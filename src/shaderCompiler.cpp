@@ -0,0 +1,328 @@
+/**
+ *
+ * @file shaderCompiler.cpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief Implements the ShaderCompiler class, which batches shader program
+ * builds so the driver can compile them in parallel in SquirrelEngine.
+ * @date 2025-06-06
+ *
+ */
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <algorithm>
+
+#include "core.hpp"
+#include "shader.hpp"
+#include "shaderCompiler.hpp"
+#include "utils/file_watcher.hpp"
+
+namespace SquirrelEngine {
+
+/**
+ * @brief Signature of glMaxShaderCompilerThreadsKHR/ARB.
+ */
+typedef void ( *MaxShaderCompilerThreadsProc )( GLuint count );
+
+/**
+ * @brief Vertex shader of the fallback program.
+ */
+static const char* fallbackVertSource = R"(#version 460 core
+layout (location = 0) in vec3 vertexPos;
+
+layout(std140, binding = 0) uniform PerFrameData {
+  mat4 view;
+  mat4 projection;
+  vec4 cameraPos;
+};
+
+uniform mat4 model;
+
+void main()
+{
+    gl_Position = projection * view * model * vec4(vertexPos, 1.0);
+})";
+
+/**
+ * @brief Fragment shader of the fallback program.
+ */
+static const char* fallbackFragSource = R"(#version 460 core
+out vec4 color;
+
+void main()
+{
+    color = vec4(1.0, 0.0, 1.0, 1.0);
+})";
+
+/**
+ * @brief Default constructor for ShaderCompiler.
+ */
+ShaderCompiler::ShaderCompiler() {}
+
+/**
+ * @brief Destructor for ShaderCompiler.
+ */
+ShaderCompiler::~ShaderCompiler() {}
+
+/**
+ * @brief Enables parallel compilation and builds the fallback program.
+ * @param t_owner Pointer to the Engine that owns this system.
+ * @return StartupErrors indicating success or failure.
+ */
+StartupErrors ShaderCompiler::initialize( Engine* t_owner ) {
+    System::initialize( t_owner );
+
+    MaxShaderCompilerThreadsProc maxThreads = nullptr;
+    if ( glfwExtensionSupported( "GL_KHR_parallel_shader_compile" ) ) {
+        maxThreads = reinterpret_cast< MaxShaderCompilerThreadsProc >(
+            glfwGetProcAddress( "glMaxShaderCompilerThreadsKHR" ) );
+    } else if ( glfwExtensionSupported( "GL_ARB_parallel_shader_compile" ) ) {
+        maxThreads = reinterpret_cast< MaxShaderCompilerThreadsProc >(
+            glfwGetProcAddress( "glMaxShaderCompilerThreadsARB" ) );
+    }
+
+    if ( maxThreads ) {
+        // 0xFFFFFFFF lets the driver pick how many threads to use
+        maxThreads( 0xFFFFFFFF );
+        m_parallelSupported = true;
+    } else {
+        Trace::message( "Parallel shader compile not supported, shader "
+                        "builds will block." );
+    }
+
+    Shader vert( GL_VERTEX_SHADER, fallbackVertSource, "fallback.vert" );
+    Shader frag( GL_FRAGMENT_SHADER, fallbackFragSource, "fallback.frag" );
+    m_fallback = std::make_unique< Program >( vert, frag );
+
+    if ( !m_fallback->isReady() ) {
+        return StartupErrors::SE_SystemFailedInit;
+    }
+
+#ifndef NDEBUG
+    setHotReload( true );
+#endif
+
+    return StartupErrors::SE_Success;
+}
+
+/**
+ * @brief Stops watching files and deletes every program. Meshes must not draw
+ * with programs from the compiler afterwards.
+ */
+void ShaderCompiler::shutdown() {
+    m_watcher.reset();
+
+    // Deleting a program the driver is still building is allowed
+    m_reloads.clear();
+    m_pending.clear();
+    m_programs.clear();
+    m_fallback.reset();
+}
+
+/**
+ * @brief Resolves any builds the driver has finished, unless the render thread
+ * does it.
+ * @param delta Time elapsed since last update.
+ */
+void ShaderCompiler::update( const float ) {
+    if ( !m_isRenderThreadResolved ) {
+        resolve();
+    }
+}
+
+/**
+ * @brief Resolves any builds the driver has finished and submits hot reloads.
+ * Must run on the thread that owns the OpenGL context.
+ */
+void ShaderCompiler::resolve() {
+    if ( m_watcher ) {
+        submitReloads();
+        resolveReloads();
+    }
+
+    if ( m_pending.empty() ) {
+        return;
+    }
+
+    // Without completion queries the status query blocks, so only resolve
+    // one build per frame in that case
+    if ( !m_parallelSupported ) {
+        m_pending.front()->pollStatus( false );
+        m_pending.erase( m_pending.begin() );
+        return;
+    }
+
+    auto finished = std::remove_if(
+        m_pending.begin(), m_pending.end(),
+        []( Program* program ) { return program->pollStatus( true ); } );
+    m_pending.erase( finished, m_pending.end() );
+}
+
+/**
+ * @brief Hands resolving over to the render thread, which calls resolve()
+ * itself, so update() stops touching OpenGL.
+ * @param enabled Whether the render thread resolves builds.
+ */
+void ShaderCompiler::setResolveOnRenderThread( const bool enabled ) {
+    m_isRenderThreadResolved = enabled;
+}
+
+/**
+ * @brief Submits a program build, or returns the existing program if the same
+ * pair of files was already requested.
+ * @param vertName Vertex shader file name.
+ * @param fragName Fragment shader file name.
+ * @return Pointer to the program, which may still be pending.
+ */
+Program* ShaderCompiler::requestProgram( const std::string& vertName,
+                                         const std::string& fragName ) {
+    for ( auto& program : m_programs ) {
+        if ( program->getFirstFile() == vertName &&
+             program->getSecondFile() == fragName ) {
+            return program.get();
+        }
+    }
+
+    m_programs.emplace_back(
+        std::make_unique< Program >( vertName, fragName, false ) );
+
+    if ( m_watcher ) {
+        m_watcher->watch( vertName );
+        m_watcher->watch( fragName );
+    }
+
+    Program* program = m_programs.back().get();
+    m_pending.push_back( program );
+
+    return program;
+}
+
+/**
+ * @brief Blocks until every submitted build has finished.
+ */
+void ShaderCompiler::waitForAll() {
+    for ( Program* program : m_pending ) {
+        program->pollStatus( false );
+    }
+
+    m_pending.clear();
+}
+
+/**
+ * @brief Gets the program to draw with while another one is not ready.
+ * @return Pointer to the fallback program.
+ */
+Program* ShaderCompiler::getFallbackProgram() const { return m_fallback.get(); }
+
+/**
+ * @brief Gets the number of builds still running in the driver.
+ * @return Number of pending programs.
+ */
+size_t ShaderCompiler::getPendingCount() const { return m_pending.size(); }
+
+/**
+ * @brief Checks if the driver reports completion without blocking.
+ * @return true if GL_KHR/ARB_parallel_shader_compile is supported.
+ */
+bool ShaderCompiler::isParallelSupported() const {
+    return m_parallelSupported;
+}
+
+/**
+ * @brief Enables or disables rebuilding programs when their files change.
+ * @param enabled Whether to watch shader files.
+ */
+void ShaderCompiler::setHotReload( const bool enabled ) {
+    if ( !enabled ) {
+        m_watcher.reset();
+        m_reloads.clear();
+        return;
+    }
+
+    if ( m_watcher ) {
+        return;
+    }
+
+    m_watcher = std::make_unique< FileWatcher >();
+    for ( auto& program : m_programs ) {
+        m_watcher->watch( program->getFirstFile() );
+        m_watcher->watch( program->getSecondFile() );
+    }
+}
+
+/**
+ * @brief Checks if shader files are being watched.
+ * @return true if hot reload is enabled.
+ */
+bool ShaderCompiler::isHotReloadEnabled() const { return m_watcher != nullptr; }
+
+/**
+ * @brief Submits rebuilds for programs using any changed file.
+ */
+void ShaderCompiler::submitReloads() {
+    if ( !m_watcher->poll( m_changedFiles ) ) {
+        return;
+    }
+
+    for ( auto& program : m_programs ) {
+        const bool changed =
+            std::find( m_changedFiles.begin(), m_changedFiles.end(),
+                       program->getFirstFile() ) != m_changedFiles.end() ||
+            std::find( m_changedFiles.begin(), m_changedFiles.end(),
+                       program->getSecondFile() ) != m_changedFiles.end();
+        if ( !changed ) {
+            continue;
+        }
+
+        auto build = std::make_unique< Program >(
+            program->getFirstFile(), program->getSecondFile(), false );
+
+        // Replace an older rebuild that hasn't finished yet
+        auto reloadIt = std::find_if( m_reloads.begin(), m_reloads.end(),
+                                      [&program]( const Reload& reload ) {
+                                          return reload.target == program.get();
+                                      } );
+        if ( reloadIt != m_reloads.end() ) {
+            reloadIt->build = std::move( build );
+        } else {
+            m_reloads.push_back( { program.get(), std::move( build ) } );
+        }
+    }
+}
+
+/**
+ * @brief Swaps in finished rebuilds.
+ */
+void ShaderCompiler::resolveReloads() {
+    auto finished = std::remove_if(
+        m_reloads.begin(), m_reloads.end(), [this]( Reload& reload ) {
+            if ( !reload.build->pollStatus( m_parallelSupported ) ) {
+                return false;
+            }
+
+            if ( !reload.build->isReady() ) {
+                Trace::message( fmt::format(
+                    "Reload of {} + {} failed, keeping previous program.",
+                    reload.target->getFirstFile(),
+                    reload.target->getSecondFile() ) );
+                return true;
+            }
+
+            // The old program is deleted along with the rebuild
+            reload.target->swap( *reload.build );
+
+            // A program that failed its first build is no longer pending
+            m_pending.erase( std::remove( m_pending.begin(), m_pending.end(),
+                                          reload.target ),
+                             m_pending.end() );
+
+            Trace::message(
+                fmt::format( "Reloaded {} + {}.", reload.target->getFirstFile(),
+                             reload.target->getSecondFile() ) );
+            return true;
+        } );
+    m_reloads.erase( finished, m_reloads.end() );
+}
+
+} // namespace SquirrelEngine
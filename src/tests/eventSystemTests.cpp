@@ -0,0 +1,394 @@
+/**
+ *
+ * @file eventSystemTests.cpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief
+ * @date 2025-06-07
+ *
+ */
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "tests/eventSystemTests.hpp"
+#include "event.hpp"
+#include "eventSystem.hpp"
+#include "utils/timer.hpp"
+#include "utils/trace.hpp"
+
+namespace SquirrelEngine {
+
+namespace EventTests {
+
+Timer timer;
+
+int testCount = 1000000;
+
+// publishManyTypes spreads testCount events over this many types, the
+// recorded time should stay under a second (1M events/s)
+constexpr int typeCount = 100;
+
+template < int N > class TestEvent : public Event {};
+
+template < int N > TestEvent< N > testEvent;
+
+int received = 0;
+
+void onEvent( Object*, Event* ) { ++received; }
+
+void onEvents( Object*, const TestEvent< 0 >*, size_t count ) {
+    received += static_cast< int >( count );
+}
+
+class Listener : public Object {
+public:
+    void onEvent( TestEvent< 0 >& ) { ++count; }
+    void onConstEvent( const TestEvent< 0 >& ) { ++count; }
+
+    int count = 0;
+};
+
+// Raw callbacks downcast both arguments themselves
+void onListenerEvent( Object* obj, Event* event ) {
+    Listener* listener = dynamic_cast< Listener* >( obj );
+    TestEvent< 0 >* testEvent = dynamic_cast< TestEvent< 0 >* >( event );
+    if ( listener && testEvent ) listener->onEvent( *testEvent );
+}
+
+constexpr int producerCount = 16;
+
+class ChannelEvent : public Event {
+public:
+    ChannelEvent() = default;
+    ChannelEvent( const int t_producer, const int t_sequence )
+        : producer( t_producer ), sequence( t_sequence ) {}
+
+    int producer = 0;
+    int sequence = 0;
+};
+
+// Next sequence expected from each producer, checked by onChannelEvents
+std::vector< int > expected;
+int outOfOrder = 0;
+
+void onChannelEvents( Object*, const ChannelEvent* events, size_t count ) {
+    for ( size_t i = 0; i < count; ++i ) {
+        int& next = expected[events[i].producer];
+        if ( events[i].sequence != next ) ++outOfOrder;
+        next = events[i].sequence + 1;
+    }
+    received += static_cast< int >( count );
+}
+
+void countChannelEvents( Object*, const ChannelEvent*, size_t count ) {
+    received += static_cast< int >( count );
+}
+
+// Pushes from producerCount threads while this thread flushes, returns once
+// every producer is done and the channel is empty
+void runProducers( EventSystem& events, EventChannel< ChannelEvent >& channel,
+                   const int perProducer ) {
+    std::atomic< int > running = producerCount;
+    std::vector< std::thread > producers;
+
+    for ( int p = 0; p < producerCount; ++p ) {
+        producers.emplace_back( [&channel, &running, p, perProducer]() {
+            for ( int i = 0; i < perProducer; ++i )
+                channel.push( p, i );
+            --running;
+        } );
+    }
+
+    while ( running > 0 )
+        events.flush();
+    events.flush();
+
+    for ( std::thread& producer : producers )
+        producer.join();
+}
+
+// Flushes once while producerCount threads keep the ring full, returns
+// whether the flush came back before a watchdog stopped the producers
+bool flushUnderLoad() {
+    EventSystem events;
+    EventChannel< ChannelEvent >& channel =
+        events.openChannel< ChannelEvent >( 256, CO_Spill );
+    events.subscribeBatch< ChannelEvent >( nullptr, countChannelEvents );
+
+    std::atomic< bool > stop = false;
+    std::atomic< int > started = 0;
+    std::vector< std::thread > producers;
+
+    for ( int p = 0; p < producerCount; ++p ) {
+        producers.emplace_back( [&channel, &stop, &started, p]() {
+            ++started;
+            for ( int i = 0; !stop; ++i )
+                channel.push( p, i );
+        } );
+    }
+
+    while ( started < producerCount )
+        std::this_thread::yield();
+
+    std::atomic< bool > flushed = false;
+    std::thread watchdog( [&stop, &flushed]() {
+        const auto deadline =
+            std::chrono::steady_clock::now() + std::chrono::seconds( 2 );
+        while ( !flushed && std::chrono::steady_clock::now() < deadline )
+            std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+        stop = true;
+    } );
+
+    events.flush();
+    const bool returned = !stop;
+    flushed = true;
+
+    watchdog.join();
+    for ( std::thread& producer : producers )
+        producer.join();
+    events.flush();
+
+    return returned;
+}
+
+template < int... N >
+void subscribeAll( EventSystem& events, std::integer_sequence< int, N... > ) {
+    ( events.subscribe< TestEvent< N > >( nullptr, onEvent ), ... );
+}
+
+template < int... N >
+void publishAll( EventSystem& events, std::integer_sequence< int, N... > ) {
+    ( events.publish( &testEvent< N > ), ... );
+}
+
+} // namespace EventTests
+
+void EventTests::init() { timer.openFile( "EventSystemTest" ); }
+void EventTests::end() { timer.saveFile(); }
+
+void EventTests::subscribe() {
+    EventSystem events;
+
+    timer.run( [&events]() {
+        for ( int i = 0; i < EventTests::testCount; ++i )
+            events.subscribe< TestEvent< 0 > >( nullptr, onEvent );
+    } );
+}
+
+void EventTests::unsubscribe() {
+    EventSystem events;
+    std::vector< SubscriptionHandle > handles;
+    handles.reserve( EventTests::testCount );
+
+    for ( int i = 0; i < EventTests::testCount; ++i )
+        handles.push_back(
+            events.subscribe< TestEvent< 0 > >( nullptr, onEvent ) );
+
+    // Oldest first, so every removal moves the last subscriber
+    timer.run( [&events, &handles]() {
+        for ( const SubscriptionHandle& handle : handles )
+            events.unsubscribe( handle );
+    } );
+}
+
+void EventTests::churn() {
+    EventSystem events;
+
+    // Every unsubscribe frees its ID for the next subscribe
+    timer.run( [&events]() {
+        for ( int i = 0; i < EventTests::testCount; ++i )
+            events.unsubscribe(
+                events.subscribe< TestEvent< 0 > >( nullptr, onEvent ) );
+    } );
+
+    // An old handle must not remove the subscription that reused its ID
+    const SubscriptionHandle stale =
+        events.subscribe< TestEvent< 0 > >( nullptr, onEvent );
+    events.unsubscribe( stale );
+    const SubscriptionHandle current =
+        events.subscribe< TestEvent< 0 > >( nullptr, onEvent );
+
+    if ( current.id != stale.id || events.unsubscribe( stale ) ||
+         events.getSubscriberCount< TestEvent< 0 > >() != 1 ) {
+        Trace::message( "churn failed: stale handle removed a subscription" );
+    }
+}
+
+void EventTests::publishSingleType() {
+    EventSystem events;
+    events.subscribe< TestEvent< 0 > >( nullptr, onEvent );
+    TestEvent< 0 > event;
+
+    timer.run( [&events, &event]() {
+        for ( int i = 0; i < EventTests::testCount; ++i )
+            events.publish( &event );
+    } );
+}
+
+void EventTests::publishManyTypes() {
+    EventSystem events;
+    subscribeAll( events, std::make_integer_sequence< int, typeCount >() );
+
+    timer.run( [&events]() {
+        for ( int i = 0; i < EventTests::testCount / typeCount; ++i )
+            publishAll( events,
+                        std::make_integer_sequence< int, typeCount >() );
+    } );
+}
+
+void EventTests::enqueue() {
+    EventSystem events;
+
+    timer.run( [&events]() {
+        for ( int i = 0; i < EventTests::testCount; ++i )
+            events.enqueue< TestEvent< 0 > >();
+    } );
+}
+
+void EventTests::flushBatched() {
+    EventSystem events;
+    events.subscribeBatch< TestEvent< 0 > >( nullptr, onEvents );
+
+    // Grow the ring once so the timed frames don't allocate
+    for ( int i = 0; i < 1000; ++i )
+        events.enqueue< TestEvent< 0 > >();
+    events.flush();
+
+    timer.run( [&events]() {
+        for ( int frame = 0; frame < EventTests::testCount / 1000; ++frame ) {
+            for ( int i = 0; i < 1000; ++i )
+                events.enqueue< TestEvent< 0 > >();
+            events.flush();
+        }
+    } );
+}
+
+void EventTests::channelStress() {
+    EventSystem events;
+    EventChannel< ChannelEvent >& channel =
+        events.openChannel< ChannelEvent >( 256, CO_Spill );
+    events.subscribeBatch< ChannelEvent >( nullptr, onChannelEvents );
+
+    const int perProducer = EventTests::testCount / producerCount;
+    expected.assign( producerCount, 0 );
+    outOfOrder = 0;
+    received = 0;
+
+    // Small ring so producers spill a lot
+    timer.run( [&events, &channel, perProducer]() {
+        runProducers( events, channel, perProducer );
+    } );
+
+    const ChannelStats stats = channel.getStats();
+    if ( received != perProducer * producerCount || outOfOrder != 0 ||
+         stats.dropped != 0 ) {
+        Trace::message( fmt::format(
+            "channelStress failed: {} received, {} out of order, {} dropped",
+            received, outOfOrder, stats.dropped ) );
+    }
+
+    // A flush only takes what was pushed when it started, so it comes back
+    // even while producers keep refilling the ring
+    if ( !flushUnderLoad() ) {
+        Trace::message( "channelStress failed: flush waited for producers" );
+    }
+}
+
+void EventTests::channelBounded() {
+    EventSystem events;
+    EventChannel< ChannelEvent >& channel =
+        events.openChannel< ChannelEvent >( 1024, CO_Drop );
+    events.subscribeBatch< ChannelEvent >( nullptr, countChannelEvents );
+
+    const int perProducer = EventTests::testCount / producerCount;
+    received = 0;
+
+    timer.run( [&events, &channel, perProducer]() {
+        runProducers( events, channel, perProducer );
+    } );
+
+    // Every push is either delivered or counted as dropped
+    const ChannelStats stats = channel.getStats();
+    if ( stats.pushed + stats.dropped !=
+             static_cast< uint64_t >( perProducer ) * producerCount ||
+         static_cast< uint64_t >( received ) != stats.pushed ||
+         stats.spilled != 0 ) {
+        Trace::message( fmt::format(
+            "channelBounded failed: {} pushed, {} dropped, {} received",
+            stats.pushed, stats.dropped, received ) );
+    }
+}
+
+void EventTests::channelProducers() {
+    EventSystem events;
+    EventChannel< ChannelEvent >& channel =
+        events.openChannel< ChannelEvent >( 1 << 16, CO_Spill );
+    events.subscribeBatch< ChannelEvent >( nullptr, countChannelEvents );
+
+    const int perProducer = EventTests::testCount / producerCount;
+
+    timer.run( [&events, &channel, perProducer]() {
+        runProducers( events, channel, perProducer );
+    } );
+}
+
+void EventTests::dispatchRaw() {
+    EventSystem events;
+    Listener listener;
+    events.subscribe< TestEvent< 0 > >( &listener, onListenerEvent );
+    TestEvent< 0 > event;
+
+    timer.run( [&events, &event]() {
+        for ( int i = 0; i < EventTests::testCount; ++i )
+            events.publish( &event );
+    } );
+}
+
+void EventTests::dispatchMember() {
+    EventSystem events;
+    Listener listener;
+    events.subscribe< TestEvent< 0 > >( &listener, &Listener::onEvent );
+    TestEvent< 0 > event;
+
+    timer.run( [&events, &event]() {
+        for ( int i = 0; i < EventTests::testCount; ++i )
+            events.publish( &event );
+    } );
+}
+
+void EventTests::dispatchBoundMember() {
+    EventSystem events;
+    Listener listener;
+    events.subscribe< &Listener::onEvent >( &listener );
+    TestEvent< 0 > event;
+
+    timer.run( [&events, &event]() {
+        for ( int i = 0; i < EventTests::testCount; ++i )
+            events.publish( &event );
+    } );
+}
+
+void EventTests::dispatchConstMember() {
+    EventSystem events;
+    Listener listener;
+    events.subscribe( &listener, &Listener::onConstEvent );
+    events.subscribe< &Listener::onConstEvent >( &listener );
+    TestEvent< 0 > event;
+
+    timer.run( [&events, &event]() {
+        for ( int i = 0; i < EventTests::testCount; ++i )
+            events.publish( &event );
+    } );
+
+    // Both handlers take const TestEvent< 0 >&, they must still be reached
+    if ( listener.count != 2 * EventTests::testCount ) {
+        Trace::message(
+            fmt::format( "dispatchConstMember failed: {} of {} delivered",
+                         listener.count, 2 * EventTests::testCount ) );
+    }
+}
+
+} // namespace SquirrelEngine
@@ -0,0 +1,129 @@
+/**
+ *
+ * @file renderPipelineTests.cpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief
+ * @date 2025-06-07
+ *
+ */
+
+#include <thread>
+
+#include "tests/renderPipelineTests.hpp"
+#include "renderPipeline.hpp"
+#include "utils/timer.hpp"
+#include "utils/trace.hpp"
+
+namespace SquirrelEngine {
+
+namespace RenderPipelineTests {
+
+Timer timer;
+
+int testCount = 1000;
+
+// Synthetic heavy scene, every frame builds and walks this many draws
+constexpr int drawCount = 20000;
+
+// Stands in for the simulation, fills the snapshot with moving matrices
+void simulate( RenderSnapshot& snapshot ) {
+    const float t = static_cast< float >( snapshot.frame );
+
+    for ( int i = 0; i < drawCount; ++i ) {
+        matrix4 matrix( 1.f );
+        matrix[3] = vector4( static_cast< float >( i ), t, 0.f, 1.f );
+        snapshot.draws.push_back( { nullptr, matrix } );
+    }
+}
+
+// Stands in for draw submission, only reads the snapshot
+float submit( const RenderSnapshot& snapshot ) {
+    float sum = 0.f;
+    for ( const DrawItem& item : snapshot.draws ) {
+        const vector4 corner = item.matrix * vector4( 1.f, 1.f, 1.f, 1.f );
+        sum += corner.x + corner.y;
+    }
+    return sum;
+}
+
+// Runs testCount frames with submission on a second thread, returns the
+// number of frames rendered
+int runPipelined( RenderPipeline& pipeline ) {
+    int rendered = 0;
+    volatile float sink = 0.f;
+
+    std::thread renderThread( [&pipeline, &rendered, &sink]() {
+        while ( const RenderSnapshot* snapshot = pipeline.beginRead() ) {
+            sink = sink + submit( *snapshot );
+            ++rendered;
+            pipeline.endRead();
+        }
+    } );
+
+    for ( int frame = 0; frame < testCount; ++frame ) {
+        RenderSnapshot& snapshot = pipeline.beginWrite();
+        simulate( snapshot );
+        pipeline.endWrite();
+    }
+
+    pipeline.waitIdle();
+    pipeline.stop();
+    renderThread.join();
+
+    return rendered;
+}
+
+} // namespace RenderPipelineTests
+
+void RenderPipelineTests::init() { timer.openFile( "RenderPipelineTest" ); }
+void RenderPipelineTests::end() { timer.saveFile(); }
+
+void RenderPipelineTests::serial() {
+    RenderSnapshot snapshot;
+    volatile float sink = 0.f;
+
+    timer.run( [&snapshot, &sink]() {
+        for ( int frame = 0; frame < RenderPipelineTests::testCount;
+              ++frame ) {
+            snapshot.draws.clear();
+            snapshot.frame = frame;
+            simulate( snapshot );
+            sink = sink + submit( snapshot );
+        }
+    } );
+}
+
+void RenderPipelineTests::pipelined() {
+    RenderPipeline pipeline;
+    pipeline.setMaxFramesAhead( 1 );
+    int rendered = 0;
+
+    // Should approach half the serial time, simulate and submit overlap
+    timer.run(
+        [&pipeline, &rendered]() { rendered = runPipelined( pipeline ); } );
+
+    if ( rendered != RenderPipelineTests::testCount ) {
+        Trace::message( fmt::format( "pipelined failed: {} of {} rendered",
+                                     rendered,
+                                     RenderPipelineTests::testCount ) );
+    }
+}
+
+void RenderPipelineTests::pipelinedDropLate() {
+    RenderPipeline pipeline;
+    pipeline.setDropLateFrames( true );
+    int rendered = 0;
+
+    timer.run(
+        [&pipeline, &rendered]() { rendered = runPipelined( pipeline ); } );
+
+    // Every frame is either rendered or counted as dropped
+    const uint64_t total = rendered + pipeline.getDroppedFrames();
+    if ( total != static_cast< uint64_t >( RenderPipelineTests::testCount ) ) {
+        Trace::message( fmt::format(
+            "pipelinedDropLate failed: {} rendered, {} dropped", rendered,
+            pipeline.getDroppedFrames() ) );
+    }
+}
+
+} // namespace SquirrelEngine
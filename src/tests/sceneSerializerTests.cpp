@@ -0,0 +1,158 @@
+/**
+ *
+ * @file sceneSerializerTests.cpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief
+ * @date 2025-06-07
+ *
+ */
+
+#include <cstdio>
+#include <string>
+
+#include "tests/sceneSerializerTests.hpp"
+#include "cameraComponent.hpp"
+#include "entity.hpp"
+#include "sceneSerializer.hpp"
+#include "world.hpp"
+#include "utils/timer.hpp"
+#include "utils/trace.hpp"
+
+namespace SquirrelEngine {
+
+namespace SceneSerializerTests {
+
+Timer timer;
+
+// Entities in the saved scene. Models are left out so the scene loads
+// without a GL context, which keeps the timings about the file formats
+int testCount = 100000;
+
+const std::string textFile = "SceneSerializerTest.txt";
+const std::string binaryFile = "SceneSerializerTest.bin";
+
+/**
+ * @brief Fills a world with a grid of named entities and a camera.
+ * @param world World to fill.
+ */
+void buildScene( World& world ) {
+    world.reserve( testCount + 1 );
+
+    for ( int i = 0; i < testCount; ++i ) {
+        Entity* entity =
+            world.createEntity( fmt::format( "Entity{}", i % 100 ), i );
+        const vector3 cell( static_cast< float >( i % 316 ),
+                            static_cast< float >( i % 13 ),
+                            static_cast< float >( i / 316 ) );
+        entity->transform.setRotation(
+            Quaternion::fromAxisAngle( 0.f, 1.f, 0.f, i * 0.01f ) );
+        entity->transform.setPosition( cell * 1.5f );
+        entity->transform.setScale( vector3( 0.5f + ( i % 4 ) * 0.25f ) );
+    }
+
+    Entity* camera = world.createEntity( "Camera", testCount );
+    camera->createComponent< CameraComponent >()->primary = true;
+}
+
+/**
+ * @brief Checks a loaded world against the scene buildScene makes.
+ * @param world World that was loaded.
+ * @param test Name of the test for the report.
+ */
+void verifyScene( World& world, const char* test ) {
+    World expected( "Expected" );
+    buildScene( expected );
+
+    auto& loaded = world.getEntityList();
+    auto& original = expected.getEntityList();
+
+    // Positions go through the transform's dual quaternion, so they come
+    // back within rounding rather than bit for bit
+    constexpr float tolerance = 1e-3f;
+
+    int failures = loaded.size() == original.size() ? 0 : 1;
+    for ( size_t i = 0; i < loaded.size() && i < original.size(); ++i ) {
+        const Transform& a = loaded[i]->transform;
+        const Transform& b = original[i]->transform;
+        if ( loaded[i]->name != original[i]->name ||
+             loaded[i]->id != original[i]->id ||
+             glm::length( a.getPosition() - b.getPosition() ) > tolerance ||
+             a.getScale() != b.getScale() ||
+             a.getRotation().w != b.getRotation().w ||
+             a.getRotation().j != b.getRotation().j ) {
+            ++failures;
+        }
+    }
+
+    if ( loaded.empty() ||
+         loaded.back()->findComponents< CameraComponent >().size() != 1 ) {
+        ++failures;
+    }
+
+    if ( failures != 0 ) {
+        Trace::message( fmt::format( "{} failed: {} of {} entities differ",
+                                     test, failures, original.size() ) );
+    }
+}
+
+} // namespace SceneSerializerTests
+
+void SceneSerializerTests::init() {
+    timer.openFile( "SceneSerializerTest" );
+
+    World world( "Source" );
+    buildScene( world );
+    SceneSerializer::saveText( world, textFile );
+    SceneSerializer::saveBinary( world, binaryFile );
+}
+
+void SceneSerializerTests::end() {
+    timer.saveFile();
+
+    std::remove( textFile.c_str() );
+    std::remove( binaryFile.c_str() );
+}
+
+void SceneSerializerTests::saveText() {
+    World world( "Source" );
+    buildScene( world );
+
+    timer.run( [&]() { SceneSerializer::saveText( world, textFile ); } );
+}
+
+void SceneSerializerTests::saveBinary() {
+    World world( "Source" );
+    buildScene( world );
+
+    timer.run( [&]() { SceneSerializer::saveBinary( world, binaryFile ); } );
+}
+
+void SceneSerializerTests::loadText() {
+    World world( "Text" );
+
+    timer.run( [&]() { SceneSerializer::loadText( textFile, world ); } );
+
+    verifyScene( world, "loadText" );
+}
+
+void SceneSerializerTests::loadBinary() {
+    World world( "Binary" );
+
+    timer.run( [&]() { SceneSerializer::loadBinary( binaryFile, world ); } );
+
+    verifyScene( world, "loadBinary" );
+}
+
+// Only the bulk reads, what a loader thread pays before instantiating
+void SceneSerializerTests::readBinary() {
+    SceneData scene;
+
+    timer.run( [&]() { SceneSerializer::readBinary( binaryFile, scene ); } );
+
+    if ( scene.entities.size() != static_cast< size_t >( testCount ) + 1 ) {
+        Trace::message( fmt::format( "readBinary failed: read {} entities",
+                                     scene.entities.size() ) );
+    }
+}
+
+} // namespace SquirrelEngine
@@ -0,0 +1,99 @@
+/**
+ *
+ * @file timeManagerTests.cpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief
+ * @date 2025-06-07
+ *
+ */
+
+#include <chrono>
+#include <cstdint>
+
+#include "tests/timeManagerTests.hpp"
+#include "utils/time_manager.hpp"
+#include "utils/timer.hpp"
+#include "utils/trace.hpp"
+
+namespace SquirrelEngine {
+
+namespace TimeManagerTests {
+
+Timer timer;
+
+// Simulated weeks of uptime, run at a locked frame time so it takes seconds
+int testCount = 3;
+
+constexpr int64_t weekSeconds = 7 * 24 * 60 * 60;
+constexpr int64_t framesPerSecond = 60;
+
+// 1/60 doesn't divide the 20ms fixed step, so every frame leaves a remainder
+constexpr float frameTime = 1.f / framesPerSecond;
+constexpr float fixedDt = 0.02f;
+
+} // namespace TimeManagerTests
+
+void TimeManagerTests::init() { timer.openFile( "TimeManagerTest" ); }
+void TimeManagerTests::end() { timer.saveFile(); }
+
+void TimeManagerTests::soak() {
+    using namespace std::chrono;
+
+    TimeManager time;
+    time.setFixedDt( fixedDt );
+    time.setLockedDeltaTime( frameTime );
+
+    const nanoseconds frameTicks = round< nanoseconds >(
+        duration< double >( static_cast< double >( frameTime ) ) );
+    const nanoseconds fixedTicks = round< nanoseconds >(
+        duration< double >( static_cast< double >( fixedDt ) ) );
+
+    int failures = 0;
+    int64_t frames = 0;
+    uint64_t weekStartSteps = 0;
+    uint64_t firstWeekSteps = 0;
+
+    timer.run( [&]() {
+        for ( int week = 0; week < TimeManagerTests::testCount; ++week ) {
+            for ( int64_t i = 0; i < weekSeconds * framesPerSecond; ++i ) {
+                time.increment();
+                while ( time.needsFixedUpdate() ) {
+                }
+
+                const float alpha = time.getAlpha();
+                if ( alpha < 0.f || alpha >= 1.f ) ++failures;
+            }
+            frames += weekSeconds * framesPerSecond;
+
+            // Every fixed step the frames paid for has run, no more, no less
+            const uint64_t steps = time.getFixedStepCount();
+            const uint64_t expected =
+                static_cast< uint64_t >( frames * frameTicks / fixedTicks );
+            if ( steps != expected ||
+                 time.getTimeTicks() !=
+                     fixedTicks * static_cast< int64_t >( steps ) ) {
+                ++failures;
+            }
+
+            // Late weeks step as often as the first one, give or take the
+            // step the remainder rolls over into
+            const uint64_t weekSteps = steps - weekStartSteps;
+            if ( week == 0 ) firstWeekSteps = weekSteps;
+            if ( weekSteps + 1 < firstWeekSteps ||
+                 weekSteps > firstWeekSteps + 1 )
+                ++failures;
+            weekStartSteps = steps;
+
+            if ( time.getDroppedFixedSteps() != 0 ) ++failures;
+        }
+    } );
+
+    if ( failures != 0 ) {
+        Trace::message( fmt::format(
+            "soak failed: {} checks over {} weeks, {} steps, {:.3f}s", failures,
+            TimeManagerTests::testCount, time.getFixedStepCount(),
+            time.getTime() ) );
+    }
+}
+
+} // namespace SquirrelEngine
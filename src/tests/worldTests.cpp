@@ -0,0 +1,155 @@
+/**
+ *
+ * @file worldTests.cpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief
+ * @date 2025-06-07
+ *
+ */
+
+#include <string>
+#include <vector>
+
+#include "tests/worldTests.hpp"
+#include "entity.hpp"
+#include "world.hpp"
+#include "utils/timer.hpp"
+#include "utils/trace.hpp"
+
+namespace SquirrelEngine {
+
+namespace WorldTests {
+
+Timer timer;
+
+int testCount = 1000000;
+
+// Entities in the test world, spread over nameCount names so every name is
+// shared, a third static and a tenth shadow casters
+constexpr int entityCount = 100000;
+constexpr int nameCount = 1000;
+
+// removeEntity searches the entity list, so removal runs on a smaller world
+constexpr int removeCount = 10000;
+
+std::vector< std::string > names;
+
+/**
+ * @brief Fills a world with named and tagged entities.
+ * @param world World to fill.
+ * @param count Number of entities to create.
+ */
+void buildWorld( World& world, const int count = entityCount ) {
+    world.reserve( count );
+
+    for ( int i = 0; i < count; ++i ) {
+        Entity* entity = world.createEntity( names[i % nameCount] );
+        if ( i % 3 == 0 ) world.addTag( entity, ET_Static );
+        if ( i % 10 == 0 ) world.addTag( entity, ET_ShadowCaster );
+    }
+}
+
+} // namespace WorldTests
+
+void WorldTests::init() {
+    timer.openFile( "WorldTest" );
+
+    names.clear();
+    for ( int i = 0; i < nameCount; ++i ) {
+        names.push_back( fmt::format( "Entity{:04}", i ) );
+    }
+}
+void WorldTests::end() { timer.saveFile(); }
+
+void WorldTests::findByName() {
+    World world( "Names" );
+    buildWorld( world );
+
+    size_t found = 0;
+    timer.run( [&]() {
+        for ( int i = 0; i < WorldTests::testCount; ++i ) {
+            found += world.findEntities( names[i % nameCount] ).size();
+        }
+    } );
+
+    // Every name is shared by the same number of entities
+    const size_t expected = static_cast< size_t >( WorldTests::testCount ) *
+                            ( entityCount / nameCount );
+    if ( found != expected ) {
+        Trace::message( fmt::format( "findByName failed: found {} of {}",
+                                     found, expected ) );
+    }
+}
+
+// Misses return nullptr instead of throwing
+void WorldTests::findMissing() {
+    World world( "Names" );
+    buildWorld( world );
+
+    int found = 0;
+    timer.run( [&]() {
+        for ( int i = 0; i < WorldTests::testCount; ++i ) {
+            if ( world.findEntity( "Missing" ) ) ++found;
+        }
+    } );
+
+    if ( found != 0 ) {
+        Trace::message(
+            fmt::format( "findMissing failed: found {} entities", found ) );
+    }
+}
+
+void WorldTests::queryTag() {
+    World world( "Tags" );
+    buildWorld( world );
+
+    size_t visited = 0;
+    timer.run( [&]() {
+        for ( int i = 0; i < 100; ++i ) {
+            for ( Entity* entity : world.getTagged( ET_Static ) ) {
+                if ( entity ) ++visited;
+            }
+        }
+    } );
+
+    const size_t expected = 100 * ( ( entityCount + 2 ) / 3 );
+    if ( visited != expected ) {
+        Trace::message( fmt::format( "queryTag failed: visited {} of {}",
+                                     visited, expected ) );
+    }
+}
+
+// Removal keeps the name and tag spans packed and correct
+void WorldTests::removeTagged() {
+    World world( "Tags" );
+    buildWorld( world, removeCount );
+
+    std::vector< Entity* > entities;
+    for ( auto& entity : world.getEntityList() ) {
+        entities.push_back( entity.get() );
+    }
+
+    timer.run( [&]() {
+        for ( size_t i = 0; i < entities.size(); i += 2 ) {
+            world.removeEntity( entities[i] );
+        }
+    } );
+
+    int failures = 0;
+    for ( Entity* entity : world.getTagged( ET_ShadowCaster ) ) {
+        if ( entity->world != &world ||
+             !world.hasTag( entity, ET_ShadowCaster ) )
+            ++failures;
+    }
+    for ( Entity* entity : world.findEntities( names[1] ) ) {
+        if ( entity->name != names[1] ) ++failures;
+    }
+
+    // Every shadow caster was at an even index, so none are left
+    if ( failures != 0 || !world.getTagged( ET_ShadowCaster ).empty() ) {
+        Trace::message( fmt::format( "removeTagged failed: {} stale entries",
+                                     failures ) );
+    }
+}
+
+} // namespace SquirrelEngine
@@ -8,6 +8,8 @@
  *
  */
 
+#include <algorithm>
+
 #include "transform.hpp"
 
 namespace SquirrelEngine {
@@ -15,7 +17,9 @@ namespace SquirrelEngine {
 /**
  * @brief Default constructor for Transform.
  */
-Transform::Transform() : m_transform(), m_scale( 1.f ), m_isDirty( true ) {}
+Transform::Transform()
+    : m_transform(), m_previous(), m_scale( 1.f ), m_previousScale( 1.f ),
+      m_isDirty( true ), m_hasMoved( false ) {}
 
 // Position functions
 
@@ -26,6 +30,7 @@ Transform::Transform() : m_transform(), m_scale( 1.f ), m_isDirty( true ) {}
 void Transform::setPosition( const vector3& t_position ) {
     m_transform.setTranslation( t_position );
     m_isDirty = true;
+    m_hasMoved = true;
 }
 
 /**
@@ -43,6 +48,7 @@ const vector3 Transform::getPosition() const {
 void Transform::move( const vector3& amount ) {
     m_transform.addTranslation( amount );
     m_isDirty = true;
+    m_hasMoved = true;
 }
 
 // Scale functions
@@ -54,6 +60,7 @@ void Transform::move( const vector3& amount ) {
 void Transform::setScale( const vector3& t_scale ) {
     m_scale = t_scale;
     m_isDirty = true;
+    m_hasMoved = true;
 }
 
 /**
@@ -69,6 +76,7 @@ const vector3& Transform::getScale() const { return m_scale; }
 void Transform::scale( const float factor ) {
     m_scale *= factor;
     m_isDirty = true;
+    m_hasMoved = true;
 }
 
 // Rotation functions
@@ -80,6 +88,7 @@ void Transform::scale( const float factor ) {
 void Transform::setRotation( const Quaternion& t_rotation ) {
     m_transform.setRotation( t_rotation );
     m_isDirty = true;
+    m_hasMoved = true;
 }
 
 /**
@@ -105,6 +114,7 @@ const vector3 Transform::getEulerRotation() const {
 void Transform::rotate( const Quaternion& rotation ) {
     m_transform.addRotation( rotation );
     m_isDirty = true;
+    m_hasMoved = true;
 }
 
 /**
@@ -149,6 +159,9 @@ const vector3 Transform::upVector() const {
  * @param direction The direction to look.
  */
 void Transform::look( const vector3& direction ) {
+    m_isDirty = true;
+    m_hasMoved = true;
+
     const float dot = glm::dot( vector3( 0.f, 0.f, -1.f ), direction );
     if ( dot > 0.999999f || dot < -0.999999f ) {
         m_transform.setRotation( Quaternion( 0.f, 0.f, 0.f, 1.f ) );
@@ -181,4 +194,46 @@ const matrix4& Transform::matrix() {
     return m_matrix;
 }
 
+/**
+ * @brief Copies the current state into the previous snapshot. Called before
+ * every fixed step so rendering can interpolate across it.
+ */
+void Transform::storePrevious() {
+    if ( !m_hasMoved ) {
+        return;
+    }
+
+    m_previous = m_transform;
+    m_previousScale = m_scale;
+    m_hasMoved = false;
+}
+
+/**
+ * @brief Makes the previous snapshot match the current state, so the next frame
+ * doesn't interpolate across a teleport.
+ */
+void Transform::resetInterpolation() {
+    m_hasMoved = true;
+    storePrevious();
+}
+
+/**
+ * @brief Gets the transformation matrix between the previous snapshot and the
+ * current state.
+ * @param alpha Blend factor, 0 previous to 1 current.
+ * @return The interpolated transformation matrix.
+ */
+const matrix4 Transform::interpolatedMatrix( const float alpha ) {
+    // Still objects skip the blend and use the cached matrix
+    if ( !m_hasMoved || alpha >= 1.f ) {
+        return matrix();
+    }
+
+    DualQuaternion blended = DualQuaternion::blend( m_previous, m_transform,
+                                                    std::max( alpha, 0.f ) );
+    const vector3 blendedScale = glm::mix( m_previousScale, m_scale, alpha );
+
+    return blended.getMatrix() * glm::scale( matrix4( 1.f ), blendedScale );
+}
+
 } // namespace SquirrelEngine
@@ -0,0 +1,169 @@
+/**
+ *
+ * @file file_watcher.cpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief Implements the FileWatcher class, which reports changes to files on
+ * disk for SquirrelEngine.
+ * @date 2025-06-06
+ *
+ */
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+
+#include "utils/file_watcher.hpp"
+
+namespace SquirrelEngine {
+
+/**
+ * @brief Adds a file name to the list if it isn't there yet
+ *
+ * @param changedFiles List of changed files
+ * @param filename File name to add
+ */
+static void addChanged( std::vector< std::string >& changedFiles,
+                        const std::string& filename ) {
+    if ( std::find( changedFiles.begin(), changedFiles.end(), filename ) ==
+         changedFiles.end() ) {
+        changedFiles.push_back( filename );
+    }
+}
+
+/**
+ * @brief Opens the notification handle
+ *
+ */
+FileWatcher::FileWatcher() {
+#ifndef _WIN32
+    m_fd = inotify_init1( IN_NONBLOCK | IN_CLOEXEC );
+#endif
+}
+
+/**
+ * @brief Closes all notification handles
+ *
+ */
+FileWatcher::~FileWatcher() {
+#ifdef _WIN32
+    for ( auto& [key, directory] : m_directories ) {
+        FindCloseChangeNotification( reinterpret_cast< HANDLE >( key ) );
+    }
+#else
+    if ( m_fd >= 0 ) close( m_fd );
+#endif
+}
+
+/**
+ * @brief Starts watching a file. Its directory is watched so that editors
+ * which save by replacing the file are still seen.
+ *
+ * @param filename File to watch
+ * @return true File is being watched
+ * @return false Watch could not be added
+ */
+bool FileWatcher::watch( const std::string& filename ) {
+    namespace fs = std::filesystem;
+
+    std::error_code error;
+    const fs::path filePath = fs::absolute( filename, error ).lexically_normal();
+    if ( error ) return false;
+
+    const fs::path dirPath = filePath.parent_path();
+    const std::string dirName = dirPath.string();
+
+    auto keyIt = m_watchKeys.find( dirName );
+    if ( keyIt == m_watchKeys.end() ) {
+#ifdef _WIN32
+        HANDLE handle = FindFirstChangeNotificationA(
+            dirName.c_str(), FALSE,
+            FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME );
+        if ( handle == INVALID_HANDLE_VALUE ) return false;
+
+        const intptr_t key = reinterpret_cast< intptr_t >( handle );
+#else
+        if ( m_fd < 0 ) return false;
+
+        const int wd = inotify_add_watch( m_fd, dirName.c_str(),
+                                          IN_CLOSE_WRITE | IN_MOVED_TO );
+        if ( wd < 0 ) return false;
+
+        const intptr_t key = wd;
+#endif
+        keyIt = m_watchKeys.emplace( dirName, key ).first;
+        m_directories[key].path = dirPath;
+    }
+
+    WatchedFile& file =
+        m_directories[keyIt->second].files[filePath.filename().string()];
+    file.filename = filename;
+    file.lastWrite = fs::last_write_time( filePath, error );
+
+    return true;
+}
+
+/**
+ * @brief Collects files that changed since the last poll
+ *
+ * @param changedFiles Cleared, then filled with changed file names
+ * @return true At least one watched file changed
+ * @return false Nothing changed
+ */
+bool FileWatcher::poll( std::vector< std::string >& changedFiles ) {
+    changedFiles.clear();
+
+#ifdef _WIN32
+    for ( auto& [key, directory] : m_directories ) {
+        HANDLE handle = reinterpret_cast< HANDLE >( key );
+        if ( WaitForSingleObject( handle, 0 ) != WAIT_OBJECT_0 ) continue;
+
+        FindNextChangeNotification( handle );
+
+        // Notification is per directory, so compare write times to find
+        // which of the watched files changed
+        for ( auto& [leaf, file] : directory.files ) {
+            std::error_code error;
+            const auto lastWrite =
+                std::filesystem::last_write_time( directory.path / leaf, error );
+            if ( error || lastWrite == file.lastWrite ) continue;
+
+            file.lastWrite = lastWrite;
+            addChanged( changedFiles, file.filename );
+        }
+    }
+#else
+    if ( m_fd < 0 ) return false;
+
+    alignas( inotify_event ) char buffer[4096];
+
+    while ( true ) {
+        const ssize_t length = read( m_fd, buffer, sizeof( buffer ) );
+        if ( length <= 0 ) break;
+
+        for ( ssize_t offset = 0; offset < length; ) {
+            const inotify_event* event =
+                reinterpret_cast< const inotify_event* >( buffer + offset );
+            offset += sizeof( inotify_event ) + event->len;
+
+            if ( event->len == 0 ) continue;
+
+            auto dirIt = m_directories.find( event->wd );
+            if ( dirIt == m_directories.end() ) continue;
+
+            auto fileIt = dirIt->second.files.find( event->name );
+            if ( fileIt == dirIt->second.files.end() ) continue;
+
+            addChanged( changedFiles, fileIt->second.filename );
+        }
+    }
+#endif
+
+    return !changedFiles.empty();
+}
+
+} // namespace SquirrelEngine
@@ -0,0 +1,147 @@
+/**
+ *
+ * @file image_writer.cpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief Implements utilities for writing images to disk in SquirrelEngine.
+ * @date 2025-06-06
+ *
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <vector>
+
+#include "utils/image_writer.hpp"
+
+namespace SquirrelEngine {
+
+/**
+ * @brief Computes the CRC used by PNG chunks
+ *
+ * @param data Bytes to checksum
+ * @param size Number of bytes
+ * @return uint32_t CRC-32 of the bytes
+ */
+static uint32_t crc32( const unsigned char* data, const size_t size ) {
+    static const std::array< uint32_t, 256 > table = []() {
+        std::array< uint32_t, 256 > result = {};
+        for ( uint32_t i = 0; i < 256; ++i ) {
+            uint32_t c = i;
+            for ( int k = 0; k < 8; ++k ) {
+                c = ( c & 1 ) ? 0xEDB88320u ^ ( c >> 1 ) : c >> 1;
+            }
+            result[i] = c;
+        }
+        return result;
+    }();
+
+    uint32_t crc = 0xFFFFFFFFu;
+    for ( size_t i = 0; i < size; ++i ) {
+        crc = table[( crc ^ data[i] ) & 0xFF] ^ ( crc >> 8 );
+    }
+
+    return crc ^ 0xFFFFFFFFu;
+}
+
+/**
+ * @brief Appends a big-endian 32-bit value
+ *
+ * @param out Buffer to append to
+ * @param value Value to append
+ */
+static void putU32( std::vector< unsigned char >& out, const uint32_t value ) {
+    out.push_back( static_cast< unsigned char >( value >> 24 ) );
+    out.push_back( static_cast< unsigned char >( value >> 16 ) );
+    out.push_back( static_cast< unsigned char >( value >> 8 ) );
+    out.push_back( static_cast< unsigned char >( value ) );
+}
+
+/**
+ * @brief Appends a PNG chunk with its length and CRC
+ *
+ * @param out Buffer to append to
+ * @param type Four character chunk type
+ * @param data Chunk payload
+ */
+static void putChunk( std::vector< unsigned char >& out, const char* type,
+                      const std::vector< unsigned char >& data ) {
+    putU32( out, static_cast< uint32_t >( data.size() ) );
+
+    const size_t start = out.size();
+    out.insert( out.end(), type, type + 4 );
+    out.insert( out.end(), data.begin(), data.end() );
+
+    putU32( out, crc32( out.data() + start, out.size() - start ) );
+}
+
+/**
+ * @brief Writes an 8-bit RGBA image as an uncompressed PNG
+ *
+ * @param filename Output file
+ * @param width Image width in pixels
+ * @param height Image height in pixels
+ * @param rgba Pixel data, top row first
+ * @return true File was written
+ * @return false File couldn't be opened
+ */
+bool writePNG( const std::string& filename, const int width, const int height,
+               const unsigned char* rgba ) {
+    std::ofstream file( filename, std::ios::binary );
+    if ( !file ) return false;
+
+    std::vector< unsigned char > png = { 0x89, 'P',  'N',  'G',
+                                         '\r', '\n', 0x1A, '\n' };
+
+    // Header: size, 8 bits per channel, RGBA, no interlacing
+    std::vector< unsigned char > header;
+    putU32( header, static_cast< uint32_t >( width ) );
+    putU32( header, static_cast< uint32_t >( height ) );
+    header.insert( header.end(), { 8, 6, 0, 0, 0 } );
+    putChunk( png, "IHDR", header );
+
+    // Scanlines, each prefixed with filter type 0 (none)
+    const size_t rowSize = static_cast< size_t >( width ) * 4;
+    std::vector< unsigned char > raw;
+    raw.reserve( ( rowSize + 1 ) * height );
+    for ( int y = 0; y < height; ++y ) {
+        raw.push_back( 0 );
+        raw.insert( raw.end(), rgba + y * rowSize, rgba + ( y + 1 ) * rowSize );
+    }
+
+    // zlib stream made of stored (uncompressed) deflate blocks
+    std::vector< unsigned char > zlib = { 0x78, 0x01 };
+    uint32_t adlerA = 1;
+    uint32_t adlerB = 0;
+
+    size_t offset = 0;
+    do {
+        const size_t blockSize =
+            std::min< size_t >( raw.size() - offset, 0xFFFF );
+        const bool isLast = offset + blockSize == raw.size();
+
+        zlib.push_back( isLast ? 1 : 0 );
+        zlib.push_back( static_cast< unsigned char >( blockSize ) );
+        zlib.push_back( static_cast< unsigned char >( blockSize >> 8 ) );
+        zlib.push_back( static_cast< unsigned char >( ~blockSize ) );
+        zlib.push_back( static_cast< unsigned char >( ~blockSize >> 8 ) );
+
+        for ( size_t i = offset; i < offset + blockSize; ++i ) {
+            zlib.push_back( raw[i] );
+            adlerA = ( adlerA + raw[i] ) % 65521;
+            adlerB = ( adlerB + adlerA ) % 65521;
+        }
+
+        offset += blockSize;
+    } while ( offset < raw.size() );
+
+    putU32( zlib, ( adlerB << 16 ) | adlerA );
+    putChunk( png, "IDAT", zlib );
+    putChunk( png, "IEND", {} );
+
+    file.write( reinterpret_cast< const char* >( png.data() ), png.size() );
+    return static_cast< bool >( file );
+}
+
+} // namespace SquirrelEngine
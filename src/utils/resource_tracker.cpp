@@ -0,0 +1,123 @@
+/**
+ *
+ * @file resource_tracker.cpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief Implements the ResourceTracker class, which counts live OpenGL objects
+ * so leaks can be reported on shutdown in SquirrelEngine.
+ * @date 2025-06-06
+ *
+ */
+
+#include <fmt/core.h>
+
+#include "utils/resource_tracker.hpp"
+#include "utils/trace.hpp"
+
+namespace SquirrelEngine {
+
+std::array< std::atomic< int >, GR_Count > ResourceTracker::s_live = {};
+std::array< std::atomic< uint64_t >, GR_Count > ResourceTracker::s_created =
+    {};
+
+/**
+ * @brief Counts OpenGL objects that were just generated
+ *
+ * @param type Kind of object
+ * @param count Number of objects
+ */
+void ResourceTracker::created( const GpuResource type, const int count ) {
+    // Programs are built on the render thread while the simulation loads
+    s_live[type].fetch_add( count, std::memory_order_relaxed );
+    s_created[type].fetch_add( static_cast< uint64_t >( count ),
+                               std::memory_order_relaxed );
+}
+
+/**
+ * @brief Counts OpenGL objects that were just deleted
+ *
+ * @param type Kind of object
+ * @param count Number of objects
+ */
+void ResourceTracker::released( const GpuResource type, const int count ) {
+    s_live[type].fetch_sub( count, std::memory_order_relaxed );
+}
+
+/**
+ * @brief Get the number of objects created and not yet released
+ *
+ * @param type Kind of object
+ * @return int
+ */
+int ResourceTracker::getLiveCount( const GpuResource type ) {
+    return s_live[type].load( std::memory_order_relaxed );
+}
+
+/**
+ * @brief Get the number of objects created since startup
+ *
+ * @param type Kind of object
+ * @return uint64_t
+ */
+uint64_t ResourceTracker::getCreatedCount( const GpuResource type ) {
+    return s_created[type].load( std::memory_order_relaxed );
+}
+
+/**
+ * @brief Get the name of a kind of object, for reports
+ *
+ * @param type Kind of object
+ * @return const char*
+ */
+const char* ResourceTracker::getName( const GpuResource type ) {
+    switch ( type ) {
+    case GR_Buffer:
+        return "buffers";
+    case GR_VertexArray:
+        return "vertex arrays";
+    case GR_Shader:
+        return "shaders";
+    case GR_Program:
+        return "programs";
+    case GR_Query:
+        return "queries";
+    case GR_Framebuffer:
+        return "framebuffers";
+    case GR_Renderbuffer:
+        return "renderbuffers";
+    default:
+        return "unknown";
+    }
+}
+
+/**
+ * @brief Traces every kind of object still alive. Called once everything that
+ * owns OpenGL objects has been shut down.
+ *
+ * @return true Nothing leaked
+ * @return false Some objects are still alive
+ */
+bool ResourceTracker::report() {
+    bool isClean = true;
+
+    for ( unsigned i = 0; i < GR_Count; ++i ) {
+        const GpuResource type = static_cast< GpuResource >( i );
+        const int live = getLiveCount( type );
+        if ( live == 0 ) {
+            continue;
+        }
+
+        // Negative counts mean something was deleted twice
+        Trace::message( fmt::format( "Leaked {} {} of {} created.", live,
+                                     getName( type ),
+                                     getCreatedCount( type ) ) );
+        isClean = false;
+    }
+
+    if ( isClean ) {
+        Trace::message( "All OpenGL objects were released." );
+    }
+
+    return isClean;
+}
+
+} // namespace SquirrelEngine
@@ -8,6 +8,7 @@
  *
  */
 
+#include <algorithm>
 #include <thread>
 
 #include "utils/time_manager.hpp"
@@ -16,38 +17,83 @@ namespace SquirrelEngine {
 
 using namespace std::chrono;
 
+/**
+ * @brief Converts seconds to ticks, rounded to the nearest nanosecond
+ *
+ * @param seconds
+ * @return nanoseconds
+ */
+static nanoseconds toTicks( const float seconds ) {
+    return round< nanoseconds >( duration< double >( seconds ) );
+}
+
+/**
+ * @brief Converts ticks to seconds. Only used for per frame values, which are
+ * small enough to be exact in a float
+ *
+ * @param ticks
+ * @return float
+ */
+static float toSeconds( const nanoseconds ticks ) {
+    return duration_cast< duration< float > >( ticks ).count();
+}
+
 /**
  * @brief Construct a new Time Manager object
  *
  */
-TimeManager::TimeManager()
-    : m_lastTime( steady_clock::now() ), m_accumulator( 0.f ), m_time( 0.f ),
-      m_deltaTime( 0.f ) {}
+TimeManager::TimeManager() : m_lastTime( steady_clock::now() ) {}
 
+/**
+ * @brief Update time values
+ *
+ */
 void TimeManager::increment() {
     m_currTime = steady_clock::now();
-    m_timeTaken = m_currTime - m_lastTime;
-    m_deltaTime = static_cast< float >( m_timeTaken.count() ) *
-                  steady_clock::period::num / steady_clock::period::den;
+    m_frameTime = duration_cast< nanoseconds >( m_currTime - m_lastTime );
     m_lastTime = m_currTime;
-    m_accumulator += m_deltaTime;
+
+    // Measured before any locked step so the stats show real pacing
+    m_frameTimes[m_frameTimeNext] =
+        duration_cast< duration< float, std::milli > >( m_frameTime ).count();
+    m_frameTimeNext = ( m_frameTimeNext + 1 ) % FrameHistorySize;
+    m_frameTimeCount = std::min( m_frameTimeCount + 1, FrameHistorySize );
+
+    if ( m_lockedFrameTime > nanoseconds::zero() ) {
+        m_frameTime = m_lockedFrameTime;
+    }
+
+    m_deltaTime = toSeconds( m_frameTime );
+    m_accumulator += m_frameTime;
+    m_fixedSteps = 0;
 }
 
 /**
- * @brief Check if fixed time interval has been passed
+ * @brief Check if fixed time interval has been passed. Stops after the max
+ * fixed steps of a frame and drops the rest of the backlog.
  *
  * @return true
  * @return false
  */
 bool TimeManager::needsFixedUpdate() {
-    const bool result = m_accumulator >= m_fixedDt;
+    if ( m_accumulator < m_fixedStep ) {
+        return false;
+    }
 
-    if ( result ) {
-        m_accumulator -= m_fixedDt;
-        m_time += m_fixedDt;
+    // Drop whole steps but keep the partial one so alpha stays smooth
+    if ( m_fixedSteps >= m_maxFixedSteps ) {
+        const int64_t dropped = m_accumulator / m_fixedStep;
+        m_accumulator %= m_fixedStep;
+        m_droppedFixedSteps += static_cast< uint64_t >( dropped );
+        return false;
     }
 
-    return result;
+    m_accumulator -= m_fixedStep;
+    m_time += m_fixedStep;
+    ++m_fixedSteps;
+    ++m_fixedStepCount;
+
+    return true;
 }
 
 /**
@@ -63,6 +109,76 @@ void TimeManager::resetLastTime() { m_lastTime = steady_clock::now(); }
  */
 const float TimeManager::getFixedDt() const { return m_fixedDt; }
 
+/**
+ * @brief Set the fixed delta time interval
+ *
+ * @param fixedDt Interval in seconds, must be above 0. Rounded to the nearest
+ * nanosecond.
+ */
+void TimeManager::setFixedDt( const float fixedDt ) {
+    const nanoseconds fixedStep = toTicks( fixedDt );
+    if ( fixedStep > nanoseconds::zero() ) {
+        m_fixedStep = fixedStep;
+        m_fixedDt = toSeconds( fixedStep );
+    }
+}
+
+/**
+ * @brief Set how many fixed steps may run in one frame before the remaining
+ * time is dropped, so one long frame can't make every following frame longer
+ *
+ * @param maxSteps Fixed steps per frame, at least 1
+ */
+void TimeManager::setMaxFixedSteps( const int maxSteps ) {
+    m_maxFixedSteps = std::max( maxSteps, 1 );
+}
+
+/**
+ * @brief Return how far the simulation is into the next fixed step, used to
+ * interpolate between the previous and current fixed step
+ *
+ * @return const float 0 to 1
+ */
+const float TimeManager::getAlpha() const {
+    const double alpha = static_cast< double >( m_accumulator.count() ) /
+                         static_cast< double >( m_fixedStep.count() );
+    return static_cast< float >( std::clamp( alpha, 0.0, 1.0 ) );
+}
+
+/**
+ * @brief Return the number of fixed steps dropped by the max fixed steps clamp
+ *
+ * @return const uint64_t
+ */
+const uint64_t TimeManager::getDroppedFixedSteps() const {
+    return m_droppedFixedSteps;
+}
+
+/**
+ * @brief Return the total simulated fixed time
+ *
+ * @return const double Seconds, under a microsecond off for decades
+ */
+const double TimeManager::getTime() const {
+    return duration_cast< duration< double > >( m_time ).count();
+}
+
+/**
+ * @brief Return the total simulated fixed time in integer ticks
+ *
+ * @return const std::chrono::nanoseconds
+ */
+const nanoseconds TimeManager::getTimeTicks() const { return m_time; }
+
+/**
+ * @brief Return the number of fixed steps run since construction
+ *
+ * @return const uint64_t
+ */
+const uint64_t TimeManager::getFixedStepCount() const {
+    return m_fixedStepCount;
+}
+
 /**
  * @brief Return last non-fixed delta time
  *
@@ -70,6 +186,16 @@ const float TimeManager::getFixedDt() const { return m_fixedDt; }
  */
 const float TimeManager::getDeltaTime() const { return m_deltaTime; }
 
+/**
+ * @brief Steps by a constant frame time instead of the clock, so runs advance
+ * the same on every machine
+ *
+ * @param deltaTime Frame time in seconds, 0 to use the clock again
+ */
+void TimeManager::setLockedDeltaTime( const float deltaTime ) {
+    m_lockedFrameTime = std::max( toTicks( deltaTime ), nanoseconds::zero() );
+}
+
 /**
  * @brief Sleeps main thread for given time in milliseconds
  *
@@ -79,4 +205,99 @@ void TimeManager::sleep( const int milliseconds ) {
     std::this_thread::sleep_for( std::chrono::milliseconds( milliseconds ) );
 }
 
+/**
+ * @brief Set the frame rate limitFrame paces to
+ *
+ * @param framesPerSecond Target rate, 0 for uncapped
+ */
+void TimeManager::setTargetFrameRate( const float framesPerSecond ) {
+    if ( framesPerSecond <= 0.f ) {
+        m_targetFrameTime = steady_clock::duration::zero();
+        return;
+    }
+
+    m_targetFrameTime = duration_cast< steady_clock::duration >(
+        duration< double >( 1.0 / framesPerSecond ) );
+}
+
+/**
+ * @brief Return the frame rate limitFrame paces to
+ *
+ * @return const float Target rate, 0 when uncapped
+ */
+const float TimeManager::getTargetFrameRate() const {
+    if ( m_targetFrameTime == steady_clock::duration::zero() ) {
+        return 0.f;
+    }
+
+    return static_cast< float >(
+        1.0 / duration_cast< duration< double > >( m_targetFrameTime ).count() );
+}
+
+/**
+ * @brief Set how long before the frame deadline limitFrame stops sleeping and
+ * spins instead. Covers the scheduler oversleeping.
+ *
+ * @param spinTime Time to spin for at the end of each frame
+ */
+void TimeManager::setSpinTime( const steady_clock::duration spinTime ) {
+    m_spinTime = spinTime;
+}
+
+/**
+ * @brief Waits until the target frame time has passed since the last
+ * increment. Sleeps for the coarse part and spins for the rest. Returns
+ * immediately when uncapped or the frame is already late.
+ *
+ */
+void TimeManager::limitFrame() {
+    if ( m_targetFrameTime == steady_clock::duration::zero() ) {
+        return;
+    }
+
+    const steady_clock::time_point deadline = m_currTime + m_targetFrameTime;
+
+    // sleep_for can overshoot by a millisecond or more, so stop short
+    const steady_clock::time_point sleepUntil = deadline - m_spinTime;
+    if ( steady_clock::now() < sleepUntil ) {
+        std::this_thread::sleep_until( sleepUntil );
+    }
+
+    while ( steady_clock::now() < deadline ) {
+        std::this_thread::yield();
+    }
+}
+
+/**
+ * @brief Return percentiles of the measured frame times
+ *
+ * @return FrameTimeStats over the last FrameHistorySize frames
+ */
+TimeManager::FrameTimeStats TimeManager::getFrameTimeStats() const {
+    FrameTimeStats stats;
+    stats.sampleCount = m_frameTimeCount;
+    if ( m_frameTimeCount == 0 ) {
+        return stats;
+    }
+
+    std::array< float, FrameHistorySize > sorted = m_frameTimes;
+    float* const first = sorted.data();
+    float* const last = first + m_frameTimeCount;
+
+    // Nearest rank, so p99 of a short history is its worst frame
+    const auto percentile = [&]( const float p ) {
+        const int rank = std::clamp(
+            static_cast< int >( p * static_cast< float >( m_frameTimeCount ) ),
+            0, m_frameTimeCount - 1 );
+        std::nth_element( first, first + rank, last );
+        return first[rank];
+    };
+
+    stats.p50 = percentile( 0.5f );
+    stats.p99 = percentile( 0.99f );
+    stats.max = *std::max_element( first, last );
+
+    return stats;
+}
+
 } // namespace SquirrelEngine
@@ -40,6 +40,9 @@ Trace::Trace() {
  */
 void Trace::message( std::string Message, std::source_location Src ) {
     Trace& TraceInstance = Trace::getInstance();
+
+    // Loader and render threads log too, and the streams aren't thread safe
+    std::lock_guard< std::mutex > lock( TraceInstance.TraceMutex );
     if ( !TraceInstance.TraceStream ) return;
 
     std::string Filename = std::string( Src.file_name() );
@@ -55,6 +58,14 @@ void Trace::message( std::string Message, std::source_location Src ) {
     std::cout << output << "\n";
 }
 
+/**
+ * @brief Opens the output file if it isn't open yet. Statics destroyed after
+ * the trace can't log, so singletons that log on exit call this while they are
+ * constructed
+ *
+ */
+void Trace::open() { getInstance(); }
+
 /**
  * @brief Close output file
  *
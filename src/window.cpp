@@ -11,6 +11,8 @@
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
+#include <cstdlib>
+
 #include "window.hpp"
 #include "utils/trace.hpp"
 #include "error_codes.hpp"
@@ -22,16 +24,37 @@ namespace SquirrelEngine {
  */
 Window::Window() : m_window( nullptr ) {}
 
+/**
+ * @brief Virtual destructor for Window. Destroys the window if it is still
+ * open.
+ */
+Window::~Window() { destroy(); }
+
 /**
  * @brief Creates the window with the specified parameters.
  * @param title The window title.
  * @param width The window width.
  * @param height The window height.
  * @param isFullscreen Whether the window should be fullscreen.
+ * @param isHeadless Whether to create a hidden window only used for its OpenGL
+ * context.
  * @return StartupErrors indicating success or failure.
  */
 StartupErrors Window::create( const std::string title, const int width,
-                              const int height, bool isFullscreen ) {
+                              const int height, bool isFullscreen,
+                              bool isHeadless ) {
+    bool useOSMesa = false;
+
+#if defined( GLFW_PLATFORM_NULL ) && !defined( _WIN32 )
+    // Without a display server use the null platform with an OSMesa
+    // (llvmpipe) context
+    if ( isHeadless && !std::getenv( "DISPLAY" ) &&
+         !std::getenv( "WAYLAND_DISPLAY" ) ) {
+        glfwInitHint( GLFW_PLATFORM, GLFW_PLATFORM_NULL );
+        useOSMesa = true;
+    }
+#endif
+
     if ( !glfwInit() ) {
         Trace::message( "Could not start GLFW." );
         return StartupErrors::SE_GLFWFailedInit;
@@ -45,6 +68,16 @@ StartupErrors Window::create( const std::string title, const int width,
 
     glfwWindowHint( GLFW_SAMPLES, 4 );
 
+    if ( isHeadless ) {
+        glfwWindowHint( GLFW_VISIBLE, GLFW_FALSE );
+        isFullscreen = false;
+
+        if ( useOSMesa ) {
+            glfwWindowHint( GLFW_CONTEXT_CREATION_API,
+                            GLFW_OSMESA_CONTEXT_API );
+        }
+    }
+
     if ( isFullscreen ) {
         // Get our primary monitor
         GLFWmonitor* primaryMonitor = glfwGetPrimaryMonitor();
@@ -69,7 +102,12 @@ StartupErrors Window::create( const std::string title, const int width,
 
     // Let the Window be the current OpenGL context and initialise glad
     glfwMakeContextCurrent( m_window );
-    gladLoadGL();
+    gladLoadGLLoader( reinterpret_cast< GLADloadproc >( glfwGetProcAddress ) );
+
+    // Headless runs are uncapped, so never wait for vsync
+    if ( isHeadless ) {
+        glfwSwapInterval( 0 );
+    }
 
     // Enable depth (Z) buffer (accept "closest" fragment)
     glEnable( GL_DEPTH_TEST );
@@ -89,11 +127,28 @@ StartupErrors Window::create( const std::string title, const int width,
     glClearColor( 0.6f, 0.6f, 0.6f, 1.0f );
     glClearStencil( 0 );
 
+    glfwSetWindowUserPointer( m_window, &m_input );
     glfwSetWindowCloseCallback( m_window, Window::closeWindowCallback );
 
     return StartupErrors::SE_Success;
 }
 
+/**
+ * @brief Destroys the window and its OpenGL context and terminates GLFW. Every
+ * GL object must be deleted before this.
+ */
+void Window::destroy() {
+    if ( !m_window ) {
+        return;
+    }
+
+    glfwDestroyWindow( m_window );
+    glfwTerminate();
+
+    m_window = nullptr;
+    m_input = WindowInput();
+}
+
 /**
  * @brief Polls window events (input, close, etc.).
  */
@@ -134,6 +189,21 @@ void Window::frameBufferSize( int& width, int& height ) {
  */
 GLFWwindow* Window::getHandle() { return m_window; }
 
+/**
+ * @brief Gets the input devices the window's callbacks report to.
+ * @return Reference to the window's WindowInput.
+ */
+WindowInput& Window::getInput() { return m_input; }
+
+/**
+ * @brief Gets the input devices of a GLFW window from its user pointer.
+ * @param t_window Pointer to the GLFWwindow.
+ * @return Pointer to the WindowInput, nullptr if the window has none.
+ */
+WindowInput* Window::getInput( GLFWwindow* t_window ) {
+    return static_cast< WindowInput* >( glfwGetWindowUserPointer( t_window ) );
+}
+
 /**
  * @brief GLFW callback for window close event.
  * @param t_window Pointer to the GLFWwindow.
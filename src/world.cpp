@@ -2,21 +2,24 @@
  *
  * @file world.cpp
  * @author Kelson Wysocki (kelson.wysocki@gmail.com)
- * @brief Implements the World class, which manages all entities and their
+ * @brief Implements the World class, which manages a set of entities and their
  * lifecycle in SquirrelEngine.
  * @date 2025-06-06
  *
  */
 
+#include <algorithm>
+
 #include "world.hpp"
 #include "entity.hpp"
 
 namespace SquirrelEngine {
 
 /**
- * @brief Default constructor for World (private for singleton pattern).
+ * @brief Constructor for World.
+ * @param t_name Name of the world, used in reports.
  */
-World::World() {}
+World::World( const std::string& t_name ) : m_name( t_name ) {}
 
 /**
  * @brief Destructor for World.
@@ -29,31 +32,230 @@ World::~World() {}
  * @param id Optional unique ID for the entity.
  * @return Pointer to the created Entity.
  */
-Entity* World::createEntity( const std::string name, const uint32_t id ) {
+Entity* World::createEntity( const std::string& name, const uint32_t id ) {
     m_entitesList.push_back( std::make_unique< Entity >( id, name ) );
 
     Entity* newEntity = m_entitesList.back().get();
-    m_entitesMap.insert( { name, newEntity } );
+
+    // Reuse freed slots so the table stays as small as the world
+    uint32_t slot;
+    if ( m_freeSlots.empty() ) {
+        slot = static_cast< uint32_t >( m_slots.size() );
+        m_slots.emplace_back();
+    } else {
+        slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    }
+    m_slots[slot].entity = newEntity;
+
+    newEntity->world = this;
+    newEntity->slot = slot;
+
+    indexName( slot );
 
     return newEntity;
 }
 
+/**
+ * @brief Reserves room for entities about to be created, so a bulk load
+ * doesn't regrow the lists as it goes.
+ * @param count Number of entities the world will hold.
+ */
+void World::reserve( const size_t count ) {
+    m_entitesList.reserve( count );
+    m_slots.reserve( count );
+}
+
 /**
  * @brief Finds an entity by its unique ID.
  * @param id The entity's unique ID.
  * @return Pointer to the found Entity, or nullptr if not found.
  */
 Entity* World::findEntity( const uint32_t id ) {
-    return m_entitesList.at( id ).get();
+    return ( id < m_entitesList.size() ) ? m_entitesList[id].get() : nullptr;
 }
 
 /**
  * @brief Finds an entity by its name.
  * @param name The entity's name.
- * @return Pointer to the found Entity, or nullptr if not found.
+ * @return Pointer to an Entity with the name, or nullptr if none has it.
+ */
+Entity* World::findEntity( std::string_view name ) {
+    const std::span< Entity* const > named = findEntities( name );
+    return named.empty() ? nullptr : named.front();
+}
+
+/**
+ * @brief Finds every entity with a name.
+ * @param name The entities' name.
+ * @return The entities in no particular order, empty if none has the name.
+ */
+std::span< Entity* const > World::findEntities( std::string_view name ) const {
+    return findEntities( getNameId( name ) );
+}
+
+/**
+ * @brief Finds every entity with an interned name, without hashing it.
+ * @param name Id from getNameId.
+ * @return The entities, empty if none has the name.
+ */
+std::span< Entity* const > World::findEntities( const NameId name ) const {
+    if ( name >= m_named.size() ) {
+        return {};
+    }
+
+    return m_named[name];
+}
+
+/**
+ * @brief Gets the interned id of a name. Ids stay the same for the life of
+ * the world, even once no entity has the name.
+ * @param name Name to look up.
+ * @return Id of the name, or NoName if no entity has had it.
+ */
+NameId World::getNameId( std::string_view name ) const {
+    auto found = m_nameIds.find( name );
+    return ( found != m_nameIds.end() ) ? found->second : NoName;
+}
+
+/**
+ * @brief Renames an entity and moves it in the name index. Entities should be
+ * renamed through here rather than through their name.
+ * @param entity Entity in this world.
+ * @param name New name.
+ */
+void World::renameEntity( Entity* entity, const std::string& name ) {
+    if ( !findSlot( entity ) ) {
+        return;
+    }
+
+    unindexName( entity->slot );
+    entity->name = name;
+    indexName( entity->slot );
+}
+
+/**
+ * @brief Gives an entity a tag.
+ * @param entity Entity in this world.
+ * @param tag Tag to add.
+ */
+void World::addTag( const Entity* entity, const unsigned tag ) {
+    EntitySlot* slot = findSlot( entity );
+    if ( !slot || tag >= MaxEntityTags || slot->tags.test( tag ) ) {
+        return;
+    }
+
+    slot->tags.set( tag );
+    insert( m_tagged[tag], entity->slot );
+}
+
+/**
+ * @brief Takes a tag from an entity.
+ * @param entity Entity in this world.
+ * @param tag Tag to remove.
+ */
+void World::removeTag( const Entity* entity, const unsigned tag ) {
+    EntitySlot* slot = findSlot( entity );
+    if ( !slot || tag >= MaxEntityTags || !slot->tags.test( tag ) ) {
+        return;
+    }
+
+    slot->tags.reset( tag );
+    erase( m_tagged[tag], entity->slot );
+}
+
+/**
+ * @brief Checks if an entity has a tag.
+ * @param entity Entity in this world.
+ * @param tag Tag to check.
+ * @return true if the entity has the tag.
+ */
+bool World::hasTag( const Entity* entity, const unsigned tag ) const {
+    const EntitySlot* slot = findSlot( entity );
+    return slot && tag < MaxEntityTags && slot->tags.test( tag );
+}
+
+/**
+ * @brief Gives an entity exactly the tags set in a mask.
+ * @param entity Entity in this world.
+ * @param tags Tags the entity should have.
+ */
+void World::setTags( const Entity* entity, const EntityTags tags ) {
+    const EntitySlot* slot = findSlot( entity );
+    if ( !slot ) {
+        return;
+    }
+
+    const EntityTags changed = slot->tags ^ tags;
+    for ( unsigned tag = 0; tag < MaxEntityTags; ++tag ) {
+        if ( !changed.test( tag ) ) {
+            continue;
+        }
+
+        if ( tags.test( tag ) ) {
+            addTag( entity, tag );
+        } else {
+            removeTag( entity, tag );
+        }
+    }
+}
+
+/**
+ * @brief Gets every tag of an entity.
+ * @param entity Entity in this world.
+ * @return Tags of the entity, none if it isn't in this world.
  */
-Entity* World::findEntity( const std::string name ) {
-    return m_entitesMap.at( name );
+EntityTags World::getTags( const Entity* entity ) const {
+    const EntitySlot* slot = findSlot( entity );
+    return slot ? slot->tags : EntityTags();
+}
+
+/**
+ * @brief Gets every entity with a tag.
+ * @param tag Tag to query.
+ * @return The entities, in no particular order.
+ */
+std::span< Entity* const > World::getTagged( const unsigned tag ) const {
+    if ( tag >= MaxEntityTags ) {
+        return {};
+    }
+
+    return m_tagged[tag].entities;
+}
+
+/**
+ * @brief Finds the entity a handle refers to.
+ * @param handle Handle from getHandle.
+ * @return Pointer to the Entity, or nullptr if it was removed or the handle
+ * belongs to another world.
+ */
+Entity* World::findEntity( const EntityHandle& handle ) {
+    if ( handle.world.index != m_handle.index ||
+         handle.world.generation != m_handle.generation ||
+         handle.index >= m_slots.size() ) {
+        return nullptr;
+    }
+
+    const EntitySlot& slot = m_slots[handle.index];
+    return ( slot.generation == handle.generation ) ? slot.entity : nullptr;
+}
+
+/**
+ * @brief Gets a handle that stays safe to resolve after the entity goes.
+ * @param entity Entity in this world.
+ * @return Handle to the entity, invalid if it isn't in this world.
+ */
+EntityHandle World::getHandle( const Entity* entity ) const {
+    EntityHandle handle;
+    if ( !entity || entity->world != this ) {
+        return handle;
+    }
+
+    handle.world = m_handle;
+    handle.index = entity->slot;
+    handle.generation = m_slots[entity->slot].generation;
+
+    return handle;
 }
 
 /**
@@ -61,8 +263,43 @@ Entity* World::findEntity( const std::string name ) {
  * @param entity Pointer to the entity to remove.
  */
 void World::removeEntity( const Entity* entity ) {
-    m_entitesMap.erase( entity->name );
-    m_entitesList.erase( m_entitesList.begin() + entity->id );
+    if ( !entity || entity->world != this ) {
+        return;
+    }
+
+    releaseSlot( entity->slot );
+
+    auto it = std::find_if( m_entitesList.begin(), m_entitesList.end(),
+                            [entity]( const std::unique_ptr< Entity >& owned ) {
+                                return owned.get() == entity;
+                            } );
+    if ( it != m_entitesList.end() ) {
+        m_entitesList.erase( it );
+    }
+}
+
+/**
+ * @brief Removes every entity from the world. Models release their GL objects,
+ * so call while the context is still current.
+ */
+void World::clear() { releaseEntities(); }
+
+/**
+ * @brief Empties the world and hands its entities to the caller, who decides
+ * when they are destroyed. Handles to them stop resolving.
+ * @return The entities that were in the world.
+ */
+std::vector< std::unique_ptr< Entity > > World::releaseEntities() {
+    for ( auto& entity : m_entitesList ) {
+        releaseSlot( entity->slot );
+        entity->world = nullptr;
+    }
+
+    std::vector< std::unique_ptr< Entity > > released =
+        std::move( m_entitesList );
+    m_entitesList.clear();
+
+    return released;
 }
 
 /**
@@ -74,12 +311,166 @@ std::vector< std::unique_ptr< Entity > >& World::getEntityList() {
 }
 
 /**
- * @brief Gets the singleton instance of the World.
- * @return Pointer to the World instance.
+ * @brief Stores every entity's transform as its previous snapshot. Called
+ * before each fixed step.
+ */
+void World::storePreviousTransforms() {
+    for ( auto& entity : m_entitesList ) {
+        entity->transform.storePrevious();
+    }
+}
+
+/**
+ * @brief Gets the name of the world.
+ * @return Name given on construction.
+ */
+const std::string& World::getName() const { return m_name; }
+
+/**
+ * @brief Gets the handle the WorldManager knows this world by.
+ * @return Handle of the world, invalid if it isn't managed.
  */
-World* World::instance() {
-    static World m_instance;
-    return &m_instance;
+WorldHandle World::getHandle() const { return m_handle; }
+
+/**
+ * @brief Sets whether the world's entities are simulated.
+ * @param active Whether to simulate the world.
+ */
+void World::setActive( const bool active ) { m_isActive = active; }
+
+/**
+ * @brief Checks if the world's entities are simulated.
+ * @return true if the world is active.
+ */
+bool World::isActive() const { return m_isActive; }
+
+/**
+ * @brief Sets whether the world's entities are rendered.
+ * @param visible Whether to render the world.
+ */
+void World::setVisible( const bool visible ) { m_isVisible = visible; }
+
+/**
+ * @brief Checks if the world's entities are rendered.
+ * @return true if the world is visible.
+ */
+bool World::isVisible() const { return m_isVisible; }
+
+/**
+ * @brief Empties a slot and makes its handles stale.
+ * @param index Slot to free.
+ */
+void World::releaseSlot( const uint32_t index ) {
+    unindexName( index );
+
+    EntitySlot& slot = m_slots[index];
+    for ( unsigned tag = 0; tag < MaxEntityTags && slot.tags.any(); ++tag ) {
+        if ( slot.tags.test( tag ) ) {
+            slot.tags.reset( tag );
+            erase( m_tagged[tag], index );
+        }
+    }
+
+    slot.entity = nullptr;
+    ++slot.generation;
+
+    m_freeSlots.push_back( index );
+}
+
+/**
+ * @brief Gets the slot of an entity in this world.
+ * @param entity Entity to look up.
+ * @return Pointer to the slot, or nullptr if the entity isn't here.
+ */
+World::EntitySlot* World::findSlot( const Entity* entity ) {
+    if ( !entity || entity->world != this ) {
+        return nullptr;
+    }
+
+    return &m_slots[entity->slot];
+}
+
+/**
+ * @brief Gets the slot of an entity in this world.
+ * @param entity Entity to look up.
+ * @return Pointer to the slot, or nullptr if the entity isn't here.
+ */
+const World::EntitySlot* World::findSlot( const Entity* entity ) const {
+    if ( !entity || entity->world != this ) {
+        return nullptr;
+    }
+
+    return &m_slots[entity->slot];
+}
+
+/**
+ * @brief Adds an entity to the list of its name, interning the name.
+ * @param index Slot of the entity.
+ */
+void World::indexName( const uint32_t index ) {
+    EntitySlot& slot = m_slots[index];
+    if ( slot.entity->name.empty() ) {
+        return;
+    }
+
+    auto [it, inserted] = m_nameIds.try_emplace(
+        slot.entity->name, static_cast< NameId >( m_named.size() ) );
+    if ( inserted ) {
+        m_named.emplace_back();
+    }
+
+    std::vector< Entity* >& named = m_named[it->second];
+    slot.name = it->second;
+    slot.namePosition = static_cast< uint32_t >( named.size() );
+    named.push_back( slot.entity );
+}
+
+/**
+ * @brief Takes an entity out of the list of its name.
+ * @param index Slot of the entity.
+ */
+void World::unindexName( const uint32_t index ) {
+    EntitySlot& slot = m_slots[index];
+    if ( slot.name == NoName ) {
+        return;
+    }
+
+    // Swap the last entity of the name into the gap
+    std::vector< Entity* >& named = m_named[slot.name];
+    Entity* last = named.back();
+    named[slot.namePosition] = last;
+    m_slots[last->slot].namePosition = slot.namePosition;
+    named.pop_back();
+
+    slot.name = NoName;
+}
+
+/**
+ * @brief Adds an entity to a set.
+ * @param set Set to add to.
+ * @param index Slot of the entity.
+ */
+void World::insert( EntitySet& set, const uint32_t index ) {
+    if ( set.positions.size() < m_slots.size() ) {
+        set.positions.resize( m_slots.size() );
+    }
+
+    set.positions[index] = static_cast< uint32_t >( set.entities.size() );
+    set.entities.push_back( m_slots[index].entity );
+}
+
+/**
+ * @brief Takes an entity out of a set by swapping the last member in.
+ * @param set Set to remove from.
+ * @param index Slot of the entity.
+ */
+void World::erase( EntitySet& set, const uint32_t index ) {
+    const uint32_t position = set.positions[index];
+
+    Entity* last = set.entities.back();
+    set.entities[position] = last;
+    set.positions[last->slot] = position;
+    set.entities.pop_back();
 }
 
 } // namespace SquirrelEngine
@@ -0,0 +1,312 @@
+/**
+ *
+ * @file worldManager.cpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief Implements the WorldManager class, which owns every World and streams
+ * them in and out around the camera in SquirrelEngine.
+ * @date 2025-06-06
+ *
+ */
+
+#include <algorithm>
+
+#include <fmt/core.h>
+
+#include "engine.hpp"
+#include "entity.hpp"
+#include "worldManager.hpp"
+#include "utils/trace.hpp"
+
+namespace SquirrelEngine {
+
+/**
+ * @brief Default constructor for WorldManager.
+ */
+WorldManager::WorldManager() {}
+
+/**
+ * @brief Destructor for WorldManager.
+ */
+WorldManager::~WorldManager() {}
+
+/**
+ * @brief Creates the persistent world.
+ * @param t_owner Pointer to the Engine that owns this system.
+ * @return StartupErrors indicating success or failure.
+ */
+StartupErrors WorldManager::initialize( Engine* t_owner ) {
+    System::initialize( t_owner );
+
+    m_persistent = createWorld( "Persistent" );
+
+    // Loading and unloading make and delete meshes, which needs the context
+    m_canStream = !owner->getSettings().renderThread;
+
+    return StartupErrors::SE_Success;
+}
+
+/**
+ * @brief Streams worlds in and out around the camera.
+ * @param delta Time elapsed since last update.
+ */
+void WorldManager::update( const float ) {
+    Entity* camera = getCamera();
+    if ( !camera || !m_canStream ) {
+        return;
+    }
+
+    const vector3 cameraPosition = camera->transform.getPosition();
+    for ( StreamedWorld& streamed : m_streamed ) {
+        const float distance = glm::length( cameraPosition - streamed.center );
+
+        if ( !streamed.isLoaded && distance <= streamed.loadRadius ) {
+            load( streamed );
+        } else if ( streamed.isLoaded && distance > streamed.unloadRadius ) {
+            unload( streamed );
+        }
+    }
+}
+
+/**
+ * @brief Destroys every world and their entities.
+ */
+void WorldManager::shutdown() {
+    m_streamed.clear();
+    m_slots.clear();
+    m_freeSlots.clear();
+    m_worlds.clear();
+
+    m_persistent = WorldHandle();
+    m_camera = EntityHandle();
+}
+
+/**
+ * @brief Creates an empty world that stays loaded until destroyed.
+ * @param name Name of the world, used in reports.
+ * @return Handle to the world.
+ */
+WorldHandle WorldManager::createWorld( const std::string& name ) {
+    WorldHandle handle;
+    if ( m_freeSlots.empty() ) {
+        handle.index = static_cast< uint32_t >( m_slots.size() );
+        m_slots.emplace_back();
+    } else {
+        handle.index = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    }
+
+    WorldSlot& slot = m_slots[handle.index];
+    handle.generation = slot.generation;
+
+    slot.world = std::make_unique< World >( name );
+    slot.world->m_handle = handle;
+
+    updateWorldList();
+
+    return handle;
+}
+
+/**
+ * @brief Creates a world that loads and unloads by camera distance.
+ * @param name Name of the world, used in reports.
+ * @param center Point distances are measured from.
+ * @param loadRadius Camera distance the world loads within.
+ * @param unloadRadius Camera distance the world unloads beyond, at least the
+ * load radius so a camera on the edge doesn't reload it every frame.
+ * @param loader Fills the world each time it loads.
+ * @return Handle to the world, which starts unloaded.
+ */
+WorldHandle WorldManager::createStreamedWorld( const std::string& name,
+                                               const vector3& center,
+                                               const float loadRadius,
+                                               const float unloadRadius,
+                                               WorldLoader loader ) {
+    const WorldHandle handle = createWorld( name );
+
+    World* world = getWorld( handle );
+    world->setActive( false );
+    world->setVisible( false );
+
+    StreamedWorld streamed;
+    streamed.handle = handle;
+    streamed.center = center;
+    streamed.loadRadius = loadRadius;
+    streamed.unloadRadius = std::max( unloadRadius, loadRadius );
+    streamed.loader = std::move( loader );
+    m_streamed.push_back( std::move( streamed ) );
+
+    return handle;
+}
+
+/**
+ * @brief Destroys a world and its entities. The persistent world can't be
+ * destroyed, and no world can be while rendering on another thread.
+ * @param handle Handle to the world.
+ */
+void WorldManager::destroyWorld( const WorldHandle handle ) {
+    World* world = getWorld( handle );
+    if ( !world || handle.index == m_persistent.index ) {
+        return;
+    }
+
+    // Deleting the models needs the context, which the render thread owns
+    if ( !m_canStream ) {
+        Trace::message( fmt::format(
+            "Can't destroy world {} while rendering on another thread.",
+            world->getName() ) );
+        return;
+    }
+
+    m_streamed.erase(
+        std::remove_if( m_streamed.begin(), m_streamed.end(),
+                        [handle]( const StreamedWorld& streamed ) {
+                            return streamed.handle.index == handle.index;
+                        } ),
+        m_streamed.end() );
+
+    WorldSlot& slot = m_slots[handle.index];
+    slot.world.reset();
+    ++slot.generation;
+    m_freeSlots.push_back( handle.index );
+
+    updateWorldList();
+}
+
+/**
+ * @brief Finds the world a handle refers to.
+ * @param handle Handle from createWorld or createStreamedWorld.
+ * @return Pointer to the World, or nullptr if it was destroyed.
+ */
+World* WorldManager::getWorld( const WorldHandle handle ) {
+    if ( handle.index >= m_slots.size() ) {
+        return nullptr;
+    }
+
+    WorldSlot& slot = m_slots[handle.index];
+    return ( slot.generation == handle.generation ) ? slot.world.get()
+                                                    : nullptr;
+}
+
+/**
+ * @brief Gets the world that is never unloaded.
+ * @return Pointer to the persistent World.
+ */
+World* WorldManager::getPersistentWorld() { return getWorld( m_persistent ); }
+
+/**
+ * @brief Gets every world, loaded or not.
+ * @return Pointers to the worlds.
+ */
+const std::vector< World* >& WorldManager::getWorlds() const {
+    return m_worlds;
+}
+
+/**
+ * @brief Finds the entity a handle refers to in any world.
+ * @param handle Handle from World::getHandle.
+ * @return Pointer to the Entity, or nullptr if it or its world is gone.
+ */
+Entity* WorldManager::resolve( const EntityHandle& handle ) {
+    World* world = getWorld( handle.world );
+    return world ? world->findEntity( handle ) : nullptr;
+}
+
+/**
+ * @brief Checks if a streamed world is loaded. Other worlds always are.
+ * @param handle Handle to the world.
+ * @return true if the world exists and is loaded.
+ */
+bool WorldManager::isLoaded( const WorldHandle handle ) const {
+    if ( handle.index >= m_slots.size() ||
+         m_slots[handle.index].generation != handle.generation ||
+         !m_slots[handle.index].world ) {
+        return false;
+    }
+
+    for ( const StreamedWorld& streamed : m_streamed ) {
+        if ( streamed.handle.index == handle.index ) {
+            return streamed.isLoaded;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Stores the previous transforms of every active world. Called before
+ * each fixed step.
+ */
+void WorldManager::storePreviousTransforms() {
+    for ( World* world : m_worlds ) {
+        if ( world->isActive() ) {
+            world->storePreviousTransforms();
+        }
+    }
+}
+
+/**
+ * @brief Sets the camera that is rendered from and streams worlds.
+ * @param camera Handle to an entity with a CameraComponent.
+ */
+void WorldManager::setCamera( const EntityHandle& camera ) {
+    m_camera = camera;
+}
+
+/**
+ * @brief Gets the camera that is rendered from and streams worlds.
+ * @return Pointer to the camera entity, or nullptr if it is gone.
+ */
+Entity* WorldManager::getCamera() { return resolve( m_camera ); }
+
+/**
+ * @brief Runs the loader of a streamed world and shows it.
+ * @param streamed World to load.
+ */
+void WorldManager::load( StreamedWorld& streamed ) {
+    World* world = getWorld( streamed.handle );
+    if ( streamed.loader ) {
+        streamed.loader( *world );
+    }
+
+    // Loaded mid-run, so don't interpolate in from the origin
+    for ( auto& entity : world->getEntityList() ) {
+        entity->transform.resetInterpolation();
+    }
+
+    world->setActive( true );
+    world->setVisible( true );
+    streamed.isLoaded = true;
+
+    Trace::message( fmt::format( "Loaded world {} with {} entities.",
+                                 world->getName(),
+                                 world->getEntityList().size() ) );
+}
+
+/**
+ * @brief Destroys the entities of a streamed world and hides it.
+ * @param streamed World to unload.
+ */
+void WorldManager::unload( StreamedWorld& streamed ) {
+    World* world = getWorld( streamed.handle );
+    world->clear();
+
+    world->setActive( false );
+    world->setVisible( false );
+    streamed.isLoaded = false;
+
+    Trace::message( fmt::format( "Unloaded world {}.", world->getName() ) );
+}
+
+/**
+ * @brief Rebuilds the list returned by getWorlds.
+ */
+void WorldManager::updateWorldList() {
+    m_worlds.clear();
+    for ( WorldSlot& slot : m_slots ) {
+        if ( slot.world ) {
+            m_worlds.push_back( slot.world.get() );
+        }
+    }
+}
+
+} // namespace SquirrelEngine
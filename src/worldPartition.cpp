@@ -0,0 +1,546 @@
+/**
+ *
+ * @file worldPartition.cpp
+ * @author Kelson Wysocki (kelson.wysocki@gmail.com)
+ * @brief Implements the WorldPartition class, which splits the level into a
+ * grid of cells and streams them in and out around the camera in
+ * SquirrelEngine.
+ * @date 2025-06-06
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+
+#include <fmt/core.h>
+
+#include "engine.hpp"
+#include "entity.hpp"
+#include "meshCache.hpp"
+#include "model.hpp"
+#include "worldManager.hpp"
+#include "worldPartition.hpp"
+#include "utils/trace.hpp"
+
+namespace SquirrelEngine {
+
+//! Rough bytes of an entity with a model, on top of its vertex buffer
+constexpr size_t EntityCost =
+    sizeof( Entity ) + sizeof( Model ) + sizeof( Mesh ) + 256;
+
+/**
+ * @brief Default constructor for WorldPartition.
+ */
+WorldPartition::WorldPartition() {}
+
+/**
+ * @brief Destructor for WorldPartition.
+ */
+WorldPartition::~WorldPartition() { stopLoaders(); }
+
+/**
+ * @brief Finds the worlds and mesh cache cells are loaded into.
+ * @param t_owner Pointer to the Engine that owns this system.
+ * @return StartupErrors indicating success or failure.
+ */
+StartupErrors WorldPartition::initialize( Engine* t_owner ) {
+    System::initialize( t_owner );
+
+    m_worldManager = getSystem< WorldManager >();
+    m_meshCache = getSystem< MeshCache >();
+    m_stats = PartitionStats();
+
+    // Activating cells uploads meshes, which needs the context
+    m_isEnabled = !owner->getSettings().renderThread;
+    if ( !m_isEnabled ) {
+        Trace::message( "World partition is disabled with a render thread." );
+    }
+
+    return StartupErrors::SE_Success;
+}
+
+/**
+ * @brief Requests cells near the camera, evicts far ones and activates loaded
+ * ones within the budget.
+ * @param delta Time elapsed since last update.
+ */
+void WorldPartition::update( const float ) {
+    if ( !m_isEnabled || !m_loader ) {
+        return;
+    }
+
+    Entity* camera = m_worldManager->getCamera();
+    if ( !camera ) {
+        return;
+    }
+
+    const CellCoord center = getCell( camera->transform.getPosition() );
+
+    size_t memoryUsage = measureMemory();
+    const size_t memoryBudget = m_settings.memoryBudget << 20;
+
+    // Cached models no cell is using are the cheapest thing to give back
+    if ( memoryUsage > memoryBudget ) {
+        m_meshCache->trim();
+        memoryUsage = measureMemory();
+    }
+
+    evictCells( center, memoryUsage > memoryBudget );
+    requestCells( center, memoryUsage );
+    activateCells( center );
+
+    m_stats.memoryUsage = measureMemory();
+    m_stats.peakMemory = std::max( m_stats.peakMemory, m_stats.memoryUsage );
+}
+
+/**
+ * @brief Stops the loader threads, unloads every cell and reports.
+ */
+void WorldPartition::shutdown() {
+    stopLoaders();
+
+    if ( m_loader ) {
+        report();
+    }
+
+    for ( auto& [cellKey, cell] : m_cells ) {
+        m_worldManager->destroyWorld( cell->world );
+    }
+    m_cells.clear();
+    m_loader = nullptr;
+}
+
+/**
+ * @brief Sets the grid, ceilings and budgets. Cells already loaded stay until
+ * the new radii evict them.
+ * @param settings Settings to use.
+ */
+void WorldPartition::setSettings( const PartitionSettings& settings ) {
+    m_settings = settings;
+    m_settings.cellSize = std::max( m_settings.cellSize, 1.f );
+    m_settings.loadRadius = std::max( m_settings.loadRadius, 0 );
+
+    // Cells on the edge would otherwise be evicted as soon as they load
+    m_settings.evictRadius =
+        std::max( m_settings.evictRadius, m_settings.loadRadius );
+}
+
+/**
+ * @brief Gets the grid, ceilings and budgets.
+ * @return Current settings.
+ */
+const PartitionSettings& WorldPartition::getSettings() const {
+    return m_settings;
+}
+
+/**
+ * @brief Sets what fills each cell and starts the loader threads.
+ * @param loader Describes a cell's entities, on a loader thread.
+ */
+void WorldPartition::setCellLoader( CellLoader loader ) {
+    // Loaders read m_loader unlocked, so it only changes while they are down
+    stopLoaders();
+    m_loader = std::move( loader );
+
+    if ( !m_isEnabled || !m_loader ) {
+        return;
+    }
+
+    m_stopping = false;
+    const unsigned threadCount = std::max( m_settings.loaderThreads, 1u );
+    for ( unsigned i = 0; i < threadCount; ++i ) {
+        m_loaders.emplace_back( &WorldPartition::loaderLoop, this );
+    }
+}
+
+/**
+ * @brief Finds the cell a point is in.
+ * @param position Point in the world.
+ * @return Cell containing the point.
+ */
+CellCoord WorldPartition::getCell( const vector3& position ) const {
+    CellCoord coord;
+    coord.x = static_cast< int32_t >(
+        std::floor( position.x / m_settings.cellSize ) );
+    coord.z = static_cast< int32_t >(
+        std::floor( position.z / m_settings.cellSize ) );
+    return coord;
+}
+
+/**
+ * @brief Checks if a cell's entities are all in the world.
+ * @param coord Cell to check.
+ * @return true if the cell is active.
+ */
+bool WorldPartition::isCellActive( const CellCoord& coord ) const {
+    std::lock_guard< std::mutex > lock( m_mutex );
+
+    auto found = m_cells.find( key( coord ) );
+    return found != m_cells.end() && found->second->state == CS_Active;
+}
+
+/**
+ * @brief Gets what the partition holds and how it kept to its budgets.
+ * @return Current statistics.
+ */
+PartitionStats WorldPartition::getStats() const {
+    PartitionStats stats = m_stats;
+
+    std::lock_guard< std::mutex > lock( m_mutex );
+    for ( const auto& [cellKey, cell] : m_cells ) {
+        if ( cell->state == CS_Active ) {
+            ++stats.activeCells;
+        } else {
+            ++stats.pendingCells;
+        }
+    }
+
+    return stats;
+}
+
+/**
+ * @brief Traces the peak memory and budget overruns.
+ */
+void WorldPartition::report() const {
+    const PartitionStats stats = getStats();
+    constexpr double megabyte = 1024.0 * 1024.0;
+
+    Trace::message( fmt::format(
+        "World partition peak memory {:.1f} of {} MB, loads held back by the "
+        "ceiling on {} frames.",
+        static_cast< double >( stats.peakMemory ) / megabyte,
+        m_settings.memoryBudget, stats.heldBackFrames ) );
+    Trace::message( fmt::format(
+        "World partition activated on {} frames, {} over the {:.2f} ms "
+        "budget, max {:.2f} ms.",
+        stats.activationFrames, stats.overBudgetFrames,
+        m_settings.activationBudget, stats.maxActivationTime ) );
+}
+
+/**
+ * @brief Packs a cell coordinate into a map key.
+ * @param coord Cell to pack.
+ * @return Key of the cell.
+ */
+uint64_t WorldPartition::key( const CellCoord& coord ) {
+    return ( static_cast< uint64_t >( static_cast< uint32_t >( coord.x ) )
+             << 32 ) |
+           static_cast< uint32_t >( coord.z );
+}
+
+/**
+ * @brief Counts the rings of cells between two cells.
+ * @param a First cell.
+ * @param b Second cell.
+ * @return Chebyshev distance in cells.
+ */
+int WorldPartition::distance( const CellCoord& a, const CellCoord& b ) {
+    return std::max( std::abs( a.x - b.x ), std::abs( a.z - b.z ) );
+}
+
+/**
+ * @brief Describes queued cells until the partition stops. Runs on each loader
+ * thread.
+ */
+void WorldPartition::loaderLoop() {
+    std::unique_lock< std::mutex > lock( m_mutex );
+
+    while ( true ) {
+        m_wake.wait( lock,
+                     [this]() { return m_stopping || !m_queue.empty(); } );
+        if ( m_stopping ) {
+            return;
+        }
+
+        Cell* cell = m_queue.front();
+        m_queue.pop_front();
+        cell->state = CS_Loading;
+        const CellCoord coord = cell->coord;
+
+        // The main thread leaves loading cells alone, so work unlocked
+        lock.unlock();
+
+        CellData data;
+        if ( !m_loader( coord, data ) ) {
+            // Nothing there, so there is nothing to activate either
+            lock.lock();
+            cell->state = CS_Active;
+            continue;
+        }
+
+        // Parse the models here so activating only has to upload them
+        std::vector< std::shared_ptr< const MeshData > > meshes;
+        size_t memory = data.entities.size() * EntityCost;
+        for ( const EntityDesc& desc : data.entities ) {
+            if ( desc.mesh.empty() ) {
+                continue;
+            }
+
+            std::shared_ptr< const MeshData > vertices =
+                m_meshCache->load( desc.mesh );
+            if ( !vertices ) {
+                continue;
+            }
+
+            // Every mesh uploads its own copy of the vertices
+            memory += vertices->size() * sizeof( Vertex );
+            if ( std::find( meshes.begin(), meshes.end(), vertices ) ==
+                 meshes.end() ) {
+                meshes.push_back( std::move( vertices ) );
+            }
+        }
+
+        lock.lock();
+        cell->data = std::move( data );
+        cell->meshes = std::move( meshes );
+        cell->memory = memory;
+        cell->state = CS_Ready;
+    }
+}
+
+/**
+ * @brief Joins the loader threads and drops cells still queued.
+ */
+void WorldPartition::stopLoaders() {
+    {
+        std::lock_guard< std::mutex > lock( m_mutex );
+        m_stopping = true;
+
+        for ( Cell* cell : m_queue ) {
+            m_cells.erase( key( cell->coord ) );
+        }
+        m_queue.clear();
+    }
+    m_wake.notify_all();
+
+    for ( std::thread& loader : m_loaders ) {
+        loader.join();
+    }
+    m_loaders.clear();
+}
+
+/**
+ * @brief Queues the missing cells within the load radius, nearest first,
+ * unless over the memory ceiling.
+ * @param center Cell the camera is in.
+ * @param memoryUsage Memory used right now.
+ */
+void WorldPartition::requestCells( const CellCoord& center,
+                                   const size_t memoryUsage ) {
+    std::vector< CellCoord > missing;
+
+    std::unique_lock< std::mutex > lock( m_mutex );
+
+    const int radius = m_settings.loadRadius;
+    for ( int z = -radius; z <= radius; ++z ) {
+        for ( int x = -radius; x <= radius; ++x ) {
+            const CellCoord coord = { center.x + x, center.z + z };
+            if ( m_cells.find( key( coord ) ) == m_cells.end() ) {
+                missing.push_back( coord );
+            }
+        }
+    }
+
+    if ( missing.empty() ) {
+        return;
+    }
+
+    if ( memoryUsage > m_settings.memoryBudget << 20 ) {
+        ++m_stats.heldBackFrames;
+        return;
+    }
+
+    std::sort( missing.begin(), missing.end(),
+               [&center]( const CellCoord& a, const CellCoord& b ) {
+                   return distance( a, center ) < distance( b, center );
+               } );
+
+    for ( const CellCoord& coord : missing ) {
+        auto cell = std::make_unique< Cell >();
+        cell->coord = coord;
+        m_queue.push_back( cell.get() );
+        m_cells.emplace( key( coord ), std::move( cell ) );
+    }
+
+    lock.unlock();
+    m_wake.notify_all();
+}
+
+/**
+ * @brief Unloads cells beyond the evict radius, or beyond the load radius
+ * while over the memory ceiling.
+ * @param center Cell the camera is in.
+ * @param overBudget Whether memory is over the ceiling.
+ */
+void WorldPartition::evictCells( const CellCoord& center,
+                                 const bool overBudget ) {
+    const int radius =
+        overBudget ? m_settings.loadRadius : m_settings.evictRadius;
+
+    std::lock_guard< std::mutex > lock( m_mutex );
+
+    for ( auto it = m_cells.begin(); it != m_cells.end(); ) {
+        Cell& cell = *it->second;
+
+        const bool isFar = distance( cell.coord, center ) > radius;
+        if ( !isFar && !cell.isEvicted ) {
+            ++it;
+            continue;
+        }
+
+        // The loader thread still has it, drop it once the thread is done
+        if ( cell.state == CS_Loading ) {
+            cell.isEvicted = true;
+            ++it;
+            continue;
+        }
+
+        if ( cell.state == CS_Queued ) {
+            m_queue.erase( std::find( m_queue.begin(), m_queue.end(), &cell ) );
+        }
+
+        m_worldManager->destroyWorld( cell.world );
+        it = m_cells.erase( it );
+    }
+}
+
+/**
+ * @brief Creates entities of loaded cells, nearest first, until the activation
+ * budget runs out.
+ * @param center Cell the camera is in.
+ */
+void WorldPartition::activateCells( const CellCoord& center ) {
+    using namespace std::chrono;
+
+    const steady_clock::time_point start = steady_clock::now();
+    const duration< float, std::milli > budget( m_settings.activationBudget );
+
+    bool hasActivated = false;
+    bool isOverBudget = false;
+
+    while ( !isOverBudget ) {
+        Cell* cell = nextToActivate( center );
+        if ( !cell ) {
+            break;
+        }
+
+        // Built hidden, so a half-made cell never shows or simulates
+        if ( cell->state == CS_Ready ) {
+            cell->world = m_worldManager->createWorld( fmt::format(
+                "Cell {} {}", cell->coord.x, cell->coord.z ) );
+
+            World* world = m_worldManager->getWorld( cell->world );
+            world->setActive( false );
+            world->setVisible( false );
+            cell->state = CS_Activating;
+        }
+
+        World* world = m_worldManager->getWorld( cell->world );
+        auto& entities = cell->data.entities;
+
+        // At least one entity a frame, so a tight budget still makes progress
+        while ( cell->nextEntity < entities.size() && !isOverBudget ) {
+            spawn( *world, entities[cell->nextEntity++] );
+            hasActivated = true;
+            isOverBudget = steady_clock::now() - start >= budget;
+        }
+
+        if ( cell->nextEntity < entities.size() ) {
+            break;
+        }
+
+        world->setActive( true );
+        world->setVisible( true );
+
+        // The descriptions are spent and the meshes hold their vertices now
+        cell->data = CellData();
+        cell->meshes.clear();
+
+        std::lock_guard< std::mutex > lock( m_mutex );
+        cell->state = CS_Active;
+    }
+
+    if ( !hasActivated ) {
+        return;
+    }
+
+    const float elapsed =
+        duration< float, std::milli >( steady_clock::now() - start ).count();
+
+    ++m_stats.activationFrames;
+    m_stats.maxActivationTime = std::max( m_stats.maxActivationTime, elapsed );
+    if ( elapsed > m_settings.activationBudget ) {
+        ++m_stats.overBudgetFrames;
+    }
+}
+
+/**
+ * @brief Finds the loaded cell to activate next.
+ * @param center Cell the camera is in.
+ * @return Cell to activate, or nullptr if none is loaded.
+ */
+WorldPartition::Cell*
+WorldPartition::nextToActivate( const CellCoord& center ) {
+    std::lock_guard< std::mutex > lock( m_mutex );
+
+    Cell* next = nullptr;
+    for ( auto& [cellKey, cell] : m_cells ) {
+        // Finish the cell already started before opening another
+        if ( cell->state == CS_Activating ) {
+            return cell.get();
+        }
+
+        if ( cell->state == CS_Ready && !cell->isEvicted &&
+             ( !next ||
+               distance( cell->coord, center ) <
+                   distance( next->coord, center ) ) ) {
+            next = cell.get();
+        }
+    }
+
+    return next;
+}
+
+/**
+ * @brief Creates one entity of a cell.
+ * @param world World to create it in.
+ * @param desc Description of the entity.
+ */
+void WorldPartition::spawn( World& world, const EntityDesc& desc ) {
+    Entity* entity = world.createEntity( desc.name );
+    entity->transform.setPosition( desc.position );
+    entity->transform.setRotation( desc.rotation );
+    entity->transform.setScale( desc.scale );
+
+    // Loaded mid-run, so don't interpolate in from the origin
+    entity->transform.resetInterpolation();
+
+    if ( desc.mesh.empty() ) {
+        return;
+    }
+
+    // The loader thread already parsed the model, and the compiler builds
+    // each pair of shaders once
+    Model* model = entity->createComponent< Model >();
+    model->initMesh( desc.mesh );
+    model->initShader( desc.vertShader, desc.fragShader );
+}
+
+/**
+ * @brief Estimates the memory used by the cells and the mesh cache.
+ * @return Bytes in use.
+ */
+size_t WorldPartition::measureMemory() const {
+    size_t memory = m_meshCache->getMemoryUsage();
+
+    std::lock_guard< std::mutex > lock( m_mutex );
+    for ( const auto& [cellKey, cell] : m_cells ) {
+        memory += cell->memory;
+    }
+
+    return memory;
+}
+
+} // namespace SquirrelEngine